@@ -0,0 +1,880 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Run SOILWAT2-standalone for many sites in one process
+
+  A manifest lists site directories, each with its own master input file
+  (e.g., `files.in`). The sites are simulated by a pool of worker threads;
+  each worker owns a queue of sites and, once its queue is empty, steals
+  queued sites from the back of the queues of other workers.
+
+  Multiple workers require compilation with `SWTHREADS` (and linking with
+  `-pthread`) so that each worker thread carries its own model state;
+  otherwise, all sites are simulated one after the other by the calling
+  thread.
+
+  The daily weather of all sites of a manifest can be converted into
+  one binary weather store (see `SW_Weather_store.c`).
+
+  An ensemble run simulates the years of a spin-up period once and then
+  continues each branch listed in a manifest from the state at the end of
+  the spin-up (see `SW_BAT_ensemble()`); branches run on the pool of
+  worker threads like sites of a batch run.
+
+  Realizations of the weather generator simulate each site several times,
+  each with its own, reproducible stream of random numbers
+  (see `SW_BAT_realizations()`).
+
+  Each worker sets up one model that is reset after each run and reads the
+  inputs of its next run (instead of being set up again for each run).
+  Each worker serves the memory allocations of its runs from its own arena
+  (see `Mem_ArenaUse()`) that is reset in one step after each run instead of
+  releasing the blocks of a run one by one to the system heap.
+
+  A fatal error of a run (e.g., invalid inputs of a site) does not end the
+  process: the run is reported and skipped, and its worker continues with
+  the next run (see `FatalJump`). Fatal errors of the spin-up of an ensemble
+  run still end the process.
+
+  History:
+  10/18/2026	INITIAL CODING
+  10/18/2026	added ensemble runs that share a spin-up period
+  10/18/2026	added realizations of the weather generator
+  10/18/2026	allocations of a run come from the arena of its worker
+  10/18/2026	runs with a fatal error are skipped instead of ending the batch
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef SWTHREADS
+#include <pthread.h>
+#endif
+
+#include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
+#include "rands.h"
+#include "SW_Defines.h"
+#include "SW_Files.h"
+#include "SW_Control.h"
+#include "SW_Model.h"
+#include "SW_Output.h"
+#ifdef SW_OUTBINARY
+#include "SW_Output_outbinary.h"
+#elif defined(SW_OUTMEMORY)
+#include "SW_Output_outmemory.h"
+#else
+#include "SW_Output_outtext.h"
+#endif
+#include "SW_Weather.h"
+#include "SW_Weather_store.h"
+#include "SW_Snapshot.h"
+#include "SW_Batch.h"
+#include "SW_Timing.h"
+
+
+#ifdef SWTHREADS
+	#define _lock(q) pthread_mutex_lock(&(q)->lock)
+	#define _unlock(q) pthread_mutex_unlock(&(q)->lock)
+#else
+	#define _lock(q)
+	#define _unlock(q)
+#endif
+
+
+/* =================================================== */
+/*                  Global Variables                   */
+/* --------------------------------------------------- */
+
+extern SW_TLS Bool QuietMode, EchoInits;
+extern SW_TLS Bool _ProjDirForAll;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS sw_random_t markov_rng;
+extern SW_TLS char OutputSuffix[]; /* see SW_Files.c */
+
+
+/* =================================================== */
+/*                Module-Level Declarations            */
+/* --------------------------------------------------- */
+
+/** Queue of runs of one worker */
+typedef struct {
+	size_t
+		*run, /**< Indices of runs, i.e., of sites or of their realizations */
+		head, /**< Next run of the owner */
+		tail; /**< One past the last queued site; thieves take `tail - 1` */
+
+	#ifdef SWTHREADS
+	pthread_mutex_t lock;
+	#endif
+} SW_BATCH_QUEUE;
+
+/** State shared by all workers of a batch run */
+typedef struct {
+	char
+		**sitedir, /**< Site directories as listed in the manifest */
+		masterfile[MAX_FILENAMESIZE]; /**< Name of the master input file */
+
+	size_t n_sites,
+		n_failed; /**< Number of runs that failed with a fatal error */
+	int n_workers;
+
+	SW_BATCH_QUEUE queue[SW_BAT_MAXWORKERS];
+
+	/* ensemble run; `NULL` for a batch run */
+	const SW_SNAP_BUFFER *spinup; /**< State at the end of the spin-up */
+	long *seed; /**< Seed of the weather generator of each branch; 0 = none */
+
+	/* realizations of the weather generator; `n_real` is 0 if none */
+	int n_real; /**< Number of realizations (runs) of each site */
+	uint64_t seed_real; /**< Seed of the weather generator of all runs */
+
+	/* settings of the calling thread that are passed on to each worker */
+	Bool QuietMode, EchoInits;
+} SW_BATCH;
+
+/** One worker of a batch run */
+typedef struct {
+	SW_BATCH *batch;
+	int id;
+	size_t
+		n_done, /**< Number of runs simulated by this worker */
+		n_failed; /**< Number of runs that failed with a fatal error */
+} SW_BATCH_WORKER;
+
+
+static size_t _read_manifest(const char *manifest, char ***sitedir);
+static void _site_file(const char *sitedir, const char *masterfile,
+	char *firstfile);
+static void _close_site_log(const char *sitedir, FILE *logfp_prev);
+static Bool _next_site(SW_BATCH *b, int id, size_t *k);
+static Bool _run_site(SW_BATCH *b, size_t run, MemArena *arena);
+static void *_worker(void *arg);
+static size_t _simulate(SW_BATCH *b, int n_workers);
+static void _spinup(const char *firstfile, TimeInt year,
+	SW_SNAP_BUFFER *state);
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+/** @brief Read site directories from a manifest file
+
+  Each (non-empty, non-comment) line of the manifest is one site directory;
+  trailing slashes are removed.
+
+  @param manifest Name of the manifest file.
+  @param sitedir Upon return, points to the allocated list of site
+    directories.
+
+  @return Number of site directories.
+*/
+static size_t _read_manifest(const char *manifest, char ***sitedir) {
+	FILE *f;
+	size_t n = 0, n_alloc = 0, len;
+	char buf[1024]; // size as used by `GetALine()`
+
+	*sitedir = NULL;
+	f = OpenFile(manifest, "r");
+
+	while (GetALine(f, buf)) {
+		if (n == n_alloc) {
+			n_alloc = (n_alloc == 0) ? 64 : 2 * n_alloc;
+			*sitedir = (char **) (isnull(*sitedir) ?
+				Mem_Malloc(n_alloc * sizeof(char *), "_read_manifest()") :
+				Mem_ReAlloc(*sitedir, n_alloc * sizeof(char *)));
+		}
+
+		for (len = strlen(buf); len > 1 && buf[len - 1] == '/'; len--) {
+			buf[len - 1] = '\0';
+		}
+
+		(*sitedir)[n++] = Str_Dup(buf);
+	}
+
+	CloseFile(&f);
+
+	return n;
+}
+
+
+/** @brief Compose the name of the master input file of a site
+
+  @param sitedir Site directory.
+  @param masterfile Name of the master input file (without path).
+  @param firstfile Upon return, the path of the master input file of the
+    site; of size `MAX_FILENAMESIZE`.
+*/
+static void _site_file(const char *sitedir, const char *masterfile,
+	char *firstfile) {
+
+	size_t len = strlen(sitedir);
+
+	if (MAX_FILENAMESIZE <= snprintf(firstfile, MAX_FILENAMESIZE, "%s%s%s",
+			sitedir,
+			(len > 0 && sitedir[len - 1] != '/') ? "/" : "",
+			masterfile)) {
+		LogError(logfp, LOGFATAL, "Path of site is too long: %s", sitedir);
+	}
+}
+
+
+/** @brief Close the log file of a site and return to the previous log
+
+  @param sitedir Site directory.
+  @param logfp_prev Log file that was used before the site opened its own.
+*/
+static void _close_site_log(const char *sitedir, FILE *logfp_prev) {
+	if (logfp != stdout && logfp != stderr) {
+		if (logged && !QuietMode) {
+			fprintf(stderr, "Check logfile of site %s for error or status "
+				"messages.\n", sitedir);
+		}
+		CloseFile(&logfp);
+	}
+	logfp = logfp_prev;
+}
+
+
+/** @brief Determine the next run that worker `id` simulates
+
+  The worker first takes the next run from the front of its own queue;
+  if its queue is empty, then it steals the last queued run of another
+  worker (visiting the other workers in a round-robin order).
+
+  @param b The batch run.
+  @param id The worker.
+  @param k Upon return, the index of the next run.
+
+  @return `swFALSE` if no run is left in any queue.
+*/
+static Bool _next_site(SW_BATCH *b, int id, size_t *k) {
+	int i, v;
+	Bool found = swFALSE;
+	SW_BATCH_QUEUE *q;
+
+	for (i = 0; i < b->n_workers && !found; i++) {
+		v = (id + i) % b->n_workers;
+		q = &b->queue[v];
+
+		_lock(q);
+		if (q->head < q->tail) {
+			*k = (i == 0) ? q->run[q->head++] : q->run[--q->tail];
+			found = swTRUE;
+		}
+		_unlock(q);
+	}
+
+	return found;
+}
+
+
+/** @brief Simulate one site on the calling thread
+
+  The worker's model (see `_worker()`) reads the inputs of the master input
+  file of the site, the simulation is carried out, outputs are written to the
+  files listed by the site, and the model is reset for the next site
+  (see `SW_CTL_clear_model()`). Allocations of the run come from `arena`,
+  which is reset afterwards.
+
+  A fatal error of the run jumps back to this function (see `FatalJump`):
+  the run's files are closed, the model is reset, and the error is
+  reported on the log of the worker.
+
+  A branch of an ensemble run continues from the state at the end of the
+  spin-up and, if it has a seed, re-seeds the weather generator.
+
+  A realization of the weather generator writes to its own log and output
+  files; its weather generator uses the stream of random numbers of its run
+  index so that results do not depend on the number of workers.
+
+  @param b The batch run.
+  @param run Index of the run: the site or, with realizations, the site
+    times `n_real` plus the realization.
+  @param arena Memory arena of the worker.
+
+  @return `swFALSE` if the run failed with a fatal error.
+*/
+static Bool _run_site(SW_BATCH *b, size_t run, MemArena *arena) {
+	char firstfile[MAX_FILENAMESIZE];
+	FILE *logfp_worker = logfp;
+	size_t k = (b->n_real > 0) ? run / b->n_real : run;
+	MemArena *prev_arena = Mem_ArenaUse(arena);
+	jmp_buf fatal;
+	volatile int stage = 0; // 1, inputs are read; 2, output files are open
+
+	logged = swFALSE;
+
+	if (0 != setjmp(fatal)) {
+		// fatal errors while cleaning up end the process
+		FatalJump = NULL;
+		Mem_ArenaUse(arena); // in case the error occurred while bypassing it
+
+		if (stage >= 2) {
+			SW_OUT_close_files();
+		}
+		if (stage >= 1) {
+			SW_CTL_clear_model(NULL, swFALSE);
+		}
+
+		_close_site_log(b->sitedir[k], logfp_worker);
+		LogError(logfp, LOGWARN, "Run of site %s%s failed and was skipped: %s",
+			b->sitedir[k], OutputSuffix, FatalMsg);
+		OutputSuffix[0] = '\0';
+
+		Mem_ArenaUse(prev_arena);
+		Mem_ArenaReset(arena);
+
+		return swFALSE;
+	}
+	FatalJump = &fatal;
+
+	_site_file(b->sitedir[k], b->masterfile, firstfile);
+
+	if (b->n_real > 0) {
+		snprintf(OutputSuffix, 32, "_r%d", (int) (run % b->n_real) + 1);
+	}
+
+	stage = 1;
+	SW_F_construct(firstfile);
+	SW_CTL_read_inputs_from_disk(NULL); // opens log file of site
+	SW_CTL_init_run(NULL);
+
+	if (!isnull(b->spinup)) {
+		SW_SNAP_restore_state(b->spinup);
+
+		if (b->seed[k] != 0) {
+			RandSeedStream((uint64_t) b->seed[k], k, &markov_rng);
+		}
+	}
+
+	if (b->n_real > 0) {
+		RandSeedStream(b->seed_real, run, &markov_rng);
+	}
+
+	SW_OUT_set_ncol();
+	SW_OUT_set_colnames();
+	SW_OUT_create_files();
+	stage = 2;
+
+	SW_CTL_main(NULL);
+
+	SW_OUT_close_files();
+	SW_CTL_clear_model(NULL, swFALSE); // reset the model for the next site
+
+	FatalJump = NULL;
+
+	_close_site_log(b->sitedir[k], logfp_worker);
+	OutputSuffix[0] = '\0';
+
+	Mem_ArenaUse(prev_arena);
+	Mem_ArenaReset(arena);
+
+	return swTRUE;
+}
+
+
+/** @brief Simulate sites until all queues are empty
+
+  The worker sets up one model (see `SW_RUN`) that simulates all its runs;
+  the allocations of the set-up model come from a second arena that is kept
+  until the worker is done. Allocations of a run come from the worker's arena;
+  the arena is reset after each run and its memory is reused by the next run.
+
+  @param arg A pointer to a `SW_BATCH_WORKER`.
+
+  @return `NULL`
+*/
+static void *_worker(void *arg) {
+	SW_BATCH_WORKER *w = (SW_BATCH_WORKER *) arg;
+	SW_BATCH *b = w->batch;
+	size_t k;
+	MemArena arena, model_arena, *prev_arena;
+	SW_RUN *model;
+	char firstfile[MAX_FILENAMESIZE];
+
+	// state of the calling thread (if `SWTHREADS`, then a new thread)
+	FILE *prev_logfp = logfp;
+	Bool
+		prev_QuietMode = QuietMode,
+		prev_EchoInits = EchoInits,
+		prev_ProjDirForAll = _ProjDirForAll;
+
+	logfp = stdout;
+	QuietMode = b->QuietMode;
+	EchoInits = b->EchoInits;
+	_ProjDirForAll = swTRUE; // all paths of a site are relative to its directory
+
+	Mem_ArenaInit(&arena, 0);
+	Mem_ArenaInit(&model_arena, 0);
+
+	// set up the model of the worker once; each run sets its master input file
+	prev_arena = Mem_ArenaUse(&model_arena);
+	model = (SW_RUN *) Mem_Calloc(1, sizeof(SW_RUN), "_worker()");
+	strcpy(firstfile, b->masterfile);
+	SW_CTL_setup_model(model, firstfile);
+	Mem_ArenaUse(prev_arena);
+
+	while (_next_site(b, w->id, &k)) {
+		if (_run_site(b, k, &arena)) {
+			w->n_done++;
+		} else {
+			w->n_failed++;
+		}
+	}
+
+	SW_CTL_release_run(); // return to the state of the calling thread
+	Mem_ArenaRelease(&model_arena);
+	Mem_ArenaRelease(&arena);
+
+	// add timings of this worker to the totals of the process
+	SW_TIM_merge();
+
+	logfp = prev_logfp;
+	QuietMode = prev_QuietMode;
+	EchoInits = prev_EchoInits;
+	_ProjDirForAll = prev_ProjDirForAll;
+
+	return NULL;
+}
+
+
+/** @brief Simulate all runs of a batch with a pool of worker threads
+
+  A run is a site, a branch, or a realization of a site. Runs are initially
+  distributed in contiguous blocks across the workers; workers that run out
+  of runs steal from workers that are still busy.
+
+  @param b The batch run; `n_workers` is set.
+  @param n_workers Number of worker threads; values less than 1 are set to 1.
+    Without `SWTHREADS`, only one worker (the calling thread) is used.
+
+  @return Number of runs that were simulated without a fatal error.
+*/
+static size_t _simulate(SW_BATCH *b, int n_workers) {
+	SW_BATCH_WORKER worker[SW_BAT_MAXWORKERS];
+	size_t k, n_done = 0,
+		n_runs = b->n_sites * ((b->n_real > 0) ? (size_t) b->n_real : 1);
+	int i;
+
+	#ifdef SWTHREADS
+	pthread_t tid[SW_BAT_MAXWORKERS];
+	#endif
+
+	b->QuietMode = QuietMode;
+	b->EchoInits = EchoInits;
+
+	#ifndef SWTHREADS
+	if (n_workers > 1) {
+		LogError(logfp, LOGWARN, "Compiled without `SWTHREADS`: batch run "
+			"uses one instead of %d worker threads\n", n_workers);
+	}
+	n_workers = 1;
+	#endif
+
+	n_workers = (n_workers < 1) ? 1 : n_workers;
+	n_workers = (n_workers > SW_BAT_MAXWORKERS) ? SW_BAT_MAXWORKERS : n_workers;
+	if ((size_t) n_workers > n_runs && n_runs > 0) {
+		n_workers = (int) n_runs;
+	}
+	b->n_workers = n_workers;
+
+
+	// Distribute runs in contiguous blocks across the workers' queues
+	for (i = 0; i < n_workers; i++) {
+		b->queue[i].run = (size_t *) Mem_Calloc(n_runs, sizeof(size_t),
+			"_simulate()");
+		b->queue[i].head = 0;
+		b->queue[i].tail = 0;
+
+		for (k = n_runs * i / n_workers; k < n_runs * (i + 1) / n_workers; k++) {
+			b->queue[i].run[b->queue[i].tail++] = k;
+		}
+
+		#ifdef SWTHREADS
+		pthread_mutex_init(&b->queue[i].lock, NULL);
+		#endif
+
+		worker[i].batch = b;
+		worker[i].id = i;
+		worker[i].n_done = 0;
+		worker[i].n_failed = 0;
+	}
+
+
+	// Simulate
+	#ifdef SWTHREADS
+	for (i = 0; i < n_workers; i++) {
+		if (0 != pthread_create(&tid[i], NULL, _worker, &worker[i])) {
+			LogError(logfp, LOGFATAL, "Failed to create worker thread %d", i);
+		}
+	}
+
+	for (i = 0; i < n_workers; i++) {
+		pthread_join(tid[i], NULL);
+	}
+	#else
+	_worker(&worker[0]);
+	#endif
+
+
+	// Clean up
+	b->n_failed = 0;
+	for (i = 0; i < n_workers; i++) {
+		n_done += worker[i].n_done;
+		b->n_failed += worker[i].n_failed;
+
+		#ifdef SWTHREADS
+		pthread_mutex_destroy(&b->queue[i].lock);
+		#endif
+		Mem_Free(b->queue[i].run);
+	}
+
+	if (b->n_failed > 0) {
+		LogError(logfp, LOGWARN, "%zu of %zu runs failed and were skipped",
+			b->n_failed, n_runs);
+	}
+
+	return n_done;
+}
+
+
+/** @brief Simulate the spin-up period of an ensemble run on the
+  calling thread
+
+  The run of the master input file is simulated from its first year through
+  `year`; its outputs cover these years.
+
+  @param firstfile Name of the master input file of the spin-up run.
+  @param year Last year of the spin-up period.
+  @param state Upon return, holds the state at the end of `year`
+    (see `SW_SNAP_store_state()`).
+*/
+static void _spinup(const char *firstfile, TimeInt year,
+	SW_SNAP_BUFFER *state) {
+
+	SW_CTL_setup_model(NULL, firstfile);
+	SW_CTL_read_inputs_from_disk(NULL);
+
+	if (year < SW_Model.startyr || year >= SW_Model.endyr) {
+		LogError(logfp, LOGFATAL, "Spin-up through year %d is not within "
+			"the years %d-%d of %s.", year, SW_Model.startyr,
+			SW_Model.endyr - 1, firstfile);
+	}
+
+	SW_Model.endyr = year;
+	SW_Model.endend = Time_get_lastdoy_y(year);
+
+	SW_CTL_init_run(NULL);
+
+	SW_OUT_set_ncol();
+	SW_OUT_set_colnames();
+	SW_OUT_create_files();
+
+	SW_CTL_main(NULL);
+	SW_SNAP_store_state(state);
+
+	SW_OUT_close_files();
+	SW_CTL_clear_model(NULL, swFALSE);
+}
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Function Definitions                    */
+/*             (declared in SW_Batch.h)                */
+/* --------------------------------------------------- */
+
+/** @brief Simulate all sites of a manifest with a pool of worker threads
+
+  Each worker keeps its thread and its model state for the duration of the
+  batch run and simulates one site after the other (see `_run_site()` and
+  `_simulate()`).
+
+  Input, weather, log, and output files of a site are located relative to
+  its site directory.
+
+  @param manifest Name of the file that lists one site directory per line.
+  @param firstfile Name of the master input file of each site,
+    e.g., `files.in`; any path is ignored.
+  @param n_workers Number of worker threads; values less than 1 are set to 1.
+    Without `SWTHREADS`, only one worker (the calling thread) is used.
+
+  @return Number of simulated sites.
+*/
+int SW_BAT_run(const char *manifest, const char *firstfile, int n_workers) {
+	SW_BATCH b;
+	size_t k, n_done;
+
+	b.n_sites = _read_manifest(manifest, &b.sitedir);
+	strcpy(b.masterfile, BaseName(firstfile));
+	b.spinup = NULL;
+	b.seed = NULL;
+	b.n_real = 0;
+
+	if (b.n_sites == 0) {
+		LogError(logfp, LOGWARN, "No site directories listed in %s\n", manifest);
+		return 0;
+	}
+
+	n_done = _simulate(&b, n_workers);
+
+	for (k = 0; k < b.n_sites; k++) {
+		Mem_Free(b.sitedir[k]);
+	}
+	Mem_Free(b.sitedir);
+	SW_WTH_store_free_unused();
+
+	if (!QuietMode) {
+		swprintf("Simulated %zu of %zu sites with %d worker thread(s)\n",
+			n_done, b.n_sites, b.n_workers);
+	}
+
+	return (int) n_done;
+}
+
+
+/** @brief Simulate an ensemble of branches that share a spin-up period
+
+  The run of `firstfile` (e.g., historical weather) is simulated once from
+  its first year through `spinup_year` on the calling thread. Each branch
+  listed in the manifest then continues from the state at the end of the
+  spin-up with the remaining years of its own inputs, e.g., other weather
+  (files or a seed of the weather generator), CO2 scenarios, or vegetation
+  parameters (see `SW_SNAP_restore_state()`).
+
+  Each line of the manifest is a branch directory with its own master
+  input file, optionally followed by a non-zero seed; branches with a seed
+  re-seed the weather generator after the spin-up (with the stream of the
+  branch's position in the manifest), otherwise they continue its random
+  number sequence. Relative branch directories are relative to the directory
+  of the manifest. Branch inputs must describe the same soil
+  layers and species as the spin-up run.
+
+  @param manifest Name of the file that lists one branch directory per line.
+  @param firstfile Name of the master input file of the spin-up run; the
+    master input file of each branch has the same name (without path).
+  @param spinup_year Last year of the spin-up period.
+  @param n_workers Number of worker threads that simulate the branches.
+
+  @return Number of simulated branches.
+*/
+int SW_BAT_ensemble(const char *manifest, const char *firstfile,
+	TimeInt spinup_year, int n_workers) {
+
+	SW_BATCH b;
+	SW_SNAP_BUFFER state;
+	size_t k, n_done;
+	char *p, dir[FILENAME_MAX], path[MAX_FILENAMESIZE];
+
+	b.n_sites = _read_manifest(manifest, &b.sitedir);
+	strcpy(b.masterfile, BaseName(firstfile));
+	strcpy(dir, DirName(manifest));
+	b.n_real = 0;
+
+	if (b.n_sites == 0) {
+		LogError(logfp, LOGWARN, "No branch directories listed in %s\n",
+			manifest);
+		return 0;
+	}
+
+	b.seed = (long *) Mem_Calloc(b.n_sites, sizeof(long), "SW_BAT_ensemble()");
+	for (k = 0; k < b.n_sites; k++) {
+		if (!isnull(p = strpbrk(b.sitedir[k], " \t"))) {
+			*p = '\0';
+			b.seed[k] = strtol(p + 1, NULL, 10);
+		}
+
+		if ('\0' != dir[0] && '/' != b.sitedir[k][0]) {
+			if (MAX_FILENAMESIZE <= snprintf(path, MAX_FILENAMESIZE, "%s%s", dir,
+					b.sitedir[k])) {
+				LogError(logfp, LOGFATAL, "Path of branch is too long: %s",
+					b.sitedir[k]);
+			}
+			Mem_Free(b.sitedir[k]);
+			b.sitedir[k] = Str_Dup(path);
+		}
+	}
+
+	_spinup(firstfile, spinup_year, &state);
+	b.spinup = &state;
+
+	n_done = _simulate(&b, n_workers);
+
+	for (k = 0; k < b.n_sites; k++) {
+		Mem_Free(b.sitedir[k]);
+	}
+	Mem_Free(b.sitedir);
+	Mem_Free(b.seed);
+	Mem_Free(state.data);
+	SW_WTH_store_free_unused();
+
+	if (!QuietMode) {
+		swprintf("Simulated %zu of %zu branches after a spin-up through %u "
+			"with %d worker thread(s)\n", n_done, b.n_sites, spinup_year,
+			b.n_workers);
+	}
+
+	return (int) n_done;
+}
+
+
+/** @brief Simulate realizations of the weather generator for each site
+
+  Each site is simulated `n_real` times on the pool of worker threads.
+  Realization `r` (1, ..., `n_real`) of a site writes to its own log and
+  output files whose names carry the suffix `_r<r>` (see `OutputSuffix`),
+  e.g., `sw2_daily_r2.csv`.
+
+  The weather generator of each run is seeded with `seed` and its own
+  stream of random numbers (PCG stream selector), i.e., the stream of the
+  run index `k * n_real + r - 1` for site `k` (base0) of the manifest; results
+  are therefore reproducible and do not depend on the number of worker
+  threads. Realizations differ only in days for which the weather generator
+  is used (see `weathsetup.in`).
+
+  @param manifest Name of the file that lists one site directory per line;
+    `NULL` for the site of `firstfile`.
+  @param firstfile Name of the master input file of each site.
+  @param n_real Number of realizations of each site.
+  @param seed Seed of the weather generator.
+  @param n_workers Number of worker threads.
+
+  @return Number of simulated runs.
+*/
+int SW_BAT_realizations(const char *manifest, const char *firstfile,
+	int n_real, unsigned long seed, int n_workers) {
+
+	SW_BATCH b;
+	size_t k, n_done;
+	char sitedir[FILENAME_MAX];
+
+	if (isnull(manifest)) {
+		strcpy(sitedir, DirName(firstfile));
+		b.n_sites = 1;
+		b.sitedir = (char **) Mem_Malloc(sizeof(char *), "SW_BAT_realizations()");
+		b.sitedir[0] = Str_Dup(('\0' == sitedir[0]) ? "." : sitedir);
+	} else {
+		b.n_sites = _read_manifest(manifest, &b.sitedir);
+	}
+
+	strcpy(b.masterfile, BaseName(firstfile));
+	b.spinup = NULL;
+	b.seed = NULL;
+	b.n_real = (n_real < 1) ? 1 : n_real;
+	b.seed_real = (uint64_t) seed;
+
+	if (b.n_sites == 0) {
+		LogError(logfp, LOGWARN, "No site directories listed in %s\n", manifest);
+		return 0;
+	}
+
+	n_done = _simulate(&b, n_workers);
+
+	for (k = 0; k < b.n_sites; k++) {
+		Mem_Free(b.sitedir[k]);
+	}
+	Mem_Free(b.sitedir);
+	SW_WTH_store_free_unused();
+
+	if (!QuietMode) {
+		swprintf("Simulated %zu of %zu realizations of %zu site(s) with %d "
+			"worker thread(s)\n", n_done, b.n_sites * b.n_real, b.n_sites,
+			b.n_workers);
+	}
+
+	return (int) n_done;
+}
+
+
+/** @brief Convert the daily weather of all sites of a manifest into one
+  weather store
+
+  The inputs of each site are read (on the calling thread) to locate its
+  weather files and its years. The store covers the union of the years
+  of all sites and names each site by its directory as listed in the
+  manifest; a site uses the store if its weather path is set to
+  `path/file.sw2w:sitedir` (see `SW_Weather_store.c`).
+
+  @param manifest Name of the file that lists one site directory per line.
+  @param firstfile Name of the master input file of each site,
+    e.g., `files.in`; any path is ignored.
+  @param store Name of the weather store file to (over)write.
+
+  @return Number of converted sites.
+*/
+int SW_BAT_weather_store(const char *manifest, const char *firstfile,
+	const char *store) {
+
+	char **sitedir, **prefix, masterfile[MAX_FILENAMESIZE],
+		sitefile[MAX_FILENAMESIZE];
+	size_t k, n_sites;
+	TimeInt first_year = 0, last_year = 0;
+	FILE *prev_logfp = logfp;
+	Bool prev_ProjDirForAll = _ProjDirForAll;
+
+	n_sites = _read_manifest(manifest, &sitedir);
+	strcpy(masterfile, BaseName(firstfile));
+
+	if (n_sites == 0) {
+		LogError(logfp, LOGWARN, "No site directories listed in %s\n", manifest);
+		return 0;
+	}
+
+	prefix = (char **) Mem_Calloc(n_sites, sizeof(char *),
+		"SW_BAT_weather_store()");
+
+	_ProjDirForAll = swTRUE;
+
+	for (k = 0; k < n_sites; k++) {
+		_site_file(sitedir[k], masterfile, sitefile);
+		logged = swFALSE;
+
+		SW_CTL_setup_model(NULL, sitefile);
+		SW_CTL_read_inputs_from_disk(NULL); // opens log file of site
+
+		prefix[k] = Str_Dup(SW_Weather.name_prefix);
+		if (k == 0 || SW_Weather.yr.first < first_year) {
+			first_year = SW_Weather.yr.first;
+		}
+		if (k == 0 || SW_Weather.yr.last > last_year) {
+			last_year = SW_Weather.yr.last;
+		}
+
+		SW_CTL_clear_model(NULL, swFALSE);
+		_close_site_log(sitedir[k], prev_logfp);
+	}
+
+	_ProjDirForAll = prev_ProjDirForAll;
+
+	SW_WTH_store_write(store, (unsigned int) n_sites, sitedir, prefix,
+		first_year, last_year);
+
+	for (k = 0; k < n_sites; k++) {
+		Mem_Free(prefix[k]);
+		Mem_Free(sitedir[k]);
+	}
+	Mem_Free(prefix);
+	Mem_Free(sitedir);
+
+	if (!QuietMode) {
+		swprintf("Converted weather of %zu sites (%u-%u) into %s\n",
+			n_sites, first_year, last_year, store);
+	}
+
+	return (int) n_sites;
+}
@@ -0,0 +1,44 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Batch.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Batch.c: run SOILWAT2-standalone for many sites
+    on a pool of worker threads
+
+  History:
+  10/18/2026	INITIAL CODING
+  10/18/2026	added SW_BAT_ensemble()
+  10/18/2026	added SW_BAT_realizations()
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_BATCH_H
+#define SW_BATCH_H
+
+#include "Times.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/** Maximum number of worker threads of a batch run */
+#define SW_BAT_MAXWORKERS 256
+
+
+int SW_BAT_run(const char *manifest, const char *firstfile, int n_workers);
+int SW_BAT_ensemble(const char *manifest, const char *firstfile,
+	TimeInt spinup_year, int n_workers);
+int SW_BAT_realizations(const char *manifest, const char *firstfile,
+	int n_real, unsigned long seed, int n_workers);
+int SW_BAT_weather_store(const char *manifest, const char *firstfile,
+	const char *store);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
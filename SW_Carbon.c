@@ -35,10 +35,10 @@
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
 
-static char *MyFileName;
-SW_CARBON SW_Carbon;    // Declared here, externed elsewhere
-extern SW_VEGPROD SW_VegProd;
-extern SW_MODEL SW_Model;
+static SW_TLS char *MyFileName;
+SW_TLS SW_CARBON SW_Carbon;    // Declared here, externed elsewhere
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_MODEL SW_Model;
 
 
 /* =================================================== */
@@ -13,6 +13,12 @@
  *     (10-May-02) -- INITIAL CODING - cwb
  02/04/2012	(drs)	in function '_read_inputs()' moved order of 'SW_VPD_read' from after 'SW_VES_read' to before 'SW_SIT_read': SWPcrit is read in in 'SW_VPD_read' and then calculated SWC_atSWPcrit is assigned to each layer in 'SW_SIT_read'
  06/24/2013	(rjm)	added call to SW_FLW_construct() in function SW_CTL_init_model()
+ 10/18/2026	added SW_RUN: state of a simulation run that can be activated on
+ 	the calling thread; `SW_CTL_*` functions take the run to operate on
+ 10/18/2026	SW_CTL_read_inputs_from_disk() loads an up-to-date input snapshot
+ 	instead of parsing the input files (see `InputSnapshot`)
+ 10/18/2026	added SW_CTL_save_state() and SW_CTL_load_state(): checkpoints of
+ 	a simulation run at the end of a year
  */
 /********************************************************/
 /********************************************************/
@@ -41,96 +47,274 @@
 #include "SW_VegEstab.h"
 #include "SW_VegProd.h"
 #include "SW_Weather.h"
+#include "SW_Weather_store.h"
 #include "SW_Markov.h"
 #include "SW_Sky.h"
 #include "SW_Carbon.h"
+#include "SW_Timing.h"
+#include "SW_Snapshot.h"
 
 /* =================================================== */
 /*                  Global Declarations                */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
-extern SW_VEGESTAB SW_VegEstab;
-extern SW_SITE SW_Site;
-extern SW_VEGPROD SW_VegProd;
-extern SW_WEATHER SW_Weather;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_WEATHER SW_Weather;
+
+// state of a simulation run, see `SW_RUN` and `_transfer_run()`
+extern SW_TLS char *InFiles[SW_NFILES];
+extern SW_TLS char _ProjDir[FILENAME_MAX];
+extern SW_TLS char weather_prefix[FILENAME_MAX];
+extern SW_TLS char output_prefix[FILENAME_MAX];
+extern SW_TLS TimeInt _prevweek, _prevmonth, _prevyear;
+extern SW_TLS LyrIndex _TranspRgnBounds[MAX_TRANSP_REGIONS];
+extern SW_TLS RealD _SWCInitVal, _SWCWetVal, _SWCMinVal;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS RealD temp_snow;
+extern SW_TLS Bool weth_found;
+extern SW_TLS SW_MARKOV SW_Markov;
+extern SW_TLS sw_random_t markov_rng;
+extern SW_TLS SW_SKY SW_Sky;
+extern SW_TLS SW_CARBON SW_Carbon;
+extern SW_TLS RealD surfaceTemp[TWO_DAYS], veg_int_storage[NVEGTYPES],
+	litter_int_storage, standingWater[TWO_DAYS], drainout;
+extern SW_TLS ST_RGR_VALUES stValues;
+extern SW_TLS unsigned int soil_temp_init, fusion_pool_init;
+extern SW_TLS Bool do_once_at_soiltempError;
+extern SW_TLS double delta_time;
+extern SW_TLS Bool EchoInits;
+extern char InputSnapshot[]; /* see SW_Snapshot.c */
 
 /* =================================================== */
 /*                Module-Level Declarations            */
 /* --------------------------------------------------- */
+static SW_TLS SW_RUN
+	*_active_run = NULL, /* run that is currently active; NULL = `_thread_run` */
+	_thread_run; /* holds the thread's own state while another run is active */
+
+static void _transfer_run(SW_RUN *run, Bool restore);
+static void _construct_model(void);
 static void _begin_year(void);
 static void _begin_day(void);
 static void _end_day(void);
 
 
+/** @brief Move the state of a simulation run between `run` and
+    the module-level variables
+
+  @param run A simulation run.
+  @param restore If `swTRUE`, then `run` becomes the state of the module-level
+    variables; otherwise, the module-level variables are stored in `run`.
+*/
+static void _transfer_run(SW_RUN *run, Bool restore) {
+	#define xfer(field, var) \
+		if (restore) memcpy(&(var), &(field), sizeof(var)); \
+		else memcpy(&(field), &(var), sizeof(var))
+
+	xfer(run->InFiles, InFiles);
+	xfer(run->ProjDir, _ProjDir);
+	xfer(run->weather_prefix, weather_prefix);
+	xfer(run->output_prefix, output_prefix);
+
+	xfer(run->Model, SW_Model);
+	xfer(run->prevweek, _prevweek);
+	xfer(run->prevmonth, _prevmonth);
+	xfer(run->prevyear, _prevyear);
+
+	xfer(run->Site, SW_Site);
+	xfer(run->TranspRgnBounds, _TranspRgnBounds);
+	xfer(run->SWCInitVal, _SWCInitVal);
+	xfer(run->SWCWetVal, _SWCWetVal);
+	xfer(run->SWCMinVal, _SWCMinVal);
+	xfer(run->SoilWat, SW_Soilwat);
+	xfer(run->temp_snow, temp_snow);
+
+	xfer(run->Weather, SW_Weather);
+	xfer(run->weth_found, weth_found);
+	xfer(run->Markov, SW_Markov);
+	xfer(run->markov_rng, markov_rng);
+	xfer(run->Sky, SW_Sky);
+
+	xfer(run->VegProd, SW_VegProd);
+	xfer(run->VegEstab, SW_VegEstab);
+	xfer(run->Carbon, SW_Carbon);
+
+	xfer(run->surfaceTemp, surfaceTemp);
+	xfer(run->veg_int_storage, veg_int_storage);
+	xfer(run->litter_int_storage, litter_int_storage);
+	xfer(run->standingWater, standingWater);
+	xfer(run->drainout, drainout);
+
+	xfer(run->stValues, stValues);
+	xfer(run->soil_temp_init, soil_temp_init);
+	xfer(run->fusion_pool_init, fusion_pool_init);
+	xfer(run->do_once_at_soiltempError, do_once_at_soiltempError);
+	xfer(run->delta_time, delta_time);
+
+	#undef xfer
+
+	if (restore) {
+		SW_OUT_restore_run(&run->Out);
+
+		// memoized values belong to the previously active run
+		SW_PET_init_run();
+		if (SW_Model.year > 0) {
+			Time_new_year(SW_Model.year);
+		}
+
+	} else {
+		SW_OUT_store_run(&run->Out);
+	}
+}
+
+
+/** @brief Construct the modules of the model (independent of inputs)
+  except for the input files (see `SW_F_construct()`)
+*/
+static void _construct_model(void) {
+	SW_MDL_construct();
+	SW_WTH_construct();
+	// delay SW_MKV_construct() until we know from inputs whether we need it
+	// SW_SKY_construct() not need
+	SW_SIT_construct();
+	SW_VES_construct();
+	SW_VPD_construct();
+	// SW_FLW_construct() not needed
+	SW_OUT_construct();
+	SW_SWC_construct();
+	SW_CBN_construct();
+}
+
+
 /*******************************************************/
 /***************** Begin Main Code *********************/
+
+/** @brief Make `run` the active simulation run of the calling thread
+
+  The state of the previously active run (or the thread's own state if no run
+  was active) is stored and the module-level variables take on the state
+  of `run`.
+
+  @param run A zero-initialized or previously used simulation run;
+    `NULL` keeps the currently active state.
+*/
+void SW_CTL_activate_run(SW_RUN *run) {
+	if (isnull(run) || run == _active_run) {
+		return;
+	}
+
+	_transfer_run(isnull(_active_run) ? &_thread_run : _active_run, swFALSE);
+	_transfer_run(run, swTRUE);
+	_active_run = run;
+}
+
+/** @brief Store the active simulation run and return to the thread's own state
+*/
+void SW_CTL_release_run(void) {
+	if (!isnull(_active_run)) {
+		_transfer_run(_active_run, swFALSE);
+		_transfer_run(&_thread_run, swTRUE);
+		_active_run = NULL;
+	}
+}
+
+/** @brief Currently active simulation run of the calling thread
+
+  @return `NULL` if the thread operates on its own state.
+*/
+SW_RUN *SW_CTL_active_run(void) {
+	return _active_run;
+}
+
+
 /**
 @brief Calls 'SW_CTL_run_current_year' for each year
           which calls 'SW_SWC_water_flow' for each day.
+
+@param run The simulation run; `NULL` for the currently active state.
 */
 
-void SW_CTL_main(void) {
+void SW_CTL_main(SW_RUN *run) {
   #ifdef SWDEBUG
   int debug = 0;
   #endif
 
-  TimeInt *cur_yr = &SW_Model.year;
+  TimeInt *cur_yr;
+
+  SW_CTL_activate_run(run);
+  cur_yr = &SW_Model.year;
 
   for (*cur_yr = SW_Model.startyr; *cur_yr <= SW_Model.endyr; (*cur_yr)++) {
     #ifdef SWDEBUG
     if (debug) swprintf("\n'SW_CTL_main': simulate year = %d\n", *cur_yr);
     #endif
 
-    SW_CTL_run_current_year();
+    SW_CTL_run_current_year(NULL);
   }
 } /******* End Main Loop *********/
 
 /** @brief Setup and construct model (independent of inputs)
+
+  @param run The simulation run; `NULL` for the currently active state.
+  @param firstfile Name of the master input file.
  */
-void SW_CTL_setup_model(const char *firstfile) {
+void SW_CTL_setup_model(SW_RUN *run, const char *firstfile) {
+
+	SW_CTL_activate_run(run);
 
 	SW_F_construct(firstfile);
-	SW_MDL_construct();
-	SW_WTH_construct();
-	// delay SW_MKV_construct() until we know from inputs whether we need it
-	// SW_SKY_construct() not need
-	SW_SIT_construct();
-	SW_VES_construct();
-	SW_VPD_construct();
-	// SW_FLW_construct() not needed
-	SW_OUT_construct();
-	SW_SWC_construct();
-	SW_CBN_construct();
+	_construct_model();
 }
 
 
 /** @brief Free allocated memory
+		@param run The simulation run; `NULL` for the currently active state.
 		@param full_reset
 			* If `FALSE`, de-allocate memory for `SOILWAT2` variables, but
 					* do not reset output arrays `p_OUT` and `p_OUTsd` which are used under
 						`SW_OUTARRAY` to pass output in-memory to `rSOILWAT2` and to
 						`STEPWAT2`
-			* if `TRUE`, de-allocate all memory including output arrays.
+					* keep the model set up (its output structures are cleared and
+						reused) so that the inputs of another run can be read after
+						setting the master input file with `SW_F_construct()`
+			* if `TRUE`, de-allocate all memory including output arrays and
+				weather stores that were kept for reuse by other runs.
 */
-void SW_CTL_clear_model(Bool full_reset) {
+void SW_CTL_clear_model(SW_RUN *run, Bool full_reset) {
+	SW_CTL_activate_run(run);
+
 	SW_F_deconstruct();
 	SW_MDL_deconstruct();
-	SW_WTH_deconstruct(); // calls SW_MKV_deconstruct() if needed
+	SW_WTH_deconstruct(full_reset); // calls SW_MKV_deconstruct() if needed
 	// SW_SKY_deconstruct() not needed
 	SW_SIT_deconstruct();
-	SW_VES_deconstruct();
-	SW_VPD_deconstruct();
+	SW_VES_deconstruct(full_reset);
+	SW_VPD_deconstruct(full_reset);
 	// SW_FLW_deconstruct() not needed
+	SW_PET_deconstruct(); // release the solar geometry table of this run
 	SW_OUT_deconstruct(full_reset);
-	SW_SWC_deconstruct();
+	SW_SWC_deconstruct(full_reset);
 	SW_CBN_deconstruct();
+
+	if (full_reset) {
+		SW_WTH_store_free_unused(); // weather that was kept for reuse by other runs
+		SW_PET_solargeom_clear(); // solar geometry that was kept for reuse by other runs
+	} else {
+		_construct_model();
+	}
 }
 
 /** @brief Initialize simulation run (based on user inputs)
   Note: Time will only be set up correctly while carrying out a
   simulation year, i.e., after calling _begin_year()
+
+  @param run The simulation run; `NULL` for the currently active state.
 */
-void SW_CTL_init_run(void) {
+void SW_CTL_init_run(SW_RUN *run) {
+
+	SW_CTL_activate_run(run);
 
 	// SW_F_init_run() not needed
 	// SW_MDL_init_run() not needed
@@ -152,14 +336,19 @@ void SW_CTL_init_run(void) {
 
 /**
 @brief Calls 'SW_SWC_water_flow' for each day.
+
+@param run The simulation run; `NULL` for the currently active state.
 */
-void SW_CTL_run_current_year(void) {
+void SW_CTL_run_current_year(SW_RUN *run) {
   /*=======================================================*/
-  TimeInt *doy = &SW_Model.doy; // base1
+  TimeInt *doy;
   #ifdef SWDEBUG
   int debug = 0;
   #endif
 
+  SW_CTL_activate_run(run);
+  doy = &SW_Model.doy; // base1
+
   #ifdef SWDEBUG
   if (debug) swprintf("\n'SW_CTL_run_current_year': begin new year\n");
   #endif
@@ -205,6 +394,37 @@ void SW_CTL_run_current_year(void) {
   #endif
 }
 
+/** @brief Save the state of a simulation run at the end of a year
+
+  The run must have completed a simulation year, e.g., via
+  `SW_CTL_run_current_year()` or `SW_CTL_main()`; the checkpoint holds the
+  state that is carried into the following year (see
+  `SW_SNAP_write_state()`).
+
+  @param run The simulation run; `NULL` for the currently active state.
+  @param fname Name of the checkpoint file.
+*/
+void SW_CTL_save_state(SW_RUN *run, const char *fname) {
+  SW_CTL_activate_run(run);
+  SW_SNAP_write_state(fname);
+}
+
+/** @brief Continue a simulation run from a saved state
+
+  Call after `SW_CTL_init_run()` and before output is set up; a following
+  `SW_CTL_main()` simulates the years after the year of the checkpoint
+  (see `SW_SNAP_read_state()`). The inputs of the run may differ from those
+  of the run that saved the state, e.g., scenarios of future weather that
+  share a spin-up period, but the soil layers must be the same.
+
+  @param run The simulation run; `NULL` for the currently active state.
+  @param fname Name of the checkpoint file.
+*/
+void SW_CTL_load_state(SW_RUN *run, const char *fname) {
+  SW_CTL_activate_run(run);
+  SW_SNAP_read_state(fname);
+}
+
 /**
 @brief Initiate/update variables for a new simulation year.
       In addition to the timekeeper (Model), usually only modules
@@ -228,7 +448,10 @@ static void _begin_year(void) {
 
 static void _begin_day(void) {
 	SW_MDL_new_day();
+
+	SW_TIMER_START(eSW_TimNewDay);
 	SW_WTH_new_day();
+	SW_TIMER_STOP(eSW_TimNewDay);
 }
 
 static void _end_day(void) {
@@ -240,73 +463,125 @@ static void _end_day(void) {
 /**
 @brief Reads inputs from disk and makes a print statement if there is an error
         in doing so.
+
+If `InputSnapshot` is set, then the inputs are loaded from the snapshot in
+the project directory if it is up-to-date; otherwise, the inputs are parsed
+and saved to the snapshot for later runs (see `SW_SNAP_read()`).
+Input snapshots are not used if `EchoInits` is set.
+
+@param run The simulation run; `NULL` for the currently active state.
 */
-void SW_CTL_read_inputs_from_disk(void) {
+void SW_CTL_read_inputs_from_disk(SW_RUN *run) {
+  char snapfile[FILENAME_MAX] = "";
   #ifdef SWDEBUG
   int debug = 0;
   #endif
 
+  SW_CTL_activate_run(run);
+
   #ifdef SWDEBUG
   if (debug) swprintf("'SW_CTL_read_inputs_from_disk': Read input from disk:");
   #endif
 
+  SW_TIMER_START(eSW_TimReadFiles);
   SW_F_read(NULL);
+  SW_TIMER_STOP(eSW_TimReadFiles);
   #ifdef SWDEBUG
   if (debug) swprintf(" 'files'");
   #endif
 
+  if (InputSnapshot[0] != '\0' && !EchoInits) {
+    snprintf(snapfile, sizeof snapfile, "%s%s", _ProjDir, InputSnapshot);
+
+    SW_TIMER_START(eSW_TimReadSnapshot);
+    if (SW_SNAP_read(snapfile)) {
+      SW_TIMER_STOP(eSW_TimReadSnapshot);
+      #ifdef SWDEBUG
+      if (debug) swprintf(" > 'snapshot' completed.\n");
+      #endif
+      return;
+    }
+    SW_TIMER_STOP(eSW_TimReadSnapshot);
+  }
+
+  SW_TIMER_START(eSW_TimReadModel);
   SW_MDL_read();
+  SW_TIMER_STOP(eSW_TimReadModel);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'model'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadWeather);
   SW_WTH_read();
+  SW_TIMER_STOP(eSW_TimReadWeather);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'weather'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadSky);
   SW_SKY_read();
+  SW_TIMER_STOP(eSW_TimReadSky);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'climate'");
   #endif
 
   if (SW_Weather.use_weathergenerator) {
+    SW_TIMER_START(eSW_TimReadMarkov);
     SW_MKV_setup();
+    SW_TIMER_STOP(eSW_TimReadMarkov);
     #ifdef SWDEBUG
     if (debug) swprintf(" > 'weather generator'");
     #endif
   }
 
+  SW_TIMER_START(eSW_TimReadVegProd);
   SW_VPD_read();
+  SW_TIMER_STOP(eSW_TimReadVegProd);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'veg'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadSite);
   SW_SIT_read(); // inputs also soil layer data
+  SW_TIMER_STOP(eSW_TimReadSite);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'site' + 'soils'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadVegEstab);
   SW_VES_read();
+  SW_TIMER_STOP(eSW_TimReadVegEstab);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'establishment'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadOutput);
   SW_OUT_read();
+  SW_TIMER_STOP(eSW_TimReadOutput);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'ouput'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadCarbon);
   SW_CBN_read();
+  SW_TIMER_STOP(eSW_TimReadCarbon);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'CO2'");
   #endif
 
+  SW_TIMER_START(eSW_TimReadSWC);
   SW_SWC_read();
+  SW_TIMER_STOP(eSW_TimReadSWC);
   #ifdef SWDEBUG
   if (debug) swprintf(" > 'swc'");
   if (debug) swprintf(" completed.\n");
   #endif
+
+  if (snapfile[0] != '\0') {
+    SW_TIMER_START(eSW_TimReadSnapshot);
+    SW_SNAP_write(snapfile);
+    SW_TIMER_STOP(eSW_TimReadSnapshot);
+  }
 }
 
 
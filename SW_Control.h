@@ -11,6 +11,7 @@
  *
  *  History:
  *     (10-May-02) -- INITIAL CODING - cwb
+ 10/18/2026	added SW_CTL_save_state() and SW_CTL_load_state()
  */
 /********************************************************/
 /********************************************************/
@@ -18,16 +19,107 @@
 #ifndef SW_CONTROL_H
 #define SW_CONTROL_H
 
+#include <stdio.h>
+#include "generic.h"
+#include "rands.h"
+#include "SW_Defines.h"
+#include "SW_Files.h"
+#include "SW_Model.h"
+#include "SW_Site.h"
+#include "SW_SoilWater.h"
+#include "SW_Weather.h"
+#include "SW_Markov.h"
+#include "SW_Sky.h"
+#include "SW_VegProd.h"
+#include "SW_VegEstab.h"
+#include "SW_Carbon.h"
+#include "SW_Flow_lib.h"
+#include "SW_Output.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void SW_CTL_setup_model(const char *firstfile);
-void SW_CTL_clear_model(Bool full_reset);
-void SW_CTL_init_run(void);
-void SW_CTL_read_inputs_from_disk(void);
-void SW_CTL_main(void); /* main controlling loop for SOILWAT  */
-void SW_CTL_run_current_year(void);
+
+/** @brief State of a simulation run
+
+  A simulation run is carried out on the module-level variables of the
+  calling thread (each thread has its own set if compiled with `SWTHREADS`).
+  `SW_RUN` holds a complete copy of this state while a run is not active;
+  this allows several runs to be interleaved on one thread, e.g., one
+  site after the other each for one year.
+
+  A run is activated by passing it to any `SW_CTL_*` function (or to
+  `SW_CTL_activate_run()`) and stays active on that thread until another
+  run is activated. A `NULL` run continues with the currently active state,
+  i.e., the behavior before `SW_RUN` was introduced.
+
+  An `SW_RUN` must be zero-initialized before its first activation.
+  Pointer members (e.g., soil layers) are owned by the run; activating a run
+  moves, but does not copy, them. Logging (`logfp`, `logged`) is per thread
+  and not part of a run. Memoized values (e.g., solar geometry) and
+  scratch arrays are re-computed after a run is activated.
+*/
+typedef struct {
+	/* input files */
+	char *InFiles[SW_NFILES],
+		ProjDir[FILENAME_MAX],
+		weather_prefix[FILENAME_MAX],
+		output_prefix[FILENAME_MAX];
+
+	/* time */
+	SW_MODEL Model;
+	TimeInt prevweek, prevmonth, prevyear;
+
+	/* site and soil water */
+	SW_SITE Site;
+	LyrIndex TranspRgnBounds[MAX_TRANSP_REGIONS];
+	RealD SWCInitVal, SWCWetVal, SWCMinVal;
+	SW_SOILWAT SoilWat;
+	RealD temp_snow;
+
+	/* weather */
+	SW_WEATHER Weather;
+	Bool weth_found;
+	SW_MARKOV Markov;
+	sw_random_t markov_rng;
+	SW_SKY Sky;
+
+	/* vegetation */
+	SW_VEGPROD VegProd;
+	SW_VEGESTAB VegEstab;
+	SW_CARBON Carbon;
+
+	/* water flow: values carried from one day to the next */
+	RealD surfaceTemp[TWO_DAYS],
+		veg_int_storage[NVEGTYPES],
+		litter_int_storage,
+		standingWater[TWO_DAYS],
+		drainout;
+
+	/* soil temperature */
+	ST_RGR_VALUES stValues;
+	unsigned int soil_temp_init, fusion_pool_init;
+	Bool do_once_at_soiltempError;
+	double delta_time;
+
+	/* output */
+	SW_OUT_RUN Out;
+} SW_RUN;
+
+
+void SW_CTL_activate_run(SW_RUN *run);
+void SW_CTL_release_run(void);
+SW_RUN *SW_CTL_active_run(void);
+
+void SW_CTL_setup_model(SW_RUN *run, const char *firstfile);
+void SW_CTL_clear_model(SW_RUN *run, Bool full_reset);
+void SW_CTL_init_run(SW_RUN *run);
+void SW_CTL_read_inputs_from_disk(SW_RUN *run);
+void SW_CTL_main(SW_RUN *run); /* main controlling loop for SOILWAT  */
+void SW_CTL_run_current_year(SW_RUN *run);
+void SW_CTL_save_state(SW_RUN *run, const char *fname);
+void SW_CTL_load_state(SW_RUN *run, const char *fname);
 
 #ifdef DEBUG_MEM
 void SW_CTL_SetMemoryRefs(void);
@@ -55,6 +55,10 @@ extern "C" {
 #define MAX_TRANSP_REGIONS 4
 #define MAX_ST_RGR 100
 
+/* numerical schemes of the soil temperature equation, see `soil_temperature()` */
+#define SW_ST_EXPLICIT 0 /* explicit; sub-daily time step is shortened until stable */
+#define SW_ST_IMPLICIT 1 /* implicit (Crank-Nicolson); one time step per day */
+
 #define MAX_NYEAR 2500  /**< An integer representing the max calendar year that is supported. The number just needs to be reasonable, it is an artifical limit. */
 
 #define SW_MISSING     999.     /* value to use as MISSING */
@@ -13,6 +13,10 @@
  new module-level variable static char weather_prefix[FILENAME_MAX]; read in in function SW_F_read() from file files.in line 6
  09/30/2011	(drs)	added function SW_OutputPrefix(): so that SW_Output can access local variable output_prefix that is read in now in SW_F_read()
  new module-level variable static char output_prefix[FILENAME_MAX]; read in in function SW_F_read() from file files.in line 12: / for same directory, or e.g., Output/
+ 10/18/2026	added `_ProjDirForAll` so that weather and output files of a
+ 	run can be located relative to its project directory (used by batch runs)
+ 10/18/2026	added `OutputSuffix` so that several runs of a site can write
+ 	their own log and output files (used by weather realizations)
  */
 /********************************************************/
 /********************************************************/
@@ -33,11 +37,23 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-static char *MyFileName;
-char *InFiles[SW_NFILES];
-char _ProjDir[FILENAME_MAX];
-char weather_prefix[FILENAME_MAX];
-char output_prefix[FILENAME_MAX];
+static SW_TLS char *MyFileName;
+SW_TLS char *InFiles[SW_NFILES];
+SW_TLS char _ProjDir[FILENAME_MAX];
+SW_TLS char weather_prefix[FILENAME_MAX];
+SW_TLS char output_prefix[FILENAME_MAX];
+
+/** If `swTRUE`, then the weather and output file names of `files.in` are,
+    like the other input files, relative to `_ProjDir` instead of to the
+    current working directory (see `SW_BAT_run()`); absolute paths are kept
+*/
+SW_TLS Bool _ProjDirForAll = swFALSE;
+
+/** Appended to the names of the log and output files of `files.in` before
+    their extension, e.g., `sw2_daily_r2.csv` (see `SW_BAT_realizations()`);
+    empty for none
+*/
+SW_TLS char OutputSuffix[32] = "";
 
 /* =================================================== */
 /* =================================================== */
@@ -65,6 +81,27 @@ static void init(const char *s) {
 
 }
 
+/* Insert `OutputSuffix` into a file name (of size `FILENAME_MAX`) before
+   its extension */
+static void _add_suffix(char *s) {
+	char buf[FILENAME_MAX], *base, *ext;
+
+	if ('\0' == OutputSuffix[0]) {
+		return;
+	}
+
+	base = strrchr(s, '/');
+	base = isnull(base) ? s : base + 1;
+	ext = strrchr(base, '.');
+	if (isnull(ext)) {
+		ext = s + strlen(s);
+	}
+
+	snprintf(buf, FILENAME_MAX, "%.*s%s%s", (int) (ext - s), s, OutputSuffix,
+		ext);
+	strcpy(s, buf);
+}
+
 /* =================================================== */
 /* =================================================== */
 /*             Public Function Definitions             */
@@ -138,6 +175,18 @@ void SW_F_read(const char *s) {
     if (debug) swprintf("'SW_F_read': line = %d/%d: %s\n", lineno, eEndFile, inbuf);
     #endif
 
+		if (_ProjDirForAll && inbuf[0] != '/' &&
+				(lineno == 5 || (lineno >= 15 && lineno <= 22))) {
+			strcpy(buf, _ProjDir);
+			strcat(buf, inbuf);
+			strcpy(inbuf, buf);
+		}
+
+		if ((lineno >= 15 && lineno <= 22) || (lineno == 1 &&
+				0 != strcmp(inbuf, "stdout") && 0 != strcmp(inbuf, "stderr"))) {
+			_add_suffix(inbuf);
+		}
+
 		switch (lineno) {
 		case 5:
 			strcpy(weather_prefix, inbuf);
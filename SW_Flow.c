@@ -97,6 +97,10 @@
  06/23/2015 (akt)	Added surfaceTemp[Today] value at structure SW_Weather so that we can add surfaceTemp[Today] in output from Sw_Outout.c get_tmp() function
  02/08/2016 (CMA & CTD) Added snowpack as an input argument to function call of soil_temperature()
  02/08/2016 (CMA & CTD) Modified biomass to use the live biomass as opposed to standing crop
+ 10/18/2026	soil layer parameters are passed directly from the per-layer arrays of SW_Site;
+ removed their copies in records2arrays()
+ 10/18/2026	soil water potentials for hydraulic_redistribution() are calculated once
+ per day and shared among vegetation types
  */
 /********************************************************/
 /********************************************************/
@@ -123,19 +127,20 @@
 
 #include "SW_Flow_lib_PET.h"
 #include "SW_Flow.h"
+#include "SW_Timing.h"
 
 
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
-extern SW_SITE SW_Site;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_WEATHER SW_Weather;
-extern SW_VEGPROD SW_VegProd;
-extern SW_SKY SW_Sky;
-
-extern unsigned int soil_temp_init;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_SKY SW_Sky;
+
+extern SW_TLS unsigned int soil_temp_init;
 extern char const *key2veg[];
 
 /* *************************************************** */
@@ -146,31 +151,27 @@ extern char const *key2veg[];
  * array indexing in those routines will be from
  * zero rather than 1.  see records2arrays().
  */
-IntU lyrTrRegions[NVEGTYPES][MAX_LAYERS];
+/* soil layer parameters are used directly from the per-layer arrays of
+ * SW_Site, e.g., SW_Site.width, and are not copied here */
+SW_TLS RealD lyrSWCBulk[MAX_LAYERS], lyrDrain[MAX_LAYERS],
 
-RealD lyrSWCBulk[MAX_LAYERS], lyrDrain[MAX_LAYERS],
-
-	lyrTransp[NVEGTYPES][MAX_LAYERS], lyrTranspCo[NVEGTYPES][MAX_LAYERS],
+	lyrTransp[NVEGTYPES][MAX_LAYERS],
 	lyrEvap[NVEGTYPES][MAX_LAYERS], lyrEvap_BareGround[MAX_LAYERS],
-	lyrSWCBulk_atSWPcrit[NVEGTYPES][MAX_LAYERS], lyrHydRed[NVEGTYPES][MAX_LAYERS],
+	lyrHydRed[NVEGTYPES][MAX_LAYERS],
 
-	lyrbDensity[MAX_LAYERS], lyrWidths[MAX_LAYERS],
-	lyrEvapCo[MAX_LAYERS], lyrSumTrCo[MAX_TRANSP_REGIONS + 1],
-	lyrImpermeability[MAX_LAYERS],
-	lyrSWCBulk_FieldCaps[MAX_LAYERS], lyrSWCBulk_Saturated[MAX_LAYERS],
-	lyrSWCBulk_Wiltpts[MAX_LAYERS], lyrSWCBulk_HalfWiltpts[MAX_LAYERS],
-	lyrSWCBulk_Mins[MAX_LAYERS],
+	lyrSumTrCo[MAX_TRANSP_REGIONS + 1],
 
 	lyroldsTemp[MAX_LAYERS], lyrsTemp[MAX_LAYERS];
 
-RealD drainout; /* h2o drained out of deepest layer */
+SW_TLS RealD drainout; /* h2o drained out of deepest layer */
 
 // variables to help calculate runon from a (hypothetical) upslope neighboring (UpNeigh) site
-RealD UpNeigh_lyrSWCBulk[MAX_LAYERS], UpNeigh_lyrDrain[MAX_LAYERS], UpNeigh_drainout,
+SW_TLS RealD UpNeigh_lyrSWCBulk[MAX_LAYERS], UpNeigh_lyrDrain[MAX_LAYERS], UpNeigh_drainout,
 	UpNeigh_standingWater;
 
 
-static RealD surfaceTemp[TWO_DAYS],
+// carried from day to day; externed by `SW_Control.c` for `SW_RUN`
+SW_TLS RealD surfaceTemp[TWO_DAYS],
 	veg_int_storage[NVEGTYPES], // storage of intercepted rain by the vegetation
 	litter_int_storage, // storage of intercepted rain by the litter layer
 	standingWater[TWO_DAYS]; /* water on soil surface if layer below is saturated */
@@ -207,21 +208,14 @@ void SW_FLW_init_run(void) {
 	//These only have to be cleared if a loop is wrong in the code.
 	for (i = 0; i < MAX_LAYERS; i++) {
 		ForEachVegType(k) {
-			lyrTrRegions[k][i] = 0;
 			lyrTransp[k][i] = 0.;
-			lyrTranspCo[k][i] = 0.;
 			lyrEvap[k][i] = 0.;
-			lyrSWCBulk_atSWPcrit[k][i] = 0.;
 			lyrHydRed[k][i] = 0;
 		}
 
 		lyrSWCBulk[i] = lyrDrain[i] = 0.;
 		lyrEvap_BareGround[i] = 0;
-		lyrEvapCo[i] = lyrSWCBulk_FieldCaps[i] = 0;
-		lyrWidths[i] = lyrSWCBulk_Wiltpts[i] = lyrSWCBulk_HalfWiltpts[i] = 0;
-		lyrSWCBulk_Mins[i] = 0;
-		lyrImpermeability[i] = lyrSWCBulk_Saturated[i] = 0;
-		lyroldsTemp[i] = lyrsTemp[i] = lyrbDensity[i] = 0;
+		lyroldsTemp[i] = lyrsTemp[i] = 0;
 	}
 
 	for(i=0; i<= MAX_TRANSP_REGIONS; i++)
@@ -243,7 +237,12 @@ void SW_FLW_init_run(void) {
 /* *************************************************** */
 /*            The Water Flow                           */
 /* --------------------------------------------------- */
-void SW_Water_Flow(void) {
+
+/** @brief Simulate water flow and soil temperature for the current day
+
+  @param run The simulation run; `NULL` for the currently active state.
+*/
+void SW_Water_Flow(SW_RUN *run) {
 	#ifdef SWDEBUG
 	IntUS debug = 0, debug_year = 1980, debug_doy = 350;
 	double Eveg, Tveg, HRveg;
@@ -260,11 +259,15 @@ void SW_Water_Flow(void) {
 		surface_evap_litter_rate = 1., surface_evap_standingWater_rate = 1.,
 		h2o_for_soil = 0., snowmelt,
 		scale_veg[NVEGTYPES],
-		pet2, peti, rate_help, x;
+		pet2, peti, rate_help, x,
+		lyrSWP[MAX_LAYERS], lyrSWP_Wiltpt[MAX_LAYERS];
 
 	int doy, month, k;
+	Bool has_SWP = swFALSE;
 	LyrIndex i;
 
+	SW_CTL_activate_run(run);
+
 	doy = SW_Model.doy; /* base1 */
 	month = SW_Model.month; /* base0 */
 
@@ -289,14 +292,14 @@ void SW_Water_Flow(void) {
 		SW_ST_setup_run(
 			w->now.temp_avg[Today],
 			lyrSWCBulk,
-			lyrSWCBulk_Saturated,
-			lyrbDensity,
-			lyrWidths,
+			SW_Site.swcBulk_saturated,
+			SW_Site.soilBulk_density,
+			SW_Site.width,
 			lyroldsTemp,
 			surfaceTemp,
 			SW_Site.n_layers,
-			lyrSWCBulk_FieldCaps,
-			lyrSWCBulk_Wiltpts,
+			SW_Site.swcBulk_fieldcap,
+			SW_Site.swcBulk_wiltpt,
 			SW_Site.Tsoil_constant,
 			SW_Site.stDeltaX,
 			SW_Site.stMaxDepth,
@@ -313,6 +316,7 @@ void SW_Water_Flow(void) {
 		x += v->veg[k].cov.albedo * v->veg[k].cov.fCover;
 	}
 
+	SW_TIMER_START(eSW_TimRadiationPET);
 	sw->H_gt = solar_radiation(
 		doy,
 		SW_Site.latitude,
@@ -337,6 +341,7 @@ void SW_Water_Flow(void) {
 		SW_Sky.windspeed_daily[doy],
 		SW_Sky.cloudcov_daily[doy]
 	);
+	SW_TIMER_STOP(eSW_TimRadiationPET);
 
 
 	/* snowdepth scaling */
@@ -358,6 +363,7 @@ void SW_Water_Flow(void) {
 	}
 
 	/* Rainfall interception */
+	SW_TIMER_START(eSW_TimInterception);
 	h2o_for_soil = w->now.rain[Today]; /* ppt is partioned into ppt = snow + rain */
 
   ForEachVegType(k)
@@ -391,6 +397,7 @@ void SW_Water_Flow(void) {
     }
   }
 
+	SW_TIMER_STOP(eSW_TimInterception);
 	/* End Interception */
 
 
@@ -419,9 +426,11 @@ void SW_Water_Flow(void) {
 		UpNeigh_standingWater = standingWater[Today];
 
 		// Infiltrate for upslope neighbor under saturated soil conditions
+		SW_TIMER_START(eSW_TimInfiltration);
 		infiltrate_water_high(UpNeigh_lyrSWCBulk, UpNeigh_lyrDrain, &UpNeigh_drainout,
-			h2o_for_soil, SW_Site.n_layers, lyrSWCBulk_FieldCaps, lyrSWCBulk_Saturated,
-			lyrImpermeability, &UpNeigh_standingWater);
+			h2o_for_soil, SW_Site.n_layers, SW_Site.swcBulk_fieldcap, SW_Site.swcBulk_saturated,
+			SW_Site.impermeability, &UpNeigh_standingWater);
+		SW_TIMER_STOP(eSW_TimInfiltration);
 
 		// Runon as percentage from today's surface water addition on upslope neighbor
 		w->surfaceRunon = fmax(0., (UpNeigh_standingWater - standingWater[Yesterday]) * SW_Site.percentRunon);
@@ -436,8 +445,10 @@ void SW_Water_Flow(void) {
 
 	/* Percolation under saturated soil conditions */
 	w->soil_inf += standingWater[Today];
+	SW_TIMER_START(eSW_TimInfiltration);
 	infiltrate_water_high(lyrSWCBulk, lyrDrain, &drainout, h2o_for_soil, SW_Site.n_layers,
-		lyrSWCBulk_FieldCaps, lyrSWCBulk_Saturated, lyrImpermeability, &standingWater[Today]);
+		SW_Site.swcBulk_fieldcap, SW_Site.swcBulk_saturated, SW_Site.impermeability, &standingWater[Today]);
+	SW_TIMER_STOP(eSW_TimInfiltration);
 	w->soil_inf -= standingWater[Today]; // adjust soil_infiltration for not infiltrated surface water
 
 	#ifdef SWDEBUG
@@ -473,9 +484,9 @@ void SW_Water_Flow(void) {
 	/* Potential bare-soil evaporation rates */
 	if (GT(v->bare_cov.fCover, 0.) && EQ(sw->snowpack[Today], 0.)) /* bare ground present AND no snow on ground */
 	{
-		pot_soil_evap_bs(&soil_evap_rate_bs, SW_Site.n_evap_lyrs, lyrEvapCo, sw->pet,
+		pot_soil_evap_bs(&soil_evap_rate_bs, SW_Site.n_evap_lyrs, SW_Site.evap_coeff, sw->pet,
 			SW_Site.evap.xinflec, SW_Site.evap.slope, SW_Site.evap.yinflec,
-			SW_Site.evap.range, lyrWidths, lyrSWCBulk);
+			SW_Site.evap.range, SW_Site.width, lyrSWCBulk);
 		soil_evap_rate_bs *= v->bare_cov.fCover;
 
 	} else {
@@ -492,10 +503,10 @@ void SW_Water_Flow(void) {
 				v->veg[k].EsTpartitioning_param);
 
 			if (EQ(sw->snowpack[Today], 0.)) { /* bare-soil evaporation only when no snow */
-				pot_soil_evap(&soil_evap_rate[k], SW_Site.n_evap_lyrs, lyrEvapCo,
+				pot_soil_evap(&soil_evap_rate[k], SW_Site.n_evap_lyrs, SW_Site.evap_coeff,
 					v->veg[k].total_agb_daily[doy], soil_evap[k], sw->pet,
 					SW_Site.evap.xinflec, SW_Site.evap.slope, SW_Site.evap.yinflec, SW_Site.evap.range,
-					lyrWidths, lyrSWCBulk, v->veg[k].Es_param_limit);
+					SW_Site.width, lyrSWCBulk, v->veg[k].Es_param_limit);
 
 				soil_evap_rate[k] *= v->veg[k].cov.fCover;
 
@@ -503,8 +514,10 @@ void SW_Water_Flow(void) {
 				soil_evap_rate[k] = 0.;
 			}
 
+			SW_TIMER_START(eSW_TimTranspAvg);
 			transp_weighted_avg(&swpot_avg[k], SW_Site.n_transp_rgn, SW_Site.n_transp_lyrs[k],
-				lyrTrRegions[k], lyrTranspCo[k], lyrSWCBulk);
+				SW_Site.my_transp_rgn[k], SW_Site.transp_coeff[k], lyrSWCBulk);
+			SW_TIMER_STOP(eSW_TimTranspAvg);
 
 			pot_transp(&transp_rate[k], swpot_avg[k],
 				v->veg[k].biolive_daily[doy], v->veg[k].biodead_daily[doy],
@@ -584,7 +597,7 @@ void SW_Water_Flow(void) {
 	if (GT(v->bare_cov.fCover, 0.) && EQ(sw->snowpack[Today], 0.)) {
 		/* remove bare-soil evap from swv */
 		remove_from_soil(lyrSWCBulk, lyrEvap_BareGround, &sw->aet, SW_Site.n_evap_lyrs,
-			lyrEvapCo, soil_evap_rate_bs, lyrSWCBulk_HalfWiltpts);
+			SW_Site.evap_coeff, soil_evap_rate_bs, SW_Site.swcBulk_halfwiltpt);
 
 	} else {
 		/* Set daily array to zero, no evaporation */
@@ -613,11 +626,11 @@ void SW_Water_Flow(void) {
 		if (GT(scale_veg[k], 0.)) {
 			/* remove bare-soil evap from swc */
 			remove_from_soil(lyrSWCBulk, lyrEvap[k], &sw->aet, SW_Site.n_evap_lyrs,
-				lyrEvapCo, soil_evap_rate[k], lyrSWCBulk_HalfWiltpts);
+				SW_Site.evap_coeff, soil_evap_rate[k], SW_Site.swcBulk_halfwiltpt);
 
 			/* remove transp from swc */
 			remove_from_soil(lyrSWCBulk, lyrTransp[k], &sw->aet, SW_Site.n_transp_lyrs[k],
-				lyrTranspCo[k], transp_rate[k], lyrSWCBulk_atSWPcrit[k]);
+				SW_Site.transp_coeff[k], transp_rate[k], SW_Site.swcBulk_atSWPcrit[k]);
 
 		} else {
 			/* Set daily array to zero, no evaporation or transpiration */
@@ -652,9 +665,22 @@ void SW_Water_Flow(void) {
 		if (v->veg[k].flagHydraulicRedistribution && GT(v->veg[k].cov.fCover, 0.) &&
 			GT(v->veg[k].biolive_daily[doy], 0.)) {
 
-			hydraulic_redistribution(lyrSWCBulk, lyrSWCBulk_Wiltpts, lyrTranspCo[k],
-				lyrHydRed[k], SW_Site.n_layers, v->veg[k].maxCondroot, v->veg[k].swpMatric50,
-				v->veg[k].shapeCond, v->veg[k].cov.fCover);
+			SW_TIMER_START(eSW_TimHydRed);
+			if (!has_SWP) {
+				// hydraulic_redistribution() updates lyrSWP of changed layers
+				ForEachSoilLayer(i) {
+					lyrSWP[i] = SW_SWC_swp(lyrSWCBulk[i], i);
+					lyrSWP_Wiltpt[i] = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[i],
+						SW_Site.swcBulk_wiltpt[i], i);
+				}
+				has_SWP = swTRUE;
+			}
+
+			hydraulic_redistribution(lyrSWCBulk, lyrSWP, SW_Site.swcBulk_wiltpt,
+				lyrSWP_Wiltpt, SW_Site.transp_coeff[k], lyrHydRed[k], SW_Site.n_layers,
+				v->veg[k].maxCondroot, v->veg[k].swpMatric50, v->veg[k].shapeCond,
+				v->veg[k].cov.fCover);
+			SW_TIMER_STOP(eSW_TimHydRed);
 
 		} else {
 			/* Set daily array to zero */
@@ -691,8 +717,8 @@ void SW_Water_Flow(void) {
 
 	infiltrate_water_low(
 		lyrSWCBulk, lyrDrain, &drainout, SW_Site.n_layers,
-		SW_Site.slow_drain_coeff, SLOW_DRAIN_DEPTH, lyrSWCBulk_FieldCaps, lyrWidths,
-		lyrSWCBulk_Mins, lyrSWCBulk_Saturated, lyrImpermeability, &standingWater[Today]
+		SW_Site.slow_drain_coeff, SLOW_DRAIN_DEPTH, SW_Site.swcBulk_fieldcap, SW_Site.width,
+		SW_Site.swcBulk_min, SW_Site.swcBulk_saturated, SW_Site.impermeability, &standingWater[Today]
 	);
 
 	// adjust soil_infiltration for water pushed back to surface
@@ -732,13 +758,15 @@ void SW_Water_Flow(void) {
 	// soil_temperature function computes the soil temp for each layer and stores it in lyrsTemp
 	// doesn't affect SWC at all (yet), but needs it for the calculation, so therefore the temperature is the last calculation done
 	if (SW_Site.use_soil_temp) {
+		SW_TIMER_START(eSW_TimSoilTemp);
 		soil_temperature(w->now.temp_avg[Today], sw->pet, sw->aet, x, lyrSWCBulk,
-			lyrSWCBulk_Saturated, lyrbDensity, lyrWidths, lyroldsTemp, lyrsTemp, surfaceTemp,
+			SW_Site.swcBulk_saturated, SW_Site.soilBulk_density, SW_Site.width, lyroldsTemp, lyrsTemp, surfaceTemp,
 			SW_Site.n_layers, SW_Site.bmLimiter,
 			SW_Site.t1Param1, SW_Site.t1Param2, SW_Site.t1Param3, SW_Site.csParam1,
 			SW_Site.csParam2, SW_Site.shParam, sw->snowdepth, SW_Site.Tsoil_constant,
 			SW_Site.stDeltaX, SW_Site.stMaxDepth, SW_Site.stNRGR, sw->snowpack[Today],
-			&SW_Soilwat.soiltempError);
+			SW_Site.stMethod, &SW_Soilwat.soiltempError);
+		SW_TIMER_STOP(eSW_TimSoilTemp);
 	}
 
 	/* Soil Temperature ends here */
@@ -766,40 +794,12 @@ static void records2arrays(void) {
 	 *       see also Site.c.
 	 */
 	LyrIndex i;
-	int k;
 
 	ForEachSoilLayer(i)
 	{
 		lyrSWCBulk[i] = SW_Soilwat.swcBulk[Today][i];
 		lyroldsTemp[i] = SW_Soilwat.sTemp[i];
 	}
-
-	if (SW_Model.doy == SW_Model.firstdoy) {
-		ForEachSoilLayer(i)
-		{
-			lyrSWCBulk_FieldCaps[i] = SW_Site.lyr[i]->swcBulk_fieldcap;
-			lyrWidths[i] = SW_Site.lyr[i]->width;
-			lyrSWCBulk_Wiltpts[i] = SW_Site.lyr[i]->swcBulk_wiltpt;
-			lyrSWCBulk_HalfWiltpts[i] = SW_Site.lyr[i]->swcBulk_wiltpt / 2.;
-			lyrSWCBulk_Mins[i] = SW_Site.lyr[i]->swcBulk_min;
-			lyrImpermeability[i] = SW_Site.lyr[i]->impermeability;
-			lyrSWCBulk_Saturated[i] = SW_Site.lyr[i]->swcBulk_saturated;
-			lyrbDensity[i] = SW_Site.lyr[i]->soilBulk_density;
-
-			ForEachVegType(k)
-			{
-				lyrTrRegions[k][i] = SW_Site.lyr[i]->my_transp_rgn[k];
-				lyrSWCBulk_atSWPcrit[k][i] = SW_Site.lyr[i]->swcBulk_atSWPcrit[k];
-				lyrTranspCo[k][i] = SW_Site.lyr[i]->transp_coeff[k];
-			}
-		}
-
-		ForEachEvapLayer(i) {
-			lyrEvapCo[i] = SW_Site.lyr[i]->evap_coeff;
-		}
-
-	} /* end firsttime stuff */
-
 }
 
 static void arrays2records(void) {
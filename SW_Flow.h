@@ -1,13 +1,14 @@
 #ifndef SW_FLOW_H
 #define SW_FLOW_H
 
+#include "SW_Control.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void SW_FLW_init_run(void);
-void SW_Water_Flow(void);
+void SW_Water_Flow(SW_RUN *run);
 
 
 #ifdef __cplusplus
@@ -79,6 +79,10 @@
 02/08/2016 (CMA & CTD) In the function surface_temperature_under_snow(), used Parton's Eq. 5 & 6 from 1998 paper instead of koren paper
 								 Adjusted function calls to surface_temperature_under_snow to account for the new parameters
 03/01/2016 (CTD) Added error check for Rsoilwat called tempError()
+10/18/2026	hydraulic_redistribution(): sparse over eligible layer pairs; soil water
+	potentials are passed in (and updated) by the caller
+10/18/2026	soil water potentials of the current soil water content are obtained
+	from the cache of SW_SWC_swp()
 */
 /********************************************************/
 /********************************************************/
@@ -101,27 +105,27 @@
 
 
 #include "SW_Model.h"
-extern SW_MODEL SW_Model;
+extern SW_TLS SW_MODEL SW_Model;
 
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
 
-ST_RGR_VALUES stValues; //keeps track of soil_temperature values
+SW_TLS ST_RGR_VALUES stValues; //keeps track of soil_temperature values
 
-extern SW_SITE SW_Site;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_CARBON SW_Carbon;
-unsigned int soil_temp_init;   // simply keeps track of whether or not the values for the soil_temperature function have been initialized.  0 for no, 1 for yes.
-unsigned int fusion_pool_init;   // simply keeps track of whether or not the values for the soil fusion (thawing/freezing) section of the soil_temperature function have been initialized.  0 for no, 1 for yes.
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_CARBON SW_Carbon;
+SW_TLS unsigned int soil_temp_init;   // simply keeps track of whether or not the values for the soil_temperature function have been initialized.  0 for no, 1 for yes.
+SW_TLS unsigned int fusion_pool_init;   // simply keeps track of whether or not the values for the soil fusion (thawing/freezing) section of the soil_temperature function have been initialized.  0 for no, 1 for yes.
 
 /* *************************************************** */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
 
-Bool do_once_at_soiltempError;
+SW_TLS Bool do_once_at_soiltempError;
 // last successful time step in seconds; start out with 1 day
-double delta_time;
+SW_TLS double delta_time;
 
 
 /* *************************************************** */
@@ -374,7 +378,7 @@ void transp_weighted_avg(double *swp_avg, unsigned int n_tr_rgns, unsigned int n
 
 		for (i = 0; i < n_layers; i++) {
 			if (tr_regions[i] == r) {
-				swp += tr_coeff[i] * SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swc[i], i);
+				swp += tr_coeff[i] * SW_SWC_swp(swc[i], i);
 				sumco += tr_coeff[i];
 			}
 		}
@@ -486,7 +490,7 @@ void pot_soil_evap(double *bserate, unsigned int nelyrs, double ecoeff[], double
 	  }
 		x = width[i] * ecoeff[i];
 		sumwidth += x;
-		avswp += x * SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swc[i], i);
+		avswp += x * SW_SWC_swp(swc[i], i);
 	}
 
   // Note: avswp = 0 if swc = 0 because that is the return value of SW_SWCbulk2SWPmatric
@@ -546,7 +550,7 @@ void pot_soil_evap_bs(double *bserate, unsigned int nelyrs, double ecoeff[], dou
 	for (i = 0; i < nelyrs; i++) {
 		x = width[i] * ecoeff[i];
 		sumwidth += x;
-		avswp += x * SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swc[i], i);
+		avswp += x * SW_SWC_swp(swc[i], i);
 	}
 
 	avswp /= sumwidth;
@@ -751,7 +755,7 @@ void remove_from_soil(double swc[], double qty[], double *aet, unsigned int nlyr
 	ST_RGR_VALUES *st = &stValues;
 
 	for (i = 0; i < nlyrs; i++) {
-		swpfrac[i] = coeff[i] / SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swc[i], i);
+		swpfrac[i] = coeff[i] / SW_SWC_swp(swc[i], i);
 		sumswp += swpfrac[i];
 	}
 
@@ -875,8 +879,15 @@ void infiltrate_water_low(double swc[], double drain[], double *drainout, unsign
 
 Based on equations from Ryel 2002. @cite Ryel2002
 
+Only pairs of unfrozen layers below the top layer where at least one layer
+is wetter than its wilting point exchange water; the function returns
+early if there is no such pair. The antisymmetric matrix of the exchanges
+is represented by its upper triangle among those layers.
+
 @param swc Soilwater content in each layer after drainage (m<SUP>3</SUP> H<SUB>2</SUB>O).
+@param swp Soil water potential (-bar) of `swc` in each layer.
 @param swcwp Soil water content water potential (-bar).
+@param swpwp Soil water potential (-bar) of `swcwp` in each layer.
 @param lyrRootCo Fraction of active roots per layer.
 @param hydred Hydraulic redistribtion for each soil water layer (cm/day/layer).
 @param nlyrs Number of soil layers.
@@ -888,84 +899,119 @@ Based on equations from Ryel 2002. @cite Ryel2002
 
 @sideeffect
   - swc Updated soilwater content in each layer after drainage (m<SUP>3</SUP> H<SUB>2</SUB>O).
+  - swp Updated soil water potential of layers whose `swc` changed so that
+    the values can be passed to the call for the next vegetation type.
   - hydred Hydraulic redistribtion for each soil water layer (cm/day/layer).
 
 */
 
-void hydraulic_redistribution(double swc[], double swcwp[], double lyrRootCo[], double hydred[],
-    unsigned int nlyrs, double maxCondroot, double swp50, double shapeCond, double scale) {
+void hydraulic_redistribution(double swc[], double swp[], double swcwp[],
+    double swpwp[], double lyrRootCo[], double hydred[], unsigned int nlyrs,
+    double maxCondroot, double swp50, double shapeCond, double scale) {
 	/**********************************************************************
 	 HISTORY:
 	 10/19/2010 (drs)
 	 11/13/2010 (drs) limited water extraction for hydred to swp above wilting point
 	 03/23/2012 (drs) excluded hydraulic redistribution from top soil layer (assuming that this layer is <= 5 cm deep)
+	 10/18/2026 only unfrozen layers (below the top layer) with at least one
+	   wet partner layer are visited; upper triangle of hydredmat only;
+	   swp and swpwp are provided by the caller
 	 **********************************************************************/
 
-	unsigned int i, j;
-	double swp[MAX_LAYERS] = {0}, swpwp[MAX_LAYERS] = {0}, relCondroot[MAX_LAYERS] = {0}, hydredmat[MAX_LAYERS][MAX_LAYERS] = {{0}};
-  double Rx, swa, hydred_sum, x;
+	unsigned int a, b, i, j, n_act = 0;
+	unsigned int act[MAX_LAYERS]; /* unfrozen layers below the top layer */
+	Bool wet[MAX_LAYERS], any_wet = swFALSE;
+	double relCondroot[MAX_LAYERS], hydredmat[MAX_LAYERS][MAX_LAYERS];
+	double Rx, swa, hydred_sum, x;
 
 	ST_RGR_VALUES *st = &stValues;
 
 	for (i = 0; i < nlyrs; i++) {
-		swp[i] = SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swc[i], i);
-		relCondroot[i] = fmin( 1., fmax(0., 1./(1. + powe(swp[i]/swp50, shapeCond) ) ) );
-		swpwp[i] = SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel, swcwp[i], i);
-
-		hydredmat[0][i] = hydredmat[i][0] = 0.; /* no hydred in top layer */
+		hydred[i] = 0.;
 	}
 
+	/* no hydred in top layer */
 	for (i = 1; i < nlyrs; i++) {
-		hydredmat[i][i] = 0.; /* init */
+		if (st->lyrFrozen[i] == swFALSE) {
+			/* hydred occurs only if at least one soil layer's swp is above
+			wilting point and both soil layers are not frozen */
+			wet[n_act] = (Bool) LT(swp[i], swpwp[i]);
+			any_wet = (Bool) (any_wet || wet[n_act]);
+			act[n_act++] = i;
+		}
+	}
+
+	if (n_act < 2 || !any_wet) {
+		return;
+	}
 
-		for (j = i + 1; j < nlyrs; j++) {
+	for (a = 0; a < n_act; a++) {
+		i = act[a];
+		relCondroot[a] = fmin( 1., fmax(0., 1./(1. + powe(swp[i]/swp50, shapeCond) ) ) );
+	}
 
-			if ((LT(swp[i], swpwp[i]) || LT(swp[j], swpwp[j])) &&
-				(st->lyrFrozen[i] == swFALSE) && (st->lyrFrozen[j] == swFALSE)) {
-				/* hydred occurs only if at least one soil layer's swp is above wilting point
-				and both soil layers are not frozen */
+	/* hydredmat[a][b] for a < b; hydredmat[b][a] is -hydredmat[a][b] */
+	for (a = 0; a < n_act; a++) {
+		i = act[a];
 
+		for (b = a + 1; b < n_act; b++) {
+			j = act[b];
+
+			if (wet[a] || wet[b]) {
 				if (GT(swp[i], swp[j])) {
 					Rx = lyrRootCo[j]; // layer j has more water than i
 				} else {
 					Rx = lyrRootCo[i];
 				}
 
-				hydredmat[i][j] = maxCondroot * 10. / 24. * (swp[j] - swp[i]) *
-					fmax(relCondroot[i], relCondroot[j]) * (lyrRootCo[i] * lyrRootCo[j] / (1. - Rx)); /* assuming a 10-hour night */
-				hydredmat[j][i] = -hydredmat[i][j];
+				hydredmat[a][b] = maxCondroot * 10. / 24. * (swp[j] - swp[i]) *
+					fmax(relCondroot[a], relCondroot[b]) * (lyrRootCo[i] * lyrRootCo[j] / (1. - Rx)); /* assuming a 10-hour night */
 			} else {
-				hydredmat[i][j] = hydredmat[j][i] = 0.;
+				hydredmat[a][b] = 0.;
 			}
 		}
 	}
 
-	for (i = 0; i < nlyrs; i++) { /* total hydred from layer i cannot extract more than its swa */
+	for (a = 0; a < n_act; a++) { /* total hydred from layer i cannot extract more than its swa */
+		i = act[a];
+
 		hydred_sum = 0.;
-		for (j = 0; j < nlyrs; j++) {
-			hydred_sum += hydredmat[i][j];
+		for (b = 0; b < a; b++) {
+			hydred_sum += -hydredmat[b][a];
+		}
+		for (b = a + 1; b < n_act; b++) {
+			hydred_sum += hydredmat[a][b];
 		}
 
 		swa = fmax( 0., swc[i] - swcwp[i] );
 		if (LT(hydred_sum, 0.) && GT( -hydred_sum, swa)) {
+			/* scales row and column of layer i */
 			x = swa / -hydred_sum;
-			for (j = 0; j < nlyrs; j++) {
-				hydredmat[i][j] *= x;
-				hydredmat[j][i] *= x;
+			for (b = 0; b < a; b++) {
+				hydredmat[b][a] *= x;
+			}
+			for (b = a + 1; b < n_act; b++) {
+				hydredmat[a][b] *= x;
 			}
 		}
 	}
 
-	hydred[0] = 0.; /* no hydred in top layer */
+	for (a = 0; a < n_act; a++) {
+		i = act[a];
 
-	for (i = 1; i < nlyrs; i++) {
-		hydred[i] = 0.; //init
-		for (j = 1; j < nlyrs; j++) {
-			hydred[i] += hydredmat[i][j];
+		for (b = 0; b < a; b++) {
+			hydred[i] += -hydredmat[b][a];
+		}
+		for (b = a + 1; b < n_act; b++) {
+			hydred[i] += hydredmat[a][b];
 		}
 
 		hydred[i] *= scale;
 		swc[i] += hydred[i];
+
+		if (hydred[i] != 0.) {
+			swp[i] = SW_SWC_swp(swc[i], i);
+		}
 	}
 }
 
@@ -1736,6 +1782,122 @@ void soil_temperature_today(double *ptr_dTime, double deltaX, double sT1, double
 
 }
 
+
+/**
+@brief Calculate today's soil temperature for each layer with an implicit
+Crank-Nicolson scheme.
+
+This is an alternative to `soil_temperature_today()`: it discretizes the same
+equation (@cite Parton1978, eq. 2.21) but weights the spatial differences
+of yesterday and today. The scheme is unconditionally stable and thus takes
+one time step per day independent of `deltaX`; today's temperature profile is
+the solution of a tridiagonal system of equations.
+
+The weight of today is 1/2 (Crank-Nicolson) where
+`parts = dTime * cs / (sh * rho * deltaX^2) <= 1`; in layers with larger
+`parts`, the weight is increased to `1 - 1 / (2 * parts)` which is
+the smallest weight for which the solution does not oscillate and
+stays within the range of yesterday's values and the boundary conditions.
+
+The surface temperature `sT1` and the constant temperature `sTconst` are the
+boundary conditions for the entire day (as for `soil_temperature_today()`).
+
+@param deltaX The depth increment for the soil temperature (regression) calculations (cm).
+@param sT1 The soil surface temperature as upper boundary condition (&deg;C).
+@param sTconst The soil temperature at a soil depth where it stays constant as
+		lower boundary condition (&deg;C).
+@param nRgr The number of regressions (1 extra value is needed for the sTempR and oldsTempR for the last layer).
+@param sTempR An array of today's (regression)-layer soil temperature values (&deg;C).
+@param oldsTempR An array of yesterday's (regression)-layer soil temperature value (&deg;C).
+@param vwcR An array of temperature-layer VWC values (cm/layer).
+@param wpR An array of temperature-layer wilting point values (cm/layer).
+@param fcR An array of temperature-layer field capacity values (cm/layer).
+@param bDensityR temperature-layer bulk density of the whole soil
+  (g/cm<SUP>3</SUP>).
+@param csParam1 A constant for the soil thermal conductivity equation.
+@param csParam2 A constant for the soil thermal conductivity equation.
+@param shParam A constant for specific heat capacity equation.
+@param *ptr_stError A boolean indicating whether there was an error.
+
+@sideeffect
+  - Updated soil temperature values in array of sTempR.
+  - Updated status of soil temperature error in *ptr_stError.
+*/
+
+void soil_temperature_today_implicit(double deltaX, double sT1, double sTconst,
+	int nRgr, double sTempR[], double oldsTempR[], double vwcR[], double wpR[], double fcR[],
+	double bDensityR[], double csParam1, double csParam2, double shParam, Bool *ptr_stError) {
+
+	int i, k;
+	double pe, cs, sh, part1, parts, theta, rhs, w;
+	double lower[MAX_ST_RGR], diag[MAX_ST_RGR], upper[MAX_ST_RGR], d[MAX_ST_RGR];
+
+	sTempR[0] = sT1; //upper boundary condition; index 0 indicates surface and not first layer
+	sTempR[nRgr + 1] = sTconst; // lower boundary condition; assuming that lowest layer is the depth of constant soil temperature
+	*ptr_stError = swFALSE;
+
+	if (nRgr < 1) {
+		return;
+	}
+
+	part1 = SEC_PER_DAY / squared(deltaX);
+
+	/* Set up tridiagonal system for i = 1, ..., nRgr:
+			x[i; t+1] - theta * parts * (x[i-1; t+1] - 2 * x[i; t+1] + x[i+1; t+1]) =
+				= x[i; t] + (1 - theta) * parts * (x[i-1; t] - 2 * x[i; t] + x[i+1; t])
+		 with known boundary values x[0] = sT1 and x[nRgr + 1] = sTconst
+	*/
+	for (i = 1; i < nRgr + 1; i++) {
+		k = i - 1;
+		pe = (vwcR[k] - wpR[k]) / (fcR[k] - wpR[k]); // the units are volumetric!
+		cs = csParam1 + (pe * csParam2); // Parton (1978) eq. 2.22: soil thermal conductivity
+		sh = vwcR[k] + shParam * (1. - vwcR[k]); // Parton (1978) eq. 2.22: specific heat capacity
+		parts = part1 * cs / (sh * bDensityR[k]);
+
+		// coefficients of yesterday are non-negative if (1 - theta) * parts <= 1/2
+		theta = fmax(0.5, 1. - 0.5 / parts);
+
+		lower[i] = -theta * parts;
+		diag[i] = 1. + 2. * theta * parts;
+		upper[i] = -theta * parts;
+
+		rhs = oldsTempR[i] + (1. - theta) * parts * (
+			(i == 1 ? sT1 : oldsTempR[i - 1]) - 2. * oldsTempR[i] +
+			(i == nRgr ? sTconst : oldsTempR[i + 1]));
+
+		// move known boundary values to the right-hand side
+		if (i == 1) {
+			rhs += theta * parts * sT1;
+		}
+		if (i == nRgr) {
+			rhs += theta * parts * sTconst;
+		}
+
+		d[i] = rhs;
+	}
+
+	/* Thomas algorithm: the matrix is strictly diagonally dominant because
+		parts > 0; thus, elimination without pivoting is stable */
+	for (i = 2; i < nRgr + 1; i++) {
+		w = lower[i] / diag[i - 1];
+		diag[i] -= w * upper[i - 1];
+		d[i] -= w * d[i - 1];
+	}
+
+	sTempR[nRgr] = d[nRgr] / diag[nRgr];
+	for (i = nRgr - 1; i >= 1; i--) {
+		sTempR[i] = (d[i] - upper[i] * sTempR[i + 1]) / diag[i];
+	}
+
+	// Sensibility check to cut-short exploding soil temperature values
+	for (i = 1; i < nRgr + 1; i++) {
+		if (GT(sTempR[i], 100.) || LT(sTempR[i], -100.) || !isfinite(sTempR[i])) {
+			*ptr_stError = swTRUE;
+			break;
+		}
+	}
+}
+
 /**********************************************************************
  PURPOSE: Calculate soil temperature for each layer
 	* based on Parton 1978, ch. 2.2.2 Temperature-profile Submodel
@@ -1832,6 +1994,9 @@ Equations based on Eitzinger, Parton, and Hartman 2000. @cite Eitzinger2000, Par
 @param theMaxDepth Lower bound of the equation (default is 180 cm from Parton's equation @cite Parton1984).
 @param nRgr Number of regressions (1 extra value is needed for the sTempR and oldsTempR for the last layer.
 @param snow Snow-water-equivalent of the area (cm).
+@param stMethod Numerical scheme: `SW_ST_EXPLICIT` (adaptive sub-daily time
+  step, see `soil_temperature_today()`) or `SW_ST_IMPLICIT` (Crank-Nicolson,
+  see `soil_temperature_today_implicit()`).
 @param *ptr_stError Boolean indicating whether there was an error.
 
 @sideeffect *ptr_stError Updated boolean indicating whether there was an error.
@@ -1844,7 +2009,8 @@ void soil_temperature(double airTemp, double pet, double aet, double biomass,
 	double sTemp[], double surfaceTemp[2], unsigned int nlyrs,
 	double bmLimiter, double t1Param1, double t1Param2, double t1Param3, double csParam1,
 	double csParam2, double shParam, double snowdepth, double sTconst, double deltaX,
-	double theMaxDepth, unsigned int nRgr, double snow, Bool *ptr_stError) {
+	double theMaxDepth, unsigned int nRgr, double snow, unsigned int stMethod,
+	Bool *ptr_stError) {
 
 	unsigned int i, sFadjusted_sTemp;
   #ifdef SWDEBUG
@@ -1964,15 +2130,27 @@ void soil_temperature(double airTemp, double pet, double aet, double biomass,
 	#endif
 
 	// calculate the new soil temperature for each layer
-	soil_temperature_today(&delta_time, deltaX, T1, sTconst, nRgr, sTempR, st->oldsTempR,
-		vwcR, st->wpR, st->fcR, st->bDensityR, csParam1, csParam2, shParam, ptr_stError);
+	if (stMethod == SW_ST_IMPLICIT) {
+		soil_temperature_today_implicit(deltaX, T1, sTconst, nRgr, sTempR, st->oldsTempR,
+			vwcR, st->wpR, st->fcR, st->bDensityR, csParam1, csParam2, shParam, ptr_stError);
+
+		if (*ptr_stError) {
+			LogError(logfp, LOGWARN, "SOILWAT2 ERROR in soil temperature module: "
+				"implicit solution is outside of realistic values; "
+				"soil temperature is being turned off\n");
+		}
 
-	// question: should we ever reset delta_time to SEC_PER_DAY?
+	} else {
+		soil_temperature_today(&delta_time, deltaX, T1, sTconst, nRgr, sTempR, st->oldsTempR,
+			vwcR, st->wpR, st->fcR, st->bDensityR, csParam1, csParam2, shParam, ptr_stError);
 
-	if (*ptr_stError) {
-		LogError(logfp, LOGWARN, "SOILWAT2 ERROR in soil temperature module: "
-			"stability criterion failed despite reduced time step = %f seconds; "
-			"soil temperature is being turned off\n", delta_time);
+		// question: should we ever reset delta_time to SEC_PER_DAY?
+
+		if (*ptr_stError) {
+			LogError(logfp, LOGWARN, "SOILWAT2 ERROR in soil temperature module: "
+				"stability criterion failed despite reduced time step = %f seconds; "
+				"soil temperature is being turned off\n", delta_time);
+		}
 	}
 
 	#ifdef SWDEBUG
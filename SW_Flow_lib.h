@@ -30,6 +30,7 @@
  01/31/2013	(clk) added new function, pot_soil_evap_bs()
  03/07/2013	(clk) add new array, lyrFrozen to keep track of whether a certain soil layer is frozen. 1 = frozen, 0 = not frozen.
  07/09/2013	(clk) added two new functions: forb_intercepted_water and forb_EsT_partitioning
+ 10/18/2026	added soil water potentials swp and swpwp to hydraulic_redistribution()
  */
 /********************************************************/
 /********************************************************/
@@ -108,8 +109,9 @@ void remove_from_soil(double swc[], double qty[], double *aet, unsigned int nlyr
 void infiltrate_water_low(double swc[], double drain[], double *drainout, unsigned int nlyrs, double sdrainpar, double sdraindpth, double swcfc[], double width[],
 		double swcmin[], double swcsat[], double impermeability[], double *standingWater);
 
-void hydraulic_redistribution(double swc[], double swcwp[], double lyrRootCo[], double hydred[], unsigned int nlyrs, double maxCondroot, double swp50, double shapeCond,
-		double scale);
+void hydraulic_redistribution(double swc[], double swp[], double swcwp[],
+		double swpwp[], double lyrRootCo[], double hydred[], unsigned int nlyrs,
+		double maxCondroot, double swp50, double shapeCond, double scale);
 
 void soil_temperature(double airTemp,
 		              double pet,
@@ -136,6 +138,7 @@ void soil_temperature(double airTemp,
 					  double theMaxDepth,
 					  unsigned int nRgr,
 						double snow,
+						unsigned int stMethod,
 						Bool *ptr_stError);
 
 void lyrTemp_to_lyrSoil_temperature(double cor[MAX_ST_RGR][MAX_LAYERS + 1],
@@ -187,6 +190,10 @@ void soil_temperature_today(double *ptr_dTime, double deltaX, double sT1, double
 	int nRgr, double sTempR[], double oldsTempR[], double vwcR[], double wpR[], double fcR[],
 	double bDensityR[], double csParam1, double csParam2, double shParam, Bool *ptr_stError);
 
+void soil_temperature_today_implicit(double deltaX, double sT1, double sTconst,
+	int nRgr, double sTempR[], double oldsTempR[], double vwcR[], double wpR[], double fcR[],
+	double bDensityR[], double csParam1, double csParam2, double shParam, Bool *ptr_stError);
+
 
 #ifdef __cplusplus
 }
@@ -14,7 +14,17 @@
 /* --------------------------------------------------- */
 
 #include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef SWTHREADS
+	#include <pthread.h>
+#endif
+
 #include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
 #include "SW_Defines.h"
 
 #include "SW_Flow_lib_PET.h"
@@ -30,11 +40,43 @@
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
 
-static double
-  memoized_G_o[366][2],
-  msun_angles[366][7],
-  memoized_int_cos_theta[366][2],
-  memoized_int_sin_beta[366][2];
+/** Element of the list of solar geometry tables */
+typedef struct SW_SOLARGEOM_NODE {
+  SW_SOLARGEOM g;
+  struct SW_SOLARGEOM_NODE
+    *next, /**< Next less recently used table */
+    *prev, /**< Next more recently used table */
+    *hnext; /**< Next table of the same hash bucket */
+  unsigned int hash; /**< Hash bucket of the location */
+  int n_refs; /**< Number of threads that currently use the table */
+} SW_SOLARGEOM_NODE;
+
+/* List of solar geometry tables from the most (`_solargeom`) to the least
+   (`_solargeom_last`) recently used table, their hash buckets, and their
+   number; shared among threads and runs */
+static SW_SOLARGEOM_NODE
+  *_solargeom = NULL,
+  *_solargeom_last = NULL,
+  *_solargeom_bucket[SW_SOLARGEOM_NBUCKETS];
+static unsigned int _solargeom_n = 0;
+
+/* Solar geometry table that is used by this thread (holds a reference) */
+static SW_TLS SW_SOLARGEOM_NODE *_solargeom_current = NULL;
+
+#ifdef SWTHREADS
+static pthread_mutex_t _solargeom_lock = PTHREAD_MUTEX_INITIALIZER;
+  #define _lock_solargeom() pthread_mutex_lock(&_solargeom_lock)
+  #define _unlock_solargeom() pthread_mutex_unlock(&_solargeom_lock)
+#else
+  #define _lock_solargeom()
+  #define _unlock_solargeom()
+#endif
+
+#ifdef sun_hourangles_Duffie2013_2205
+  #define SW_SOLARGEOM_METHOD 1
+#else
+  #define SW_SOLARGEOM_METHOD 0
+#endif
 
 
 /** @brief Solar constant
@@ -52,6 +94,11 @@ static const double G_sc = 118.1088;
   ( GT( (slope), 0. ) && !missing( (aspect) ) )
 
 
+static void _sun_hourangles(double lat, double slope, double aspect,
+  double msun_angles[][7], double memoized_int_cos_theta[][2],
+  double memoized_int_sin_beta[][2]);
+
+
 
 /* *************************************************** */
 /*                Functions                            */
@@ -59,20 +106,26 @@ static const double G_sc = 118.1088;
 
 
 /** @brief Initialize global and memoized variables
+
+  Solar geometry tables are kept across runs, see \ref sun_hourangles.
 */
 void SW_PET_init_run(void) {
-  int k1, k2;
+  SW_PET_deconstruct();
+}
 
-  for (k1 = 0; k1 < 366; k1++)
-  {
-    memoized_G_o[k1][0] = memoized_G_o[k1][1] = SW_MISSING;
-    memoized_int_cos_theta[k1][0] = memoized_int_cos_theta[k1][1] = 0.;
-    memoized_int_sin_beta[k1][0] = memoized_int_sin_beta[k1][1] = 0.;
 
-    for (k2 = 0; k2 < 7; k2++)
-    {
-      msun_angles[k1][k2] = SW_MISSING;
-    }
+/** @brief Release the solar geometry table that is used by this thread
+
+  The table may then be evicted from the tables that are kept across runs,
+  see \ref sun_hourangles.
+*/
+void SW_PET_deconstruct(void) {
+  if (!isnull(_solargeom_current)) {
+    _lock_solargeom();
+    _solargeom_current->n_refs--;
+    _unlock_solargeom();
+
+    _solargeom_current = NULL;
   }
 }
 
@@ -156,6 +209,235 @@ double sunset_hourangle(double lat, double declin)
   return acos(fmax(-1.0, fmin(1.0, -tan(lat) * tan(declin))));
 }
 
+/** @brief Check whether a solar geometry table belongs to a location
+
+  Missing values may be `NaN` which are treated as equal.
+*/
+static Bool _is_solargeom(const SW_SOLARGEOM *g, double lat, double slope,
+  double aspect)
+{
+  #define _same(x, y) ((x) == (y) || (isnan(x) && isnan(y)))
+
+  return (Bool) (
+    _same(g->lat, lat) && _same(g->slope, slope) && _same(g->aspect, aspect)
+  );
+
+  #undef _same
+}
+
+
+/** @brief Hash bucket of a location
+
+  Values that `_is_solargeom()` treats as equal (`NaN`s, `0` and `-0`)
+  fall into the same bucket.
+*/
+static unsigned int _hash_solargeom(double lat, double slope, double aspect)
+{
+  double x[3] = {lat, slope, aspect};
+  uint64_t u, h = 14695981039346656037ULL; // FNV-1a offset basis
+  unsigned int k;
+
+  for (k = 0; k < 3; k++) {
+    if (isnan(x[k])) {
+      u = 0x7ff8000000000000ULL;
+    } else {
+      x[k] = (x[k] == 0.) ? 0. : x[k];
+      memcpy(&u, &x[k], sizeof u);
+    }
+
+    h = (h ^ u) * 1099511628211ULL; // FNV prime
+  }
+
+  return (unsigned int) (h ^ (h >> 32)) & (SW_SOLARGEOM_NBUCKETS - 1);
+}
+
+
+/** @brief Look up the table of a location; the caller holds the lock
+*/
+static SW_SOLARGEOM_NODE *_lookup_solargeom(double lat, double slope,
+  double aspect, unsigned int hash)
+{
+  SW_SOLARGEOM_NODE *n;
+
+  for (n = _solargeom_bucket[hash]; !isnull(n); n = n->hnext) {
+    if (_is_solargeom(&n->g, lat, slope, aspect)) {
+      break;
+    }
+  }
+
+  return n;
+}
+
+
+/** @brief Remove a table from the list; the caller holds the lock
+
+  @param n The table.
+  @param bucket Remove the table also from its hash bucket.
+*/
+static void _unlink_solargeom(SW_SOLARGEOM_NODE *n, Bool bucket)
+{
+  SW_SOLARGEOM_NODE **p;
+
+  if (isnull(n->prev)) {
+    _solargeom = n->next;
+  } else {
+    n->prev->next = n->next;
+  }
+
+  if (isnull(n->next)) {
+    _solargeom_last = n->prev;
+  } else {
+    n->next->prev = n->prev;
+  }
+
+  if (bucket) {
+    for (p = &_solargeom_bucket[n->hash]; *p != n; p = &(*p)->hnext);
+    *p = n->hnext;
+    _solargeom_n--;
+  }
+}
+
+
+/** @brief Add a table to the list; the caller holds the lock
+
+  @param n The table.
+  @param bucket Add the table also to its hash bucket (a new table).
+  @param first Add the table as the most instead of the least recently used.
+*/
+static void _push_solargeom(SW_SOLARGEOM_NODE *n, Bool bucket, Bool first)
+{
+  if (first) {
+    n->prev = NULL;
+    n->next = _solargeom;
+    if (isnull(_solargeom)) {
+      _solargeom_last = n;
+    } else {
+      _solargeom->prev = n;
+    }
+    _solargeom = n;
+
+  } else {
+    n->next = NULL;
+    n->prev = _solargeom_last;
+    if (isnull(_solargeom_last)) {
+      _solargeom = n;
+    } else {
+      _solargeom_last->next = n;
+    }
+    _solargeom_last = n;
+  }
+
+  if (bucket) {
+    n->hnext = _solargeom_bucket[n->hash];
+    _solargeom_bucket[n->hash] = n;
+    _solargeom_n++;
+  }
+}
+
+
+/** @brief Release the least recently used tables that are not in use
+  while there are more than `SW_SOLARGEOM_MAXTABLES`; the caller holds
+  the lock
+*/
+static void _evict_solargeom(void)
+{
+  SW_SOLARGEOM_NODE *n = _solargeom_last, *p;
+
+  while (_solargeom_n > SW_SOLARGEOM_MAXTABLES && !isnull(n)) {
+    p = n->prev;
+    if (n->n_refs <= 0) {
+      _unlink_solargeom(n, swTRUE);
+      Mem_Free(n);
+    }
+    n = p;
+  }
+}
+
+
+/** @brief Make a table the one that this thread uses; the caller holds
+  the lock
+*/
+static void _use_solargeom(SW_SOLARGEOM_NODE *n)
+{
+  if (!isnull(_solargeom_current)) {
+    _solargeom_current->n_refs--;
+  }
+  n->n_refs++;
+  _solargeom_current = n;
+
+  if (n != _solargeom) {
+    _unlink_solargeom(n, swFALSE);
+    _push_solargeom(n, swFALSE, swTRUE);
+  }
+}
+
+
+/** @brief Solar geometry table of a location
+
+  Looks up the table of latitude, slope, and aspect among the tables of
+  previous calls; calculates and adds a new table if there is none.
+  A new table is calculated without holding the lock so that other threads
+  are not blocked; the least recently used tables are released once more
+  than `SW_SOLARGEOM_MAXTABLES` are kept.
+*/
+static const SW_SOLARGEOM *_get_solargeom(double lat, double slope,
+  double aspect)
+{
+  SW_SOLARGEOM_NODE *n, *m;
+  unsigned int hash;
+  MemArena *arena;
+
+  if (
+    !isnull(_solargeom_current) &&
+    _is_solargeom(&_solargeom_current->g, lat, slope, aspect)
+  ) {
+    return &_solargeom_current->g;
+  }
+
+  hash = _hash_solargeom(lat, slope, aspect);
+
+  _lock_solargeom();
+  n = _lookup_solargeom(lat, slope, aspect, hash);
+  if (!isnull(n)) {
+    _use_solargeom(n);
+  }
+  _unlock_solargeom();
+
+  if (isnull(n)) {
+    // tables are shared by all runs: bypass the run's arena (if any)
+    arena = Mem_ArenaUse(NULL);
+    m = (SW_SOLARGEOM_NODE *) Mem_Malloc(sizeof(SW_SOLARGEOM_NODE),
+      "_get_solargeom()");
+    Mem_ArenaUse(arena);
+    m->g.lat = lat;
+    m->g.slope = slope;
+    m->g.aspect = aspect;
+    m->hash = hash;
+    m->n_refs = 0;
+
+    _sun_hourangles(lat, slope, aspect, m->g.sun_angles, m->g.int_cos_theta,
+      m->g.int_sin_beta);
+
+    // another thread may have added the same table in the meantime
+    _lock_solargeom();
+    n = _lookup_solargeom(lat, slope, aspect, hash);
+    if (isnull(n)) {
+      _push_solargeom(m, swTRUE, swTRUE);
+      n = m;
+      m = NULL;
+    }
+    _use_solargeom(n);
+    _evict_solargeom();
+    _unlock_solargeom();
+
+    if (!isnull(m)) {
+      Mem_Free(m);
+    }
+  }
+
+  return &n->g;
+}
+
 
 /** @brief Integrals of solar incidence angle and solar altitude angle
 
@@ -171,10 +453,14 @@ double sunset_hourangle(double lat, double declin)
   if `sun_hourangles_Duffie2013_2205` is defined, e.g.,
   `CPPFLAGS=-Dsun_hourangles_Duffie2013_2205 make bin`
 
-  @note The function is memoized on `doy`.
-    The other arguments latitude, slope, and aspect are fixed
-    for any given SOILWAT2.
-    Call \ref SW_PET_init_run to initialize the memoization.
+  @note The function looks up values in a table of all days of year
+    which is calculated once for each combination of latitude, slope, and
+    aspect. Tables are kept across runs and shared among threads
+    until \ref SW_PET_solargeom_clear is called; they can be saved to and
+    loaded from disk, see \ref SW_PET_solargeom_write and
+    \ref SW_PET_solargeom_read. At most `SW_SOLARGEOM_MAXTABLES` tables
+    are kept (plus those in use); the least recently used tables are
+    released first.
 
   @note The 2nd elements of the return arrays
     `int_cos_theta` and `int_sin_beta` provide horizontal values
@@ -222,9 +508,43 @@ void sun_hourangles(unsigned int doy, double lat, double slope, double aspect,
     i,
     doy0 = doy - 1; // doy is base1
 
+  const SW_SOLARGEOM *g = _get_solargeom(lat, slope, aspect);
 
-  if (missing(msun_angles[doy0][0])) {
+  int_cos_theta[0] = g->int_cos_theta[doy0][0];
+  int_cos_theta[1] = g->int_cos_theta[doy0][1];
+  int_sin_beta[0] = g->int_sin_beta[doy0][0];
+  int_sin_beta[1] = g->int_sin_beta[doy0][1];
 
+  for (i = 0; i < 7; i++) {
+    sun_angles[i] = g->sun_angles[doy0][i];
+  }
+}
+
+
+
+/** @brief Calculate the solar geometry of all days of year at one location,
+  see \ref sun_hourangles
+*/
+static void _sun_hourangles(double lat, double slope, double aspect,
+  double msun_angles[][7], double memoized_int_cos_theta[][2],
+  double memoized_int_sin_beta[][2])
+{
+  unsigned int
+    i,
+    doy,
+    doy0;
+
+  for (doy0 = 0; doy0 < 366; doy0++) {
+    memoized_int_cos_theta[doy0][0] = memoized_int_cos_theta[doy0][1] = 0.;
+    memoized_int_sin_beta[doy0][0] = memoized_int_sin_beta[doy0][1] = 0.;
+
+    for (i = 0; i < 7; i++) {
+      msun_angles[doy0][i] = SW_MISSING;
+    }
+  }
+
+  for (doy0 = 0; doy0 < 366; doy0++) {
+    doy = doy0 + 1; // doy is base1
     // (drs) set tolerance to 1e-9 instead of 1e-3 to minimize "edge" effects
     static const double tol = 1e-9;
 
@@ -577,19 +897,169 @@ void sun_hourangles(unsigned int doy, double lat, double slope, double aspect,
       }
     }
   }
+}
 
-  // Grab memoized values
-  int_cos_theta[0] = memoized_int_cos_theta[doy0][0];
-  int_cos_theta[1] = memoized_int_cos_theta[doy0][1];
-  int_sin_beta[0] = memoized_int_sin_beta[doy0][0];
-  int_sin_beta[1] = memoized_int_sin_beta[doy0][1];
 
-  for (i = 0; i < 7; i++) {
-    sun_angles[i] = msun_angles[doy0][i];
+/** @brief Free all solar geometry tables, see \ref sun_hourangles
+
+  Call this routine only if no run is active, e.g., at the end of a program
+  (see `SW_CTL_clear_model()` with `full_reset`).
+*/
+void SW_PET_solargeom_clear(void)
+{
+  SW_SOLARGEOM_NODE *n;
+
+  _lock_solargeom();
+
+  while (!isnull(_solargeom)) {
+    n = _solargeom;
+    _solargeom = n->next;
+    Mem_Free(n);
+  }
+
+  _solargeom_last = NULL;
+  memset(_solargeom_bucket, 0, sizeof _solargeom_bucket);
+  _solargeom_n = 0;
+
+  _unlock_solargeom();
+
+  _solargeom_current = NULL;
+}
+
+
+/** @brief Number of solar geometry tables, see \ref sun_hourangles
+*/
+unsigned int SW_PET_solargeom_size(void)
+{
+  unsigned int k;
+
+  _lock_solargeom();
+  k = _solargeom_n;
+  _unlock_solargeom();
+
+  return k;
+}
+
+
+/** @brief Save all solar geometry tables to a binary file
+
+  The file can be loaded by later program runs with
+  \ref SW_PET_solargeom_read. Tables are saved from the most to the least
+  recently used table.
+
+  @param[in] fname Name of the file.
+*/
+void SW_PET_solargeom_write(const char *fname)
+{
+  SW_SOLARGEOM_HEADER h;
+  SW_SOLARGEOM_NODE *n;
+  FILE *f;
+  Bool ok;
+
+  memset(&h, 0, sizeof h);
+  strcpy(h.magic, SW_SOLARGEOM_MAGIC);
+  h.version = SW_SOLARGEOM_VERSION;
+  h.byteorder = SW_SOLARGEOM_BYTEORDER;
+  h.method = SW_SOLARGEOM_METHOD;
+  h.size_table = sizeof(SW_SOLARGEOM);
+
+  f = OpenFile(fname, "wb");
+
+  _lock_solargeom();
+
+  h.n_tables = _solargeom_n;
+  ok = (Bool) (fwrite(&h, sizeof h, 1, f) == 1);
+  for (n = _solargeom; ok && !isnull(n); n = n->next) {
+    ok = (Bool) (fwrite(&n->g, sizeof(SW_SOLARGEOM), 1, f) == 1);
+  }
+
+  _unlock_solargeom();
+
+  CloseFile(&f);
+
+  if (!ok) {
+    LogError(logfp, LOGFATAL, "Cannot write solar geometry to '%s'.", fname);
   }
 }
 
 
+/** @brief Load solar geometry tables from a binary file
+
+  Tables that are already present are not replaced. Loaded tables are less
+  recently used than present tables; tables beyond `SW_SOLARGEOM_MAXTABLES`
+  are not loaded.
+
+  @param[in] fname Name of a file written by \ref SW_PET_solargeom_write.
+
+  @return `swTRUE` if the file was loaded; `swFALSE` if the file does not exist
+    or was written by an incompatible program (with a warning).
+*/
+Bool SW_PET_solargeom_read(const char *fname)
+{
+  SW_SOLARGEOM_HEADER h;
+  SW_SOLARGEOM_NODE *n;
+  FILE *f;
+  uint32_t k;
+  Bool ok, full = swFALSE;
+  MemArena *arena;
+
+  if (!FileExists(fname)) {
+    return swFALSE;
+  }
+
+  f = OpenFile(fname, "rb");
+
+  ok = (Bool) (
+    fread(&h, sizeof h, 1, f) == 1 &&
+    strncmp(h.magic, SW_SOLARGEOM_MAGIC, sizeof h.magic) == 0 &&
+    h.version == SW_SOLARGEOM_VERSION &&
+    h.byteorder == SW_SOLARGEOM_BYTEORDER &&
+    h.method == SW_SOLARGEOM_METHOD &&
+    h.size_table == sizeof(SW_SOLARGEOM)
+  );
+
+  for (k = 0; ok && !full && k < h.n_tables; k++) {
+    // tables are shared by all runs: bypass the run's arena (if any)
+    arena = Mem_ArenaUse(NULL);
+    n = (SW_SOLARGEOM_NODE *) Mem_Malloc(sizeof(SW_SOLARGEOM_NODE),
+      "SW_PET_solargeom_read()");
+    Mem_ArenaUse(arena);
+
+    if (fread(&n->g, sizeof(SW_SOLARGEOM), 1, f) != 1) {
+      Mem_Free(n);
+      ok = swFALSE;
+      break;
+    }
+
+    n->hash = _hash_solargeom(n->g.lat, n->g.slope, n->g.aspect);
+    n->n_refs = 0;
+
+    _lock_solargeom();
+
+    if (isnull(_lookup_solargeom(n->g.lat, n->g.slope, n->g.aspect, n->hash))) {
+      _push_solargeom(n, swTRUE, swFALSE);
+      n = NULL;
+    }
+    full = (Bool) (_solargeom_n >= SW_SOLARGEOM_MAXTABLES);
+
+    _unlock_solargeom();
+
+    if (!isnull(n)) {
+      Mem_Free(n);
+    }
+  }
+
+  CloseFile(&f);
+
+  if (!ok) {
+    LogError(logfp, LOGWARN, "'%s' is not a compatible solar geometry file; "
+      "solar geometry is calculated instead.", fname);
+  }
+
+  return ok;
+}
+
+
 
 /** @brief Daily extraterrestrial solar irradiation
 
@@ -598,11 +1068,6 @@ void sun_hourangles(unsigned int doy, double lat, double slope, double aspect,
   The function corrects daily irradiation to the amount that would be received
   on a tilted surface on Earth in the absence of an atmosphere.
 
-  @note The function is memoized on `doy`.
-    The other argument `int_cos_theta` co-varies with `doy`
-    for any given SOILWAT2 run where latitude, slope, and aspect are fixed.
-    Call \ref SW_PET_init_run to initialize the memoization.
-
   @param[in] doy Day of year [1-365].
   @param[in] int_cos_theta Array of length 2 with
     daily integral during sunshine (one or two periods)
@@ -620,38 +1085,29 @@ void solar_radiation_extraterrestrial(unsigned int doy, double int_cos_theta[],
   double G_o[])
 {
 
-  unsigned int doy0 = doy - 1; // doy is base1
-
-  if (missing(memoized_G_o[doy0][0]))
-  {
-    int k;
-    double di2 = 1.;
+  int k;
+  double di2 = 1.;
 
-    // Calculate sun-earth distance effect
-    if (GT(int_cos_theta[0], 0.) || GT(int_cos_theta[1], 0.)) {
-      di2 = sun_earth_distance_squaredinverse(doy);
-    }
+  // Calculate sun-earth distance effect
+  if (GT(int_cos_theta[0], 0.) || GT(int_cos_theta[1], 0.)) {
+    di2 = sun_earth_distance_squaredinverse(doy);
+  }
 
-    for (k = 0; k < 2; k++)
-    {
-      // k = 0: horizontal surface; k == 1: tilted surface
+  for (k = 0; k < 2; k++)
+  {
+    // k = 0: horizontal surface; k == 1: tilted surface
 
-      // Check that we have sunshine
-      if (GT(int_cos_theta[k], 0.)) {
-        // Allen et al. 2006: eq. 35 (horizontal surface) and
-        // eqs 6 and 51 (tilted surface)
-        memoized_G_o[doy0][k] = G_sc * di2 * int_cos_theta[k];
+    // Check that we have sunshine
+    if (GT(int_cos_theta[k], 0.)) {
+      // Allen et al. 2006: eq. 35 (horizontal surface) and
+      // eqs 6 and 51 (tilted surface)
+      G_o[k] = G_sc * di2 * int_cos_theta[k];
 
-      } else {
-        // no radiation
-        memoized_G_o[doy0][k] = 0.;
-      }
+    } else {
+      // no radiation
+      G_o[k] = 0.;
     }
   }
-
-  // Grab memoized values
-  G_o[0] = memoized_G_o[doy0][0];
-  G_o[1] = memoized_G_o[doy0][1];
 }
 
 
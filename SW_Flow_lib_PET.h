@@ -11,17 +11,59 @@
 #ifndef SW_PET_H
 #define SW_PET_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 
+#define SW_SOLARGEOM_MAGIC "SW2SOLG" /**< Identifies a solar geometry file */
+#define SW_SOLARGEOM_VERSION 1 /**< Version of the file format */
+#define SW_SOLARGEOM_BYTEORDER 0x01020304 /**< Detects foreign byte order */
+#define SW_SOLARGEOM_MAXTABLES 1024 /**< Solar geometry tables that are kept
+  (about 32 kB each); least recently used tables are released first */
+#define SW_SOLARGEOM_NBUCKETS 256 /**< Hash buckets of the solar geometry
+  tables (a power of 2) */
+
+
+/** Solar geometry of all days of year at one location,
+    see `sun_hourangles()` */
+typedef struct {
+  double
+    lat, /**< Latitude [radians] */
+    slope, /**< Slope [radians] */
+    aspect, /**< Aspect [radians] */
+    sun_angles[366][7],
+    int_cos_theta[366][2],
+    int_sin_beta[366][2];
+} SW_SOLARGEOM;
+
+/** Header of a solar geometry file which is followed by `n_tables` x
+    `SW_SOLARGEOM` in native byte order */
+typedef struct {
+  char magic[8];
+  uint32_t
+    version,
+    byteorder,
+    method, /**< 0, Allen et al. 2006; 1, Duffie & Beckman 2013 */
+    size_table, /**< `sizeof(SW_SOLARGEOM)` of the writing platform */
+    n_tables;
+} SW_SOLARGEOM_HEADER;
+
+
 /* =================================================== */
 /* =================================================== */
 /*                Function Definitions                 */
 /* --------------------------------------------------- */
 
 void SW_PET_init_run(void);
+void SW_PET_deconstruct(void);
+
+void SW_PET_solargeom_clear(void);
+unsigned int SW_PET_solargeom_size(void);
+void SW_PET_solargeom_write(const char *fname);
+Bool SW_PET_solargeom_read(const char *fname);
 
 double sun_earth_distance_squaredinverse(unsigned int doy);
 double solar_declination(unsigned int doy);
@@ -7,6 +7,11 @@
  *
  06/24/2013	(rjm)	included "SW_Site.h" and "SW_Weather.h";
  added calls at end of main() to SW_SIT_clear_layers() and SW_WTH_clear_runavg_list() to free memory
+ 10/18/2026	added batch runs of many sites (option -b), see SW_Batch.c
+ 10/18/2026	added conversion of weather into a binary store (option -w), see SW_Weather_store.c
+ 10/18/2026	added report of phase timings if compiled with SW_TIMING, see SW_Timing.c
+ 10/18/2026	added ensemble runs that share a spin-up (options -b and -y), see SW_Batch.c
+ 10/18/2026	added realizations of the weather generator (options -n and -r), see SW_Batch.c
  */
 /********************************************************/
 /********************************************************/
@@ -30,11 +35,25 @@
 #include "SW_Site.h"
 #include "SW_Weather.h"
 #include "SW_Output.h"
+#ifdef SW_OUTBINARY
+#include "SW_Output_outbinary.h"
+#elif defined(SW_OUTMEMORY)
+#include "SW_Output_outmemory.h"
+#else
 #include "SW_Output_outtext.h"
+#endif
+#include "SW_Weather_store.h"
+#include "SW_Flow_lib_PET.h"
+#include "SW_Batch.h"
+#include "SW_Timing.h"
 #include "SW_Main_lib.c"
 
+extern SW_TLS SW_WEATHER SW_Weather;
+
 
 static void check_log(void);
+static void convert_weather(void);
+static void report_timing(void);
 
 
 static void check_log(void) {
@@ -51,6 +70,37 @@ static void check_log(void) {
 
 }
 
+/** @brief Convert the daily weather of the site into a weather store
+*/
+static void convert_weather(void) {
+	char *name = (char *) ".", *prefix;
+
+	SW_CTL_setup_model(NULL, _firstfile);
+	SW_CTL_read_inputs_from_disk(NULL);
+
+	prefix = SW_Weather.name_prefix;
+	SW_WTH_store_write(_storefile, 1, &name, &prefix,
+		SW_Weather.yr.first, SW_Weather.yr.last);
+
+	if (!QuietMode) {
+		swprintf("Converted weather (%u-%u) into %s\n",
+			SW_Weather.yr.first, SW_Weather.yr.last, _storefile);
+	}
+
+	SW_CTL_clear_model(NULL, swTRUE);
+}
+
+/** @brief Print wall time and call counts of the phases of all simulation
+  runs if compiled with `SW_TIMING`
+*/
+static void report_timing(void) {
+	#ifdef SW_TIMING
+	if (!QuietMode) {
+		SW_TIM_print(stdout);
+	}
+	#endif
+}
+
 /************  Main() ************************/
 
 /**
@@ -71,14 +121,52 @@ int main(int argc, char **argv) {
 		print_version();
 	}
 
+	// convert weather into a binary store instead of simulating
+	if (_storefile[0] != '\0') {
+		if (_batchfile[0] != '\0') {
+			SW_BAT_weather_store(_batchfile, _firstfile, _storefile);
+		} else {
+			convert_weather();
+		}
+		return 0;
+	}
+
+	// solar geometry of previous program runs
+	if (_solarfile[0] != '\0') {
+		SW_PET_solargeom_read(_solarfile);
+	}
+
+	// batch run: simulate each site of the manifest
+	// ensemble run: simulate spin-up once, then each branch of the manifest
+	// realizations: simulate the site (or each site) with n weather streams
+	if (_batchfile[0] != '\0' || _n_real > 0) {
+		if (_n_real > 0) {
+			SW_BAT_realizations(
+				(_batchfile[0] != '\0') ? _batchfile : NULL,
+				_firstfile, _n_real, _seed_real, _n_workers
+			);
+		} else if (_spinupyr > 0) {
+			SW_BAT_ensemble(_batchfile, _firstfile, _spinupyr, _n_workers);
+		} else {
+			SW_BAT_run(_batchfile, _firstfile, _n_workers);
+		}
+
+		if (_solarfile[0] != '\0') {
+			SW_PET_solargeom_write(_solarfile);
+		}
+		SW_PET_solargeom_clear();
+		report_timing();
+		return 0;
+	}
+
   // setup and construct model (independent of inputs)
-	SW_CTL_setup_model(_firstfile);
+	SW_CTL_setup_model(NULL, _firstfile);
 
 	// read user inputs
-	SW_CTL_read_inputs_from_disk();
+	SW_CTL_read_inputs_from_disk(NULL);
 
 	// initialize simulation run (based on user inputs)
-	SW_CTL_init_run();
+	SW_CTL_init_run(NULL);
 
   // initialize output
 	SW_OUT_set_ncol();
@@ -86,13 +174,19 @@ int main(int argc, char **argv) {
 	SW_OUT_create_files(); // only used with SOILWAT2
 
   // run simulation: loop through each year
-	SW_CTL_main();
+	SW_CTL_main(NULL);
 
   // finish-up output
 	SW_OUT_close_files(); // not used with rSOILWAT2
 
+	if (_solarfile[0] != '\0') {
+		SW_PET_solargeom_write(_solarfile);
+	}
+
 	// de-allocate all memory
-	SW_CTL_clear_model(swTRUE);
+	SW_CTL_clear_model(NULL, swTRUE);
+
+	report_timing();
 
 	return 0;
 }
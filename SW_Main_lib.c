@@ -29,6 +29,7 @@
 #include "SW_Control.h"
 #include "SW_Site.h"
 #include "SW_Weather.h"
+#include "SW_Batch.h"
 
 /* =================================================== */
 /*                  Global Declarations                */
@@ -36,13 +37,13 @@
 /* --------------------------------------------------- */
 
 /* see generic.h and filefuncs.h for more info on these vars */
-char inbuf[MAX_FILENAMESIZE]; /* buffer used by input statements */
-char errstr[MAX_ERROR]; /* used to compose an error msg    */
-FILE *logfp; /* file handle for logging messages */
-int logged; /* boolean: true = we logged a msg */
+SW_TLS char inbuf[MAX_FILENAMESIZE]; /* buffer used by input statements */
+SW_TLS char errstr[MAX_ERROR]; /* used to compose an error msg    */
+SW_TLS FILE *logfp; /* file handle for logging messages */
+SW_TLS int logged; /* boolean: true = we logged a msg */
 /* if true, write indicator to stderr */
 
-Bool QuietMode, EchoInits; /* if true, echo inits to logfile */
+SW_TLS Bool QuietMode, EchoInits; /* if true, echo inits to logfile */
 //function
 void init_args(int argc, char **argv);
 void print_version(void);
@@ -61,10 +62,30 @@ static void print_usage(void) {
 	swprintf(
 		"Ecosystem water simulation model SOILWAT2\n"
 		"More details at https://github.com/Burke-Lauenroth-Lab/SOILWAT2\n"
-		"Usage: ./SOILWAT2 [-d startdir] [-f files.in] [-e] [-q] [-v] [-h]\n"
+		"Usage: ./SOILWAT2 [-d startdir] [-f files.in] [-b manifest] [-t n]"
+		" [-y year] [-n n [-r seed]]"
+		" [-w store] [-p] [-g file] [-s file] [-e] [-q] [-v] [-h]\n"
 		"  -d : operate (chdir) in startdir (default=.)\n"
 		"  -f : name of main input file (default=files.in)\n"
 		"       a preceeding path applies to all input files\n"
+		"  -b : batch run of all site directories listed in manifest;\n"
+		"       each site directory contains its own main input file\n"
+		"  -t : number of worker threads of a batch, ensemble, or realizations\n"
+		"       run (default=1)\n"
+		"  -y : with -b, ensemble run: simulate files.in through year once,\n"
+		"       then continue each branch directory of manifest from that state;\n"
+		"       relative branch directories are relative to manifest\n"
+		"  -n : simulate n realizations of the weather generator of the site\n"
+		"       (or with -b, of each site); outputs are named *_r1, ..., *_rn\n"
+		"  -r : seed of the weather generator of the realizations (default=1)\n"
+		"  -w : convert daily weather into a binary weather store (.sw2w)\n"
+		"       instead of simulating; with -b, of all sites of manifest\n"
+		"  -p : preload all years of daily weather before simulating;\n"
+		"       runs with the same weather share the preloaded years\n"
+		"  -g : cache solar geometry in file: tables of the file are\n"
+		"       loaded before and new tables are saved after simulating\n"
+		"  -s : load parsed inputs from snapshot file in project directory\n"
+		"       if input files are unchanged; otherwise, parse and save them\n"
 		"  -e : echo initial values from site and estab to logfile\n"
 		"  -q : quiet mode, don't print message to check logfile\n"
 		"  -v : print version information\n"
@@ -87,7 +108,16 @@ void print_version(void) {
 }
 
 
-char _firstfile[MAX_FILENAMESIZE];
+SW_TLS char _firstfile[MAX_FILENAMESIZE];
+char _batchfile[MAX_FILENAMESIZE]; /* manifest of a batch run; empty if none */
+int _n_workers; /* number of worker threads of a batch run */
+TimeInt _spinupyr; /* last year of the spin-up of an ensemble run; 0 if none */
+int _n_real; /* number of realizations of the weather generator; 0 if none */
+unsigned long _seed_real; /* seed of the weather generator of realizations */
+char _storefile[MAX_FILENAMESIZE]; /* weather store to write; empty if none */
+char _solarfile[MAX_FILENAMESIZE]; /* solar geometry cache file; empty if none */
+extern Bool PreloadWeather; /* see SW_Weather_store.c */
+extern char InputSnapshot[]; /* see SW_Snapshot.c */
 
 /**
 @brief Initializes arguments and sets indicators/variables based on results.
@@ -110,18 +140,37 @@ void init_args(int argc, char **argv) {
 	 *                -f=chg deflt first file <opt=file.in>
 	 *                -q=quiet, don't print "Check logfile"
 	 *                   at end of program.
+	 *                -b=batch run of sites <opt=manifest>
+	 *                -t=number of worker threads <opt=n>
+	 *                -w=convert weather into store <opt=file.sw2w>
+	 *                -p=preload weather of all years
+	 *                -g=solar geometry cache <opt=file>
+	 *                -s=input snapshot <opt=file>
+	 *                -y=last year of ensemble spin-up <opt=year>
+	 *                -n=number of weather realizations <opt=n>
+	 *                -r=seed of weather realizations <opt=seed>
 	 */
 	char str[1024];
-	char const *opts[] = { "-d", "-f", "-e", "-q", "-v", "-h" }; /* valid options */
-	int valopts[] = { 1, 1, 0, 0, 0, 0 }; /* indicates options with values */
+	char const *opts[] = { "-d", "-f", "-e", "-q", "-v", "-h", "-b", "-t", "-w", "-p", "-g", "-s", "-y", "-n", "-r" }; /* valid options */
+	int valopts[] = { 1, 1, 0, 0, 0, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1 }; /* indicates options with values */
 	/* 0=none, 1=required, -1=optional */
 	int i, /* looper through all cmdline arguments */
 	a, /* current valid argument-value position */
 	op, /* position number of found option */
 	nopts = sizeof(opts) / sizeof(char *);
+	long n; /* numeric value of an option */
+	char *end; /* end of the numeric value of an option */
 
 	/* Defaults */
 	strcpy(_firstfile, DFLT_FIRSTFILE);
+	_batchfile[0] = '\0';
+	_n_workers = 1;
+	_spinupyr = 0;
+	_n_real = 0;
+	_seed_real = 1;
+	_storefile[0] = '\0';
+	_solarfile[0] = '\0';
+	InputSnapshot[0] = '\0';
 	QuietMode = EchoInits = swFALSE;
 
 	a = 1;
@@ -185,6 +234,48 @@ void init_args(int argc, char **argv) {
 				sw_error(-1, "");
 				break;
 
+			case 6: /* -b */
+				strcpy(_batchfile, str);
+				break;
+
+			case 7: /* -t */
+				n = strtol(str, &end, 10);
+				if (end == str || *end != '\0' || n < 1 || n > SW_BAT_MAXWORKERS) {
+					print_usage();
+					sw_error(-1, "\nInvalid number of worker threads %s (1-%d)\n",
+						str, SW_BAT_MAXWORKERS);
+				}
+				_n_workers = (int) n;
+				break;
+
+			case 8: /* -w */
+				strcpy(_storefile, str);
+				break;
+
+			case 9: /* -p */
+				PreloadWeather = swTRUE;
+				break;
+
+			case 10: /* -g */
+				strcpy(_solarfile, str);
+				break;
+
+			case 11: /* -s */
+				strcpy(InputSnapshot, str);
+				break;
+
+			case 12: /* -y */
+				_spinupyr = (TimeInt) atoi(str);
+				break;
+
+			case 13: /* -n */
+				_n_real = atoi(str);
+				break;
+
+			case 14: /* -r */
+				_seed_real = strtoul(str, NULL, 10);
+				break;
+
 			default:
 				LogError(
 					logfp,
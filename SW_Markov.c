@@ -11,6 +11,7 @@
  *    12/02 - IMPORTANT CHANGE - cwb
  *          refer to comments in Times.h regarding base0
  06/27/2013	(drs)	closed open files if LogError() with LOGFATAL is called in SW_MKV_read_prob(), SW_MKV_read_cov()
+ 10/18/2026	added SW_MKV_generate_year(): weather of all days of a year at once
  */
 /********************************************************/
 /********************************************************/
@@ -38,15 +39,15 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
-pcg32_random_t markov_rng;
-SW_MARKOV SW_Markov; /* declared here, externed elsewhere */
+extern SW_TLS SW_MODEL SW_Model;
+SW_TLS sw_random_t markov_rng;
+SW_TLS SW_MARKOV SW_Markov; /* declared here, externed elsewhere */
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
 
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 /* =================================================== */
 /* =================================================== */
@@ -332,6 +333,100 @@ void SW_MKV_today(TimeInt doy0, RealD *tmax, RealD *tmin, RealD *rain) {
 	#endif
 
 }
+/**
+@brief Generate the daily weather of a year at once.
+
+The weather is identical to calling `SW_MKV_today()` for each day with the
+precipitation of the previous day, i.e., the wet/dry Markov chain and the
+sequence of random numbers are preserved exactly for a given seed of
+`markov_rng`. In contrast to `SW_MKV_today()`, the factors of the
+multivariate normal temperatures (see `mvnorm()`) are calculated once per
+week instead of every day. All random numbers of the year are drawn first,
+in the order of `SW_MKV_today()`; the temperatures are then calculated from
+the drawn standard normal variates in a separate loop without branches on
+the Markov chain.
+
+@param firstdoy First day of the year (base1), e.g., `SW_Model.firstdoy`.
+@param lastdoy Last day of the year (base1), e.g., `SW_Model.lastdoy`.
+@param ppt_yesterday Precipitation of the day before `firstdoy` (cm), as
+  scaled by `SW_WTH_new_day()`.
+@param scale_precip Monthly scaling factors of precipitation; the Markov
+  chain continues from the scaled precipitation of a day, as it does
+  when `SW_MKV_today()` is called by `SW_WTH_new_day()`.
+@param[out] tmax Maximum temperature (&deg;C) for each day (base0).
+@param[out] tmin Mininum temperature (&deg;C) for each day (base0).
+@param[out] ppt Precipitation (cm) for each day (base0).
+*/
+void SW_MKV_generate_year(TimeInt firstdoy, TimeInt lastdoy,
+	RealD ppt_yesterday, const RealD scale_precip[MAX_MONTHS],
+	RealD tmax[MAX_DAYS], RealD tmin[MAX_DAYS], RealD ppt[MAX_DAYS]) {
+
+	SW_MARKOV *m = &SW_Markov;
+	TimeInt doy0, week;
+	RealF prob, p, x;
+	RealD rain = ppt_yesterday, s, z1[MAX_DAYS], z2[MAX_DAYS],
+		sd[MAX_WEEKS], vc10[MAX_WEEKS], vc11[MAX_WEEKS];
+	Bool has_week[MAX_WEEKS];
+
+	for (week = 0; week < MAX_WEEKS; week++) {
+		has_week[week] = swFALSE;
+	}
+
+	/* Draw the random numbers of all days: the wet/dry Markov chain depends
+	   on the precipitation of the previous day, but not on temperature */
+	for (doy0 = firstdoy - 1; doy0 < lastdoy; doy0++) {
+		/* Precipitation: see SW_MKV_today() */
+		prob = (GT(rain, 0.0)) ? m->wetprob[doy0] : m->dryprob[doy0];
+
+		p = RandUni(&markov_rng);
+		if (LE(p, prob)) {
+			x = RandNorm(m->avg_ppt[doy0], m->std_ppt[doy0], &markov_rng);
+			ppt[doy0] = fmax(0., x);
+		} else {
+			ppt[doy0] = 0.;
+		}
+
+		if (GT(ppt[doy0], 0.)) {
+			m->ppt_events++;
+		}
+
+		z1[doy0] = RandNorm(0., 1., &markov_rng);
+		z2[doy0] = RandNorm(0., 1., &markov_rng);
+
+		/* Tomorrow continues from today's scaled precipitation */
+		rain = ppt[doy0] * scale_precip[doy2month(doy0 + 1)];
+
+		/* Factors of the multivariate normal temperatures of the week */
+		week = doy2week(doy0 + 1);
+
+		if (!has_week[week]) {
+			sd[week] = sqrt(m->v_cov[week][0][0]);
+			vc10[week] = (GT(sd[week], 0.)) ? m->v_cov[week][1][0] / sd[week] : 0;
+			s = vc10[week] * vc10[week];
+
+			if (GT(s, m->v_cov[week][1][1])) {
+				LogError(logfp, LOGFATAL, "\nBad covariance matrix in mvnorm()");
+			}
+
+			vc11[week] = (EQ(m->v_cov[week][1][1], s)) ?
+				0. : sqrt(m->v_cov[week][1][1] - s);
+			has_week[week] = swTRUE;
+		}
+	}
+
+	/* Temperature of all days: see mvnorm() */
+	for (doy0 = firstdoy - 1; doy0 < lastdoy; doy0++) {
+		week = doy2week(doy0 + 1);
+
+		tmax[doy0] = sd[week] * z1[doy0] + m->u_cov[week][0];
+		tmin[doy0] = fmin(tmax[doy0],
+			(vc10[week] * z1[doy0]) + (vc11[week] * z2[doy0]) + m->u_cov[week][1]);
+
+		temp_correct_wetdry(&tmax[doy0], &tmin[doy0], ppt[doy0],
+			m->cfxw[week], m->cfxd[week], m->cfnw[week], m->cfnd[week]);
+	}
+}
+
 /**
 @brief Reads prob file in and checks input variables for errors, then stores files in SW_Markov.
 
@@ -43,6 +43,9 @@ Bool SW_MKV_read_prob(void);
 Bool SW_MKV_read_cov(void);
 void SW_MKV_setup(void);
 void SW_MKV_today(TimeInt doy0, RealD *tmax, RealD *tmin, RealD *rain);
+void SW_MKV_generate_year(TimeInt firstdoy, TimeInt lastdoy,
+	RealD ppt_yesterday, const RealD scale_precip[MAX_MONTHS],
+	RealD tmax[MAX_DAYS], RealD tmin[MAX_DAYS], RealD ppt[MAX_DAYS]);
 
 #ifdef DEBUG_MEM
 void SW_MKV_SetMemoryRefs( void);
@@ -53,16 +53,16 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_SITE SW_Site; /* for reset attribute */
-SW_MODEL SW_Model; /* declared here, externed elsewhere */
+extern SW_TLS SW_SITE SW_Site; /* for reset attribute */
+SW_TLS SW_MODEL SW_Model; /* declared here, externed elsewhere */
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
-/* these are set in _new_day() */
-static TimeInt _prevweek, /* check for new week */
+/* these are set in _new_day(); externed by `SW_Control.c` for `SW_RUN` */
+SW_TLS TimeInt _prevweek, /* check for new week */
 _prevmonth, /* check for new month */
 _prevyear, /* check for new year */
 _notime = 0xffff; /* init value for _prev* */
@@ -48,6 +48,7 @@
 #include "SW_Weather.h"
 #include "SW_VegEstab.h"
 #include "SW_VegProd.h"
+#include "SW_Timing.h"
 
 #include "SW_Output.h"
 
@@ -61,6 +62,16 @@
 #include "SW_Output_outtext.h"
 #endif
 
+// Binary output declarations:
+#ifdef SW_OUTBINARY
+#include "SW_Output_outbinary.h"
+#endif
+
+// In-memory output declarations:
+#ifdef SW_OUTMEMORY
+#include "SW_Output_outmemory.h"
+#endif
+
 /* Note: `get_XXX` functions are declared in `SW_Output.h`
     and defined/implemented in 'SW_Output_get_functions.c"
 */
@@ -69,55 +80,72 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_SITE SW_Site;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_MODEL SW_Model;
-extern SW_WEATHER SW_Weather;
-extern SW_VEGPROD SW_VegProd;
-extern SW_VEGESTAB SW_VegEstab;
-extern Bool EchoInits;
-extern SW_CARBON SW_Carbon;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS Bool EchoInits;
+extern SW_TLS SW_CARBON SW_Carbon;
 
 
-SW_OUTPUT SW_Output[SW_OUTNKEYS];
+SW_TLS SW_OUTPUT SW_Output[SW_OUTNKEYS];
 
-char _Sep; /* output delimiter */
-TimeInt tOffset; /* 1 or 0 means we're writing previous or current period */
+SW_TLS char _Sep; /* output delimiter */
+SW_TLS TimeInt tOffset; /* 1 or 0 means we're writing previous or current period */
 
 
 // Global variables describing output periods:
 /** `timeSteps` is the array that keeps track of the output time periods that
     are required for `text` and/or `array`-based output for each output key. */
-OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
+SW_TLS OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
 /** The number of different time steps/periods that are used/requested
 		Note: Under STEPWAT2, this may be larger than the sum of `use_OutPeriod`
 			because it also incorporates information from `timeSteps_SXW`. */
-IntUS used_OUTNPERIODS;
+SW_TLS IntUS used_OUTNPERIODS;
 /** TRUE if time step/period is active for any output key. */
-Bool use_OutPeriod[SW_OUTNPERIODS];
+SW_TLS Bool use_OutPeriod[SW_OUTNPERIODS];
 
 
 // Global variables describing size and names of output
 /** names of output columns for each output key; number is an expensive guess */
-char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+SW_TLS char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
 /** number of output columns for each output key */
-IntUS ncol_OUT[SW_OUTNKEYS];
+SW_TLS IntUS ncol_OUT[SW_OUTNKEYS];
+/** output keys that are summed and aggregated for each object type and
+    output period; see `SW_OUT_compile_plan()` */
+SW_TLS SW_OUT_PLAN plan_OUT;
 
 
 // Text-based output: defined in `SW_Output_outtext.c`:
 #ifdef SW_OUTTEXT
-extern SW_FILE_STATUS SW_OutFiles;
-extern char sw_outstr[];
-extern Bool print_IterationSummary;
-extern Bool print_SW_Output;
+extern SW_TLS SW_FILE_STATUS SW_OutFiles;
+extern SW_TLS char sw_outstr[];
+extern SW_TLS Bool print_IterationSummary;
+extern SW_TLS Bool print_SW_Output;
 #endif
 
 
 // Array-based output: defined in `SW_Output_outarray.c`
 #ifdef SW_OUTARRAY
 extern IntUS ncol_TimeOUT[];
-extern size_t nrow_OUT[];
-extern size_t irow_OUT[];
+extern SW_TLS size_t nrow_OUT[];
+extern SW_TLS size_t irow_OUT[];
+extern SW_TLS RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+#endif
+
+
+// Binary output: defined in `SW_Output_outbinary.c`
+#ifdef SW_OUTBINARY
+extern SW_TLS FILE *fp_bin[];
+extern SW_TLS size_t nrow_bin[];
+#endif
+
+// In-memory output: defined in `SW_Output_outmemory.c`
+#ifdef SW_OUTMEMORY
+extern SW_TLS SW_OUT_SINK sink_OUT;
+extern SW_TLS void *sinkdata_OUT;
 #endif
 
 
@@ -185,10 +213,10 @@ char const *styp2str[] =
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
-static int useTimeStep; /* flag to determine whether or not the line TIMESTEP exists */
-static Bool bFlush_output; /* process partial period ? */
+static SW_TLS int useTimeStep; /* flag to determine whether or not the line TIMESTEP exists */
+static SW_TLS Bool bFlush_output; /* process partial period ? */
 
 
 /* =================================================== */
@@ -203,7 +231,6 @@ static OutSum str2stype(char *s);
 static void collect_sums(ObjType otyp, OutPeriod op);
 static void sumof_wth(SW_WEATHER *v, SW_WEATHER_OUTPUTS *s, OutKey k);
 static void sumof_swc(SW_SOILWAT *v, SW_SOILWAT_OUTPUTS *s, OutKey k);
-static void sumof_ves(SW_VEGESTAB *v, SW_VEGESTAB_OUTPUTS *s, OutKey k);
 static void sumof_vpd(SW_VEGPROD *v, SW_VEGPROD_OUTPUTS *s, OutKey k);
 static void average_for(ObjType otyp, OutPeriod pd);
 
@@ -338,23 +365,6 @@ static void sumof_vpd(SW_VEGPROD *v, SW_VEGPROD_OUTPUTS *s, OutKey k)
 	}
 }
 
-static void sumof_ves(SW_VEGESTAB *v, SW_VEGESTAB_OUTPUTS *s, OutKey k)
-{
-	/* --------------------------------------------------- */
-	/* k is always eSW_Estab, and this only gets called yearly */
-	/* in fact, there's nothing to do here as the get_estab()
-	 * function does everything needed.  This stub is here only
-	 * to facilitate the loop everything else uses.
-	 * That is, until we need to start outputting as-yet-unknown
-	 * establishment variables.
-	 */
-
-// just a few lines of nonsense to supress the compile warnings
-  if ((int)k == 1) {}
-  if (0 == v->count) {}
-  if (0 == s->days) {}
-}
-
 static void sumof_wth(SW_WEATHER *v, SW_WEATHER_OUTPUTS *s, OutKey k)
 {
 	switch (k)
@@ -419,13 +429,13 @@ static void sumof_swc(SW_SOILWAT *v, SW_SOILWAT_OUTPUTS *s, OutKey k)
 	case eSW_SWABulk:
 		ForEachSoilLayer(i)
 			s->swaBulk[i] += fmax(
-					v->swcBulk[Today][i] - SW_Site.lyr[i]->swcBulk_wiltpt, 0.);
+					v->swcBulk[Today][i] - SW_Site.swcBulk_wiltpt[i], 0.);
 		break;
 
 	case eSW_SWAMatric: /* get swaBulk and convert later */
 		ForEachSoilLayer(i)
 			s->swaMatric[i] += fmax(
-					v->swcBulk[Today][i] - SW_Site.lyr[i]->swcBulk_wiltpt, 0.);
+					v->swcBulk[Today][i] - SW_Site.swcBulk_wiltpt[i], 0.);
 		break;
 
 	case eSW_SWA: /* get swaBulk and convert later */
@@ -537,10 +547,12 @@ static void average_for(ObjType otyp, OutPeriod pd) {
 	SW_WEATHER *w = &SW_Weather;
 	SW_VEGPROD *vp = &SW_VegProd;
 	TimeInt curr_pd = 0;
-	RealD div = 0.; /* if sumtype=AVG, days in period; if sumtype=SUM, 1 */
+	RealD div = 0., /* if sumtype=AVG, days in period; if sumtype=SUM, 1 */
+		ndays = 0.;
 	OutKey k;
 	LyrIndex i;
 	int j;
+	IntUS ik;
 
 	if (otyp == eVES)
 		return;
@@ -570,36 +582,39 @@ static void average_for(ObjType otyp, OutPeriod pd) {
 
 	}
 	else {
-		// carefully aggregate for specific time period and aggregation type (mean, sum, final value)
-		ForEachOutKey(k)
+		switch (pd)
 		{
-			if (!SW_Output[k].use) {
-				continue;
-			}
+			case eSW_Week:
+				curr_pd = (SW_Model.week + 1) - tOffset;
+				ndays = (bFlush_output) ? SW_Model.lastdoy % WKDAYS : WKDAYS;
+				break;
 
-			switch (pd)
-			{
-				case eSW_Week:
-					curr_pd = (SW_Model.week + 1) - tOffset;
-					div = (bFlush_output) ? SW_Model.lastdoy % WKDAYS : WKDAYS;
-					break;
+			case eSW_Month:
+				curr_pd = (SW_Model.month + 1) - tOffset;
+				ndays = Time_days_in_month(SW_Model.month - tOffset);
+				break;
 
-				case eSW_Month:
-					curr_pd = (SW_Model.month + 1) - tOffset;
-					div = Time_days_in_month(SW_Model.month - tOffset);
-					break;
+			case eSW_Year:
+				break;
 
-				case eSW_Year:
-					curr_pd = SW_Output[k].first;
-					div = SW_Output[k].last - SW_Output[k].first + 1;
-					break;
+			default:
+				LogError(logfp, LOGFATAL, "Programmer: Invalid period in average_for().");
+		} /* end switch(pd) */
 
-				default:
-					LogError(logfp, LOGFATAL, "Programmer: Invalid period in average_for().");
-			} /* end switch(pd) */
+		// carefully aggregate for specific time period and aggregation type
+		// (mean, sum, final value) those output keys that the plan requests
+		for (ik = 0; ik < plan_OUT.n[otyp][pd]; ik++)
+		{
+			k = plan_OUT.key[otyp][pd][ik];
 
-			if (SW_Output[k].myobj != otyp
-					|| curr_pd < SW_Output[k].first
+			if (pd == eSW_Year) {
+				curr_pd = SW_Output[k].first;
+				div = SW_Output[k].last - SW_Output[k].first + 1;
+			} else {
+				div = ndays;
+			}
+
+			if (curr_pd < SW_Output[k].first
 					|| curr_pd > SW_Output[k].last)
 				continue;
 
@@ -689,7 +704,7 @@ static void average_for(ObjType otyp, OutPeriod pd) {
 							(SW_Output[k].sumtype == eSW_Fnl) ?
 									fmax(
 											s->swcBulk[Yesterday][i]
-													- SW_Site.lyr[i]->swcBulk_wiltpt,
+													- SW_Site.swcBulk_wiltpt[i],
 											0.) :
 									s->p_accu[pd]->swaBulk[i] / div;
 				}
@@ -701,7 +716,7 @@ static void average_for(ObjType otyp, OutPeriod pd) {
 							(SW_Output[k].sumtype == eSW_Fnl) ?
 									fmax(
 											s->swcBulk[Yesterday][i]
-													- SW_Site.lyr[i]->swcBulk_wiltpt,
+													- SW_Site.swcBulk_wiltpt[i],
 											0.) :
 									s->p_accu[pd]->swaMatric[i] / div;
 				}
@@ -816,7 +831,7 @@ static void average_for(ObjType otyp, OutPeriod pd) {
 				LogError(logfp, LOGFATAL, "PGMR: Invalid key in average_for(%s)", key2str[k]);
 			}
 
-		} /* end ForEachKey */
+		} /* end plan */
 	}
 }
 
@@ -825,13 +840,15 @@ static void collect_sums(ObjType otyp, OutPeriod op)
 {
 	SW_SOILWAT *s = &SW_Soilwat;
 	SW_WEATHER *w = &SW_Weather;
-	SW_VEGESTAB *v = &SW_VegEstab;
 	SW_VEGPROD *vp = &SW_VegProd;
 
 	TimeInt pd = 0;
 	OutKey k;
-	IntUS i;
-	Bool use_help, use_KeyPeriodCombo;
+	IntUS i, n = plan_OUT.n[otyp][op];
+	const OutKey *keys = plan_OUT.key[otyp][op];
+
+	if (n == 0)
+		return;
 
 	switch (op)
 	{
@@ -852,58 +869,37 @@ static void collect_sums(ObjType otyp, OutPeriod op)
 	}
 
 
-	// call `sumof_XXX` for each output key x output period combination
-	// for those output keys that belong to the output type `otyp` (eSWC, eWTH, eVES, eVPD)
-	ForEachOutKey(k)
+	// call `sumof_XXX` for each output key of the plan for the object type
+	// `otyp` (eSWC, eWTH, eVPD) and output period `op`
+	switch (otyp)
 	{
-		if (otyp != SW_Output[k].myobj || !SW_Output[k].use)
-			continue;
-
-		/* determine whether output period op is active for current output key k */
-		use_KeyPeriodCombo = swFALSE;
-		for (i = 0; i < used_OUTNPERIODS; i++)
-		{
-			use_help = (Bool) op == timeSteps[k][i];
-
-			#ifdef STEPWAT
-			use_help = (Bool) (use_help || op == timeSteps_SXW[k][i]);
-			#endif
-
-			if (use_help)
-			{
-				use_KeyPeriodCombo = swTRUE;
-				break;
+		case eSWC:
+			for (i = 0; i < n; i++) {
+				k = keys[i];
+				if (pd >= SW_Output[k].first && pd <= SW_Output[k].last)
+					sumof_swc(s, s->p_accu[op], k);
 			}
-		}
-
-		if (use_KeyPeriodCombo && pd >= SW_Output[k].first && pd <= SW_Output[k].last)
-		{
-			switch (otyp)
-			{
-			case eSWC:
-				sumof_swc(s, s->p_accu[op], k);
-				break;
-
-			case eWTH:
-				sumof_wth(w, w->p_accu[op], k);
-				break;
-
-			case eVES:
-				if (op == eSW_Year) {
-					sumof_ves(v, v->p_accu[eSW_Year], k); /* yearly, y'see */
-				}
-				break;
+			break;
 
-			case eVPD:
-				sumof_vpd(vp, vp->p_accu[op], k);
-				break;
+		case eWTH:
+			for (i = 0; i < n; i++) {
+				k = keys[i];
+				if (pd >= SW_Output[k].first && pd <= SW_Output[k].last)
+					sumof_wth(w, w->p_accu[op], k);
+			}
+			break;
 
-			default:
-				break;
+		case eVPD:
+			for (i = 0; i < n; i++) {
+				k = keys[i];
+				if (pd >= SW_Output[k].first && pd <= SW_Output[k].last)
+					sumof_vpd(vp, vp->p_accu[op], k);
 			}
-		}
+			break;
 
-	} /* end ForEachOutKey */
+		default:
+			break;
+	}
 }
 
 
@@ -967,6 +963,8 @@ void find_OutPeriods_inUse(void)
 			}
 		}
 	}
+
+	SW_OUT_compile_plan();
 }
 
 /** Determine whether output period `pd` is active for output key `k`
@@ -984,6 +982,56 @@ Bool has_OutPeriod_inUse(OutPeriod pd, OutKey k)
 	return has_timeStep;
 }
 
+/** @brief Compile the accumulation plan, i.e., the list of output keys
+		that are summed and aggregated for each object type and output period
+
+		Output keys of `eVES` and `eSW_CO2Effects` are not part of the plan
+		because they are not accumulated across days: `get_estab()` and
+		`get_co2effects()` report current values.
+
+		@sideeffect Uses global variables `SW_Output.use`, `timeSteps`,
+			and (under STEPWAT2) `timeSteps_SXW` to set `plan_OUT`
+*/
+void SW_OUT_compile_plan(void)
+{
+	OutKey k;
+	OutPeriod p;
+	ObjType otyp;
+	IntUS i;
+	Bool use_KeyPeriodCombo;
+
+	memset(&plan_OUT, 0, sizeof plan_OUT);
+
+	ForEachOutPeriod(p)
+	{
+		ForEachOutKey(k)
+		{
+			otyp = SW_Output[k].myobj;
+
+			if (!SW_Output[k].use || otyp == eVES || k == eSW_CO2Effects)
+				continue;
+
+			/* determine whether output period p is active for output key k */
+			use_KeyPeriodCombo = swFALSE;
+			for (i = 0; i < used_OUTNPERIODS; i++)
+			{
+				use_KeyPeriodCombo = (Bool) (use_KeyPeriodCombo ||
+					p == timeSteps[k][i]);
+
+				#ifdef STEPWAT
+				use_KeyPeriodCombo = (Bool) (use_KeyPeriodCombo ||
+					p == timeSteps_SXW[k][i]);
+				#endif
+			}
+
+			if (use_KeyPeriodCombo)
+			{
+				plan_OUT.key[otyp][p][plan_OUT.n[otyp][p]++] = k;
+			}
+		}
+	}
+}
+
 #ifdef STEPWAT
 /** Tally for which output time periods at least one output key/type is active
 		while accounting for output needs of `SXW`
@@ -1052,6 +1100,8 @@ void SW_OUT_set_SXWrequests(void)
 	// STEPWAT2 requires annual sum of AET
 	_set_SXWrequests_helper(eSW_AET, eSW_Year, eSW_Sum,
 		"annual AET");
+
+	SW_OUT_compile_plan();
 }
 #endif
 
@@ -1065,7 +1115,7 @@ void SW_OUT_construct(void)
 	SW_SOILWAT_OUTPUTS *s = NULL;
 	int j;
 
-	#if defined(SOILWAT)
+	#if defined(SOILWAT) && defined(SW_OUTTEXT)
 	print_SW_Output = swTRUE;
 	print_IterationSummary = swFALSE;
 	#elif defined(STEPWAT)
@@ -1104,6 +1154,7 @@ void SW_OUT_construct(void)
 	 * before clearing structure.
 	 */
 	memset(&SW_Output, 0, sizeof(SW_Output));
+	memset(&plan_OUT, 0, sizeof(plan_OUT));
 
 	/* attach the printing functions for each output
 	 * quantity to the appropriate element in the
@@ -1138,7 +1189,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_temp_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_temp_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_temp_agg;
@@ -1150,7 +1201,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_precip_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_precip_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_precip_agg;
@@ -1162,7 +1213,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_vwcBulk_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_vwcBulk_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_vwcBulk_agg;
@@ -1174,7 +1225,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_vwcMatric_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_vwcMatric_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_vwcMatric_agg;
@@ -1186,7 +1237,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_swcBulk_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_swcBulk_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_swcBulk_agg;
@@ -1198,7 +1249,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_swpMatric_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_swpMatric_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_swpMatric_agg;
@@ -1210,7 +1261,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_swaBulk_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_swaBulk_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_swaBulk_agg;
@@ -1222,7 +1273,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_swaMatric_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_swaMatric_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_swaMatric_agg;
@@ -1234,7 +1285,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_swa_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_swa_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_swa_agg;
@@ -1246,7 +1297,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_surfaceWater_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_surfaceWater_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_surfaceWater_agg;
@@ -1258,7 +1309,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_runoffrunon_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_runoffrunon_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_runoffrunon_agg;
@@ -1270,7 +1321,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_transp_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_transp_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_transp_agg;
@@ -1282,7 +1333,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_evapSoil_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_evapSoil_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_evapSoil_agg;
@@ -1294,7 +1345,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_evapSurface_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_evapSurface_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_evapSurface_agg;
@@ -1306,7 +1357,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_interception_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_interception_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_interception_agg;
@@ -1318,7 +1369,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_soilinf_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_soilinf_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_soilinf_agg;
@@ -1330,7 +1381,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_lyrdrain_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_lyrdrain_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_lyrdrain_agg;
@@ -1342,7 +1393,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_hydred_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_hydred_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_hydred_agg;
@@ -1354,7 +1405,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_aet_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_aet_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_aet_agg;
@@ -1366,7 +1417,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_pet_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_pet_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_pet_agg;
@@ -1378,7 +1429,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_wetdays_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_wetdays_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_wetdays_agg;
@@ -1390,7 +1441,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_snowpack_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_snowpack_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_snowpack_agg;
@@ -1402,7 +1453,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_deepswc_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_deepswc_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_deepswc_agg;
@@ -1414,7 +1465,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_soiltemp_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_soiltemp_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_soiltemp_agg;
@@ -1426,7 +1477,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_estab_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_estab_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_estab_agg;
@@ -1438,7 +1489,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_co2effects_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_co2effects_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_co2effects_agg;
@@ -1450,7 +1501,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_biomass_text;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_biomass_mem;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_biomass_agg;
@@ -1462,7 +1513,7 @@ void SW_OUT_construct(void)
 			#ifdef SW_OUTTEXT
 			SW_Output[k].pfunc_text = (void (*)(OutPeriod)) get_none;
 			#endif
-			#if defined(RSOILWAT)
+			#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			SW_Output[k].pfunc_mem = (void (*)(OutPeriod)) get_none;
 			#elif defined(STEPWAT)
 			SW_Output[k].pfunc_agg = (void (*)(OutPeriod)) get_none;
@@ -1512,6 +1563,94 @@ void SW_OUT_deconstruct(Bool full_reset)
 }
 
 
+/** @brief Copy the output state of the active simulation run into `r`
+
+  @param r Output state of a simulation run, see `SW_RUN`.
+*/
+void SW_OUT_store_run(SW_OUT_RUN *r)
+{
+	memcpy(r->Output, SW_Output, sizeof SW_Output);
+	r->sep = _Sep;
+	r->tOffset = tOffset;
+	memcpy(r->timeSteps, timeSteps, sizeof timeSteps);
+	r->used_OUTNPERIODS = used_OUTNPERIODS;
+	memcpy(r->ncol_OUT, ncol_OUT, sizeof ncol_OUT);
+	memcpy(r->use_OutPeriod, use_OutPeriod, sizeof use_OutPeriod);
+	memcpy(r->colnames_OUT, colnames_OUT, sizeof colnames_OUT);
+	r->plan = plan_OUT;
+
+	#ifdef SW_OUTTEXT
+	memcpy(r->make_soil, SW_OutFiles.make_soil, sizeof r->make_soil);
+	memcpy(r->make_regular, SW_OutFiles.make_regular, sizeof r->make_regular);
+	memcpy(r->fp_reg, SW_OutFiles.fp_reg, sizeof r->fp_reg);
+	memcpy(r->fp_soil, SW_OutFiles.fp_soil, sizeof r->fp_soil);
+	memcpy(r->iobuf_reg, SW_OutFiles.iobuf_reg, sizeof r->iobuf_reg);
+	memcpy(r->iobuf_soil, SW_OutFiles.iobuf_soil, sizeof r->iobuf_soil);
+	r->print_IterationSummary = print_IterationSummary;
+	r->print_SW_Output = print_SW_Output;
+	#endif
+
+	#ifdef SW_OUTARRAY
+	memcpy(r->p_OUT, p_OUT, sizeof r->p_OUT);
+	memcpy(r->nrow_OUT, nrow_OUT, sizeof r->nrow_OUT);
+	memcpy(r->irow_OUT, irow_OUT, sizeof r->irow_OUT);
+	#endif
+
+	#ifdef SW_OUTBINARY
+	memcpy(r->fp_bin, fp_bin, sizeof r->fp_bin);
+	memcpy(r->nrow_bin, nrow_bin, sizeof r->nrow_bin);
+	#endif
+
+	#ifdef SW_OUTMEMORY
+	r->sink = sink_OUT;
+	r->sinkdata = sinkdata_OUT;
+	#endif
+}
+
+/** @brief Make `r` the output state of the active simulation run
+
+  @param r Output state of a simulation run, see `SW_RUN`.
+*/
+void SW_OUT_restore_run(const SW_OUT_RUN *r)
+{
+	memcpy(SW_Output, r->Output, sizeof SW_Output);
+	_Sep = r->sep;
+	tOffset = r->tOffset;
+	memcpy(timeSteps, r->timeSteps, sizeof timeSteps);
+	used_OUTNPERIODS = r->used_OUTNPERIODS;
+	memcpy(ncol_OUT, r->ncol_OUT, sizeof ncol_OUT);
+	memcpy(use_OutPeriod, r->use_OutPeriod, sizeof use_OutPeriod);
+	memcpy(colnames_OUT, r->colnames_OUT, sizeof colnames_OUT);
+	plan_OUT = r->plan;
+
+	#ifdef SW_OUTTEXT
+	memcpy(SW_OutFiles.make_soil, r->make_soil, sizeof r->make_soil);
+	memcpy(SW_OutFiles.make_regular, r->make_regular, sizeof r->make_regular);
+	memcpy(SW_OutFiles.fp_reg, r->fp_reg, sizeof r->fp_reg);
+	memcpy(SW_OutFiles.fp_soil, r->fp_soil, sizeof r->fp_soil);
+	memcpy(SW_OutFiles.iobuf_reg, r->iobuf_reg, sizeof r->iobuf_reg);
+	memcpy(SW_OutFiles.iobuf_soil, r->iobuf_soil, sizeof r->iobuf_soil);
+	print_IterationSummary = r->print_IterationSummary;
+	print_SW_Output = r->print_SW_Output;
+	#endif
+
+	#ifdef SW_OUTARRAY
+	memcpy(p_OUT, r->p_OUT, sizeof r->p_OUT);
+	memcpy(nrow_OUT, r->nrow_OUT, sizeof r->nrow_OUT);
+	memcpy(irow_OUT, r->irow_OUT, sizeof r->irow_OUT);
+	#endif
+
+	#ifdef SW_OUTBINARY
+	memcpy(fp_bin, r->fp_bin, sizeof r->fp_bin);
+	memcpy(nrow_bin, r->nrow_bin, sizeof r->nrow_bin);
+	#endif
+
+	#ifdef SW_OUTMEMORY
+	sink_OUT = r->sink;
+	sinkdata_OUT = r->sinkdata;
+	#endif
+}
+
 
 void SW_OUT_set_ncol(void) {
 	int tLayers = SW_Site.n_layers;
@@ -2114,12 +2253,16 @@ void SW_OUT_read(void)
 
 
 void _collect_values(void) {
+	SW_TIMER_START(eSW_TimOutSum);
 	SW_OUT_sum_today(eSWC);
 	SW_OUT_sum_today(eWTH);
 	SW_OUT_sum_today(eVES);
 	SW_OUT_sum_today(eVPD);
+	SW_TIMER_STOP(eSW_TimOutSum);
 
+	SW_TIMER_START(eSW_TimOutWrite);
 	SW_OUT_write_today();
+	SW_TIMER_STOP(eSW_TimOutWrite);
 }
 
 
@@ -2134,6 +2277,11 @@ void SW_OUT_flush(void) {
 
 	bFlush_output = swFALSE;
 	tOffset = 1;
+
+	#ifdef SW_OUTTEXT
+	// write buffered output of this year to disk
+	SW_OUT_flush_files();
+	#endif
 }
 
 /** adds today's output values to week, month and year
@@ -2292,14 +2440,20 @@ void SW_OUT_write_today(void)
 				continue; // don't call any `get_XXX` function
 			}
 
-			#ifdef SOILWAT
+			#ifdef SW_OUTMEMORY
+			if (isnull(p_OUT[k][timeSteps[k][i]])) {
+				continue; // no output arrays, see `SW_OUT_create_files()`
+			}
+			#endif
+
+			#if defined(SOILWAT) && !defined(SW_OUTBINARY) && !defined(SW_OUTMEMORY)
 			#ifdef SWDEBUG
 			if (debug) swprintf(" call pfunc_text(%d=%s))",
 				timeSteps[k][i], pd2str[timeSteps[k][i]]);
 			#endif
 			((void (*)(OutPeriod)) SW_Output[k].pfunc_text)(timeSteps[k][i]);
 
-			#elif RSOILWAT
+			#elif defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 			#ifdef SWDEBUG
 			if (debug) swprintf(" call pfunc_mem(%d=%s))",
 				timeSteps[k][i], pd2str[timeSteps[k][i]]);
@@ -2384,9 +2538,7 @@ void SW_OUT_write_today(void)
 				if (print_SW_Output) {
 					fprintf(SW_OutFiles.fp_reg[p], "%s%s\n",
 						str_time, SW_OutFiles.buf_reg[p]);
-					// STEPWAT2 needs a fflush for yearly output;
-					// other time steps, the soil-layer files, and SOILWAT2 work fine without it...
-					fflush(SW_OutFiles.fp_reg[p]);
+					// output files are flushed at the end of each year by `SW_OUT_flush`
 				}
 
 				#ifdef STEPWAT
@@ -2427,6 +2579,31 @@ void SW_OUT_write_today(void)
 	}
 	#endif
 
+	#ifdef SW_OUTBINARY
+	// write full blocks of rows to binary files
+	ForEachOutPeriod(p)
+	{
+		if (use_OutPeriod[p] && irow_OUT[p] == nrow_OUT[p])
+		{
+			SW_OUT_write_binary(p);
+		}
+	}
+	#endif
+
+	#ifdef SW_OUTMEMORY
+	// pass completed rows to the streaming output sink
+	if (!isnull(sink_OUT))
+	{
+		ForEachOutPeriod(p)
+		{
+			if (use_OutPeriod[p] && writeit[p])
+			{
+				SW_OUT_write_sink(p);
+			}
+		}
+	}
+	#endif
+
   #ifdef SWDEBUG
   if (debug) swprintf("'SW_OUT_write_today': completed\n");
   #endif
@@ -2509,16 +2686,18 @@ void SW_OUT_SetMemoryRefs( void)
       - if today is the start of a new day/week/month/year period or if
         `bFlush_output`, then it
         -# calls average_for() with arguments `otype` and `pd` which
-          -# loops over all output keys `k`
+          -# loops over the output keys `k` of the accumulation plan
+             (see SW_OUT_compile_plan()) for `otype` and `pd`
           -# divides the summed values by the duration of the specific output
              period
           -# fills the output aggregator `p_oagg[pd]` variables
         -# resets the memory of the output accumulator `p_accu[d]` variables
       - and, unless `bFlush_output` is `FALSE`, in a second loop over each
         \ref OutPeriod `pd` calls collect_sums() with arguments `otype` and `pd`
-        which calls the output summing function corresponding to its
+        which calls, for each output key of the accumulation plan, the output
+        summing function corresponding to its
         \ref ObjType argument `otype`, i.e., one of the functions sumof_swc(),
-        sumof_wth(), sumof_ves(), or sumof_vpd, in order to sum up the daily
+        sumof_wth(), or sumof_vpd, in order to sum up the daily
         values in the corresponding output accumulator `p_accu[pd]` variables.
 
     -# calls SW_OUT_write_today() which loops over each \ref OutKey `k` and
@@ -2618,8 +2797,8 @@ void SW_OUT_SetMemoryRefs( void)
   function to handle collecting the summaries called collect_sums().
 
   The collect_sums() function needs the object type (eg, eSWC, eWTH)
-  and the output period (eg, dy, wk, etc) and then, for each valid
-  output key, it assigns a pointer to the appropriate object's
+  and the output period (eg, dy, wk, etc) and then, for each output key
+  of the accumulation plan, it assigns a pointer to the appropriate object's
   summary sub-structure.  (This is where the complexity of this
   approach starts to become a bit clumsy, but it nonetheless tends to
   keep the overall code size down.) After assigning the pointer to
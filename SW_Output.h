@@ -24,6 +24,8 @@
 	01/10/2013	(clk)	instead of using one FILE pointer named fp, created four new
 			FILE pointers; fp_reg_agg[eSW_Day], fp_reg_agg[eSW_Week], fp_reg_agg[eSW_Month], and fp_reg_agg[eSW_Year]. This allows us to keep track
 			of all time steps for each OutKey.
+	10/18/2026	added binary output `SW_OUTBINARY` for SOILWAT2-standalone
+	10/18/2026	added in-memory output `SW_OUTMEMORY` for SOILWAT2 as library
 */
 /********************************************************/
 /********************************************************/
@@ -42,13 +44,31 @@ extern "C" {
 #endif
 
 
+// Binary output: SOILWAT2-standalone compiled with `SW_OUTBINARY` writes
+// binary instead of text output files (see `SW_Output_outbinary.c`)
+#if defined(SW_OUTBINARY) && !defined(SOILWAT)
+#error "`SW_OUTBINARY` is only available for SOILWAT2-standalone."
+#endif
+
+// In-memory output: SOILWAT2 compiled with `SW_OUTMEMORY` keeps output in
+// arrays instead of writing files (see `SW_Output_outmemory.c`)
+#if defined(SW_OUTMEMORY) && !defined(SOILWAT)
+#error "`SW_OUTMEMORY` is only available for SOILWAT2-standalone."
+#endif
+
+#if defined(SW_OUTMEMORY) && defined(SW_OUTBINARY)
+#error "`SW_OUTMEMORY` and `SW_OUTBINARY` cannot be combined."
+#endif
+
 // Array-based output:
-#if defined(RSOILWAT) || defined(STEPWAT)
+#if defined(RSOILWAT) || defined(STEPWAT) || defined(SW_OUTBINARY) || \
+	defined(SW_OUTMEMORY)
 #define SW_OUTARRAY
 #endif
 
 // Text-based output:
-#if defined(SOILWAT) || defined(STEPWAT)
+#if (defined(SOILWAT) && !defined(SW_OUTBINARY) && !defined(SW_OUTMEMORY)) || \
+	defined(STEPWAT)
 #define SW_OUTTEXT
 #endif
 
@@ -166,7 +186,7 @@ typedef struct {
 	void (*pfunc_text)(OutPeriod); /* pointer to output routine for text output */
 	#endif
 
-	#if defined(RSOILWAT)
+	#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 	void (*pfunc_mem)(OutPeriod); /* pointer to output routine for array output */
 	char *outfile; /* name of output */ //could probably be removed
 
@@ -177,6 +197,70 @@ typedef struct {
 } SW_OUTPUT;
 
 
+/** @brief Accumulation plan of a simulation run: for each object type and
+      output period, the output keys that are summed and aggregated
+
+  The plan is compiled by `SW_OUT_compile_plan()` once output keys and their
+  output periods are known, so that `SW_OUT_sum_today()` loops only over
+  active output key x output period combinations.
+*/
+typedef struct {
+	OutKey key[eOUT][SW_OUTNPERIODS][SW_OUTNKEYS];
+	IntUS n[eOUT][SW_OUTNPERIODS];
+} SW_OUT_PLAN;
+
+
+/** @brief Streaming output sink: called with each completed row of output
+      key `k` and output period `pd`
+
+  @param k The output key.
+  @param pd The output period.
+  @param values The row: the time columns followed by the columns of the
+    output key, see `SW_OUT_get_colname()`; valid only during the call.
+  @param ncol Number of values including the time columns.
+  @param data The pointer that was passed to `SW_OUT_set_sink()`.
+*/
+typedef void (*SW_OUT_SINK)(OutKey k, OutPeriod pd, const RealD *values,
+	IntUS ncol, void *data);
+
+
+/** @brief Output state of a simulation run while it is not active;
+      see `SW_RUN`, `SW_OUT_store_run()`, and `SW_OUT_restore_run()`
+*/
+typedef struct {
+	SW_OUTPUT Output[SW_OUTNKEYS];
+	char sep;
+	TimeInt tOffset;
+	OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
+	IntUS used_OUTNPERIODS, ncol_OUT[SW_OUTNKEYS];
+	Bool use_OutPeriod[SW_OUTNPERIODS];
+	char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+	SW_OUT_PLAN plan;
+
+	#ifdef SW_OUTTEXT
+	Bool make_soil[SW_OUTNPERIODS], make_regular[SW_OUTNPERIODS],
+		print_IterationSummary, print_SW_Output;
+	FILE *fp_reg[SW_OUTNPERIODS], *fp_soil[SW_OUTNPERIODS];
+	char *iobuf_reg[SW_OUTNPERIODS], *iobuf_soil[SW_OUTNPERIODS];
+	#endif
+
+	#ifdef SW_OUTARRAY
+	RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+	size_t nrow_OUT[SW_OUTNPERIODS], irow_OUT[SW_OUTNPERIODS];
+	#endif
+
+	#ifdef SW_OUTBINARY
+	FILE *fp_bin[SW_OUTNPERIODS];
+	size_t nrow_bin[SW_OUTNPERIODS];
+	#endif
+
+	#ifdef SW_OUTMEMORY
+	SW_OUT_SINK sink;
+	void *sinkdata;
+	#endif
+} SW_OUT_RUN;
+
+
 /* convenience loops for consistency.
  * k must be a defined variable, either of OutKey type
  * or int (IntU is better).
@@ -191,6 +275,8 @@ typedef struct {
 // Function declarations
 void SW_OUT_construct(void);
 void SW_OUT_deconstruct(Bool full_reset);
+void SW_OUT_store_run(SW_OUT_RUN *r);
+void SW_OUT_restore_run(const SW_OUT_RUN *r);
 void SW_OUT_set_ncol(void);
 void SW_OUT_set_colnames(void);
 void SW_OUT_new_year(void);
@@ -205,6 +291,7 @@ void _collect_values(void);
 void _echo_outputs(void);
 
 void find_OutPeriods_inUse(void);
+void SW_OUT_compile_plan(void);
 Bool has_OutPeriod_inUse(OutPeriod pd, OutKey k);
 Bool has_keyname_soillayers(const char *var);
 Bool has_key_soillayers(OutKey k);
@@ -261,7 +348,7 @@ void get_co2effects_text(OutPeriod pd);
 void get_biomass_text(OutPeriod pd);
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 void get_temp_mem(OutPeriod pd);
 void get_precip_mem(OutPeriod pd);
 void get_vwcBulk_mem(OutPeriod pd);
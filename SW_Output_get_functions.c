@@ -9,6 +9,7 @@
   History:
   2018 June 04 (drs) moved output formatter `get_XXX` functions from
      `SW_Output.c` to dedicated `SW_Output_get_functions.c`
+  2026 Oct 18 daily output of swpMatric uses the cache of `SW_SWC_swp()`
 */
 /********************************************************/
 /********************************************************/
@@ -68,30 +69,30 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_SITE SW_Site;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_MODEL SW_Model;
-extern SW_WEATHER SW_Weather;
-extern SW_VEGPROD SW_VegProd;
-extern SW_VEGESTAB SW_VegEstab;
-extern SW_CARBON SW_Carbon;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS SW_CARBON SW_Carbon;
 
-extern IntUS ncol_OUT[];
+extern SW_TLS IntUS ncol_OUT[];
 
 #ifdef STEPWAT
 extern Bool prepare_IterationSummary;
 extern ModelType *Globals; // defined in `ST_Main.c`
 extern GlobalType SuperGlobals;
 extern SXW_t* SXW; // structure to store values in and pass back to STEPPE
-extern TimeInt tOffset; // defined in `SW_Output.c`
+extern SW_TLS TimeInt tOffset; // defined in `SW_Output.c`
 #endif
 
 // Text-based output: defined in `SW_Output_outtext.c`:
 #ifdef SW_OUTTEXT
-extern SW_FILE_STATUS SW_OutFiles;
-extern char _Sep;
-extern char sw_outstr[];
-extern Bool print_IterationSummary;
+extern SW_TLS SW_FILE_STATUS SW_OutFiles;
+extern SW_TLS char _Sep;
+extern SW_TLS char sw_outstr[];
+extern SW_TLS Bool print_IterationSummary;
 #endif
 #ifdef STEPWAT
 extern char sw_outstr_agg[];
@@ -100,10 +101,10 @@ extern char sw_outstr_agg[];
 
 // Array-based output: defined in `SW_Output_outarray.c`
 #ifdef SW_OUTARRAY
-extern RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+extern SW_TLS RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
 extern IntUS ncol_TimeOUT[];
-extern size_t nrow_OUT[];
-extern size_t irow_OUT[];
+extern SW_TLS size_t nrow_OUT[];
+extern SW_TLS size_t irow_OUT[];
 #endif
 #ifdef STEPWAT
 extern RealD *p_OUTsd[SW_OUTNKEYS][SW_OUTNPERIODS];
@@ -115,6 +116,12 @@ extern RealD *p_OUTsd[SW_OUTNKEYS][SW_OUTNPERIODS];
 /*             Private Function Declarations           */
 /* --------------------------------------------------- */
 
+#ifdef SW_OUTTEXT
+static char *_add_outvalue(char *s, RealD x);
+#endif
+
+static RealD _swpMatric(RealD swcBulk, LyrIndex n, OutPeriod pd);
+
 #ifdef STEPWAT
 static void format_IterationSummary(RealD *p, RealD *psd, OutPeriod pd,
 	IntUS N);
@@ -127,6 +134,41 @@ static void format_IterationSummary2(RealD *p, RealD *psd, OutPeriod pd,
 /*             Private Function Definitions            */
 /* --------------------------------------------------- */
 
+#ifdef SW_OUTTEXT
+/** @brief Append separator and `x` formatted with `OUT_DIGITS` decimal digits
+    to the output string
+
+  @param s Pointer to the end of the output string, e.g., `sw_outstr`.
+  @param x The value.
+
+  @return Pointer to the new end of the output string.
+*/
+static char *_add_outvalue(char *s, RealD x)
+{
+	*s++ = _Sep;
+	return Str_FromDouble(s, x, OUT_DIGITS);
+}
+#endif
+
+/** @brief Soil water potential of the n-th soil layer for output
+
+  Daily values are today's soil water content which SW_Water_Flow() has
+  usually converted already (see `SW_SWC_swp()`); values of longer periods
+  are averages that would only displace today's value from the cache.
+
+  @param swcBulk Soil water content (cm/layer).
+  @param n Layer number (base0).
+  @param pd Output period.
+
+  @return Soil water potential (-bar).
+*/
+static RealD _swpMatric(RealD swcBulk, LyrIndex n, OutPeriod pd)
+{
+	return (pd == eSW_Day) ?
+		SW_SWC_swp(swcBulk, n) :
+		SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], swcBulk, n);
+}
+
 #ifdef STEPWAT
 static void format_IterationSummary(RealD *p, RealD *psd, OutPeriod pd, IntUS N)
 {
@@ -202,25 +244,21 @@ void get_co2effects_text(OutPeriod pd) {
 	int k;
 	SW_VEGPROD *v = &SW_VegProd;
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	if (pd) {} // hack to silence "-Wunused-parameter"
 
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS,
-			v->veg[k].co2_multipliers[BIO_INDEX][SW_Model.simyear]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, v->veg[k].co2_multipliers[BIO_INDEX][SW_Model.simyear]);
 	}
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS,
-			v->veg[k].co2_multipliers[WUE_INDEX][SW_Model.simyear]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, v->veg[k].co2_multipliers[WUE_INDEX][SW_Model.simyear]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 void get_co2effects_mem(OutPeriod pd) {
 	int k;
 	SW_VEGPROD *v = &SW_VegProd;
@@ -277,40 +315,31 @@ void get_biomass_text(OutPeriod pd) {
 		biolive_total += vo->veg[k].biolive * v->veg[k].cov.fCover;
 	}
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	// fCover for NVEGTYPES plus bare-ground
-	sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, v->bare_cov.fCover);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, v->bare_cov.fCover);
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, v->veg[k].cov.fCover);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, v->veg[k].cov.fCover);
 	}
 
 	// biomass (g/m2 as component of total) for NVEGTYPES plus totals and litter
-	sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, biomass_total);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, biomass_total);
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS,
-			vo->veg[k].biomass * v->veg[k].cov.fCover);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->veg[k].biomass * v->veg[k].cov.fCover);
 	}
-	sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, litter_total);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, litter_total);
 
 	// biolive (g/m2 as component of total) for NVEGTYPES plus totals
-	sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, biolive_total);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, biolive_total);
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS,
-			vo->veg[k].biolive * v->veg[k].cov.fCover);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->veg[k].biolive * v->veg[k].cov.fCover);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 void get_biomass_mem(OutPeriod pd) {
 	int k, i;
 	RealD biomass_total = 0., litter_total = 0., biolive_total = 0.;
@@ -442,7 +471,7 @@ void get_estab_text(OutPeriod pd)
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 /**
 @brief The establishment check produces, for each species in the given set,
 			a day of year >= 0 that the species established itself in the current year.
@@ -513,16 +542,16 @@ void get_temp_text(OutPeriod pd)
 {
 	SW_WEATHER_OUTPUTS *vo = SW_Weather.p_oagg[pd];
 
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f%c%.*f%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, vo->temp_max,
-		_Sep, OUT_DIGITS, vo->temp_min,
-		_Sep, OUT_DIGITS, vo->temp_avg,
-		_Sep, OUT_DIGITS, vo->surfaceTemp);
+	s = _add_outvalue(s, vo->temp_max);
+	s = _add_outvalue(s, vo->temp_min);
+	s = _add_outvalue(s, vo->temp_avg);
+	s = _add_outvalue(s, vo->surfaceTemp);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets temp text from SW_WEATHER_OUTPUTS when dealing with RSOILWAT.
@@ -601,17 +630,17 @@ void get_precip_text(OutPeriod pd)
 {
 	SW_WEATHER_OUTPUTS *vo = SW_Weather.p_oagg[pd];
 
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f%c%.*f%c%.*f%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, vo->ppt,
-		_Sep, OUT_DIGITS, vo->rain,
-		_Sep, OUT_DIGITS, vo->snow,
-		_Sep, OUT_DIGITS, vo->snowmelt,
-		_Sep, OUT_DIGITS, vo->snowloss);
+	s = _add_outvalue(s, vo->ppt);
+	s = _add_outvalue(s, vo->rain);
+	s = _add_outvalue(s, vo->snow);
+	s = _add_outvalue(s, vo->snowmelt);
+	s = _add_outvalue(s, vo->snowloss);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets precipitation text from SW_WEATHER_OUTPUTS when dealing with RSOILWAT.
@@ -692,19 +721,17 @@ void get_vwcBulk_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i) {
 		/* vwcBulk at this point is identical to swcBulk */
-		sprintf(str, "%c%.*f",
-			_Sep, OUT_DIGITS, vo->vwcBulk[i] / SW_Site.lyr[i]->width);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->vwcBulk[i] / SW_Site.width[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets vwcBulk text from SW_SOILWAT_OUTPUTS when dealing with RSOILWAT.
@@ -721,7 +748,7 @@ void get_vwcBulk_mem(OutPeriod pd)
 
 	ForEachSoilLayer(i) {
 		/* vwcBulk at this point is identical to swcBulk */
-		p[iOUT(i, pd)] = vo->vwcBulk[i] / SW_Site.lyr[i]->width;
+		p[iOUT(i, pd)] = vo->vwcBulk[i] / SW_Site.width[i];
 	}
 }
 
@@ -744,7 +771,7 @@ void get_vwcBulk_agg(OutPeriod pd)
 	ForEachSoilLayer(i) {
 		/* vwcBulk at this point is identical to swcBulk */
 		do_running_agg(p, psd, iOUT(i, pd), Globals->currIter,
-			vo->vwcBulk[i] / SW_Site.lyr[i]->width);
+			vo->vwcBulk[i] / SW_Site.width[i]);
 	}
 
 	if (print_IterationSummary) {
@@ -769,21 +796,19 @@ void get_vwcMatric_text(OutPeriod pd)
 	RealD convert;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i) {
 		/* vwcMatric at this point is identical to swcBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel) / SW_Site.lyr[i]->width;
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]) / SW_Site.width[i];
 
-		sprintf(str, "%c%.*f",
-			_Sep, OUT_DIGITS, vo->vwcMatric[i] * convert);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->vwcMatric[i] * convert);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets vwcMatric text from SW_SOILWAT_OUTPUTS when dealing with RSOILWAT.
@@ -801,7 +826,7 @@ void get_vwcMatric_mem(OutPeriod pd)
 
 	ForEachSoilLayer(i) {
 		/* vwcMatric at this point is identical to swcBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel) / SW_Site.lyr[i]->width;
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]) / SW_Site.width[i];
 		p[iOUT(i, pd)] = vo->vwcMatric[i] * convert;
 	}
 }
@@ -825,7 +850,7 @@ void get_vwcMatric_agg(OutPeriod pd)
 
 	ForEachSoilLayer(i) {
 		/* vwcMatric at this point is identical to swcBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel) / SW_Site.lyr[i]->width;
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]) / SW_Site.width[i];
 
 		do_running_agg(p, psd, iOUT(i, pd), Globals->currIter,
 			vo->vwcMatric[i] * convert);
@@ -854,21 +879,20 @@ void get_swa_text(OutPeriod pd)
 	int k;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachVegType(k)
 	{
 		ForEachSoilLayer(i)
 		{
-			sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->SWA_VegType[k][i]);
-			strcat(sw_outstr, str);
+			s = _add_outvalue(s, vo->SWA_VegType[k][i]);
 		}
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets SWA text from SW_SOILWAT_OUTPUTS when dealing with RSOILWAT.
@@ -940,18 +964,17 @@ void get_swcBulk_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->swcBulk[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->swcBulk[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets swcBulk text from SW_SOILWAT_OUTPUTS when dealing with RSOILWAT.
@@ -1036,22 +1059,20 @@ void get_swpMatric_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i)
 	{
 		/* swpMatric at this point is identical to swcBulk */
-		val = SW_SWCbulk2SWPmatric(SW_Site.lyr[i]->fractionVolBulk_gravel,
-			vo->swpMatric[i], i);
+		val = _swpMatric(vo->swpMatric[i], i, pd);
 
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, val);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, val);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets swpMatric when dealing with RSOILWAT
@@ -1069,8 +1090,7 @@ void get_swpMatric_mem(OutPeriod pd)
 	ForEachSoilLayer(i)
 	{
 		/* swpMatric at this point is identical to swcBulk */
-		p[iOUT(i, pd)] = SW_SWCbulk2SWPmatric(
-			SW_Site.lyr[i]->fractionVolBulk_gravel, vo->swpMatric[i], i);
+		p[iOUT(i, pd)] = _swpMatric(vo->swpMatric[i], i, pd);
 	}
 }
 
@@ -1094,8 +1114,7 @@ void get_swpMatric_agg(OutPeriod pd)
 	ForEachSoilLayer(i)
 	{
 		/* swpMatric at this point is identical to swcBulk */
-		val = SW_SWCbulk2SWPmatric(
-			SW_Site.lyr[i]->fractionVolBulk_gravel, vo->swpMatric[i], i);
+		val = _swpMatric(vo->swpMatric[i], i, pd);
 		do_running_agg(p, psd, iOUT(i, pd), Globals->currIter, val);
 	}
 
@@ -1120,18 +1139,17 @@ void get_swaBulk_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->swaBulk[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->swaBulk[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets swaBulk when dealing with RSOILWAT.
@@ -1194,21 +1212,20 @@ void get_swaMatric_text(OutPeriod pd)
 	RealD convert;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i)
 	{
 		/* swaMatric at this point is identical to swaBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel);
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]);
 
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->swaMatric[i] * convert);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->swaMatric[i] * convert);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets swaMatric when dealing with RSOILWAT.
@@ -1227,7 +1244,7 @@ void get_swaMatric_mem(OutPeriod pd)
 	ForEachSoilLayer(i)
 	{
 		/* swaMatric at this point is identical to swaBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel);
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]);
 		p[iOUT(i, pd)] = vo->swaMatric[i] * convert;
 	}
 }
@@ -1252,7 +1269,7 @@ void get_swaMatric_agg(OutPeriod pd)
 	ForEachSoilLayer(i)
 	{
 		/* swaMatric at this point is identical to swaBulk */
-		convert = 1. / (1. - SW_Site.lyr[i]->fractionVolBulk_gravel);
+		convert = 1. / (1. - SW_Site.fractionVolBulk_gravel[i]);
 		do_running_agg(p, psd, iOUT(i, pd), Globals->currIter,
 			vo->swaMatric[i] * convert);
 	}
@@ -1278,11 +1295,11 @@ void get_surfaceWater_text(OutPeriod pd)
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->surfaceWater);
+	_add_outvalue(sw_outstr, vo->surfaceWater);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets surfaceWater when dealing with RSOILWAT.
@@ -1339,16 +1356,16 @@ void get_runoffrunon_text(OutPeriod pd)
 
 	net = vo->surfaceRunoff + vo->snowRunoff - vo->surfaceRunon;
 
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f%c%.*f%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, net,
-		_Sep, OUT_DIGITS, vo->surfaceRunoff,
-		_Sep, OUT_DIGITS, vo->snowRunoff,
-		_Sep, OUT_DIGITS, vo->surfaceRunon);
+	s = _add_outvalue(s, net);
+	s = _add_outvalue(s, vo->surfaceRunoff);
+	s = _add_outvalue(s, vo->snowRunoff);
+	s = _add_outvalue(s, vo->surfaceRunon);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets surfaceRunon, surfaceRunoff, and snowRunoff when dealing with RSOILWAT.
@@ -1415,14 +1432,13 @@ void get_transp_text(OutPeriod pd)
 	int k;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	/* total transpiration */
 	ForEachSoilLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->transp_total[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->transp_total[i]);
 	}
 
 	/* transpiration for each vegetation type */
@@ -1430,14 +1446,13 @@ void get_transp_text(OutPeriod pd)
 	{
 		ForEachSoilLayer(i)
 		{
-			sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->transp[k][i]);
-			strcat(sw_outstr, str);
+			s = _add_outvalue(s, vo->transp[k][i]);
 		}
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets transp_total when dealing with RSOILWAT.
@@ -1558,18 +1573,17 @@ void get_evapSoil_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachEvapLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->evap[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->evap[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets evap when dealing with RSOILWAT.
@@ -1632,24 +1646,21 @@ void get_evapSurface_text(OutPeriod pd)
 	int k;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->total_evap);
+	s = _add_outvalue(s, vo->total_evap);
 
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->evap_veg[k]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->evap_veg[k]);
 	}
 
-	sprintf(str, "%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, vo->litter_evap,
-		_Sep, OUT_DIGITS, vo->surfaceWater_evap);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, vo->litter_evap);
+	s = _add_outvalue(s, vo->surfaceWater_evap);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets evapSurface when dealing with RSOILWAT.
@@ -1722,22 +1733,20 @@ void get_interception_text(OutPeriod pd)
 	int k;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->total_int);
+	s = _add_outvalue(s, vo->total_int);
 
 	ForEachVegType(k) {
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->int_veg[k]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->int_veg[k]);
 	}
 
-	sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->litter_int);
-	strcat(sw_outstr, str);
+	s = _add_outvalue(s, vo->litter_int);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets total_int, int_veg, and litter_int when dealing with RSOILWAT.
@@ -1809,11 +1818,11 @@ void get_soilinf_text(OutPeriod pd)
 	SW_WEATHER_OUTPUTS *vo = SW_Weather.p_oagg[pd];
 
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->soil_inf);
+	_add_outvalue(sw_outstr, vo->soil_inf);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets soil_inf when dealing with RSOILWAT.
@@ -1869,18 +1878,17 @@ void get_lyrdrain_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	for (i = 0; i < SW_Site.n_layers - 1; i++)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->lyrdrain[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->lyrdrain[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets lyrdrain when dealing with RSOILWAT.
@@ -1945,14 +1953,13 @@ void get_hydred_text(OutPeriod pd)
 	int k;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	/* total hydraulic redistribution */
 	ForEachSoilLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->hydred_total[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->hydred_total[i]);
 	}
 
 	/* hydraulic redistribution for each vegetation type */
@@ -1960,14 +1967,13 @@ void get_hydred_text(OutPeriod pd)
 	{
 		ForEachSoilLayer(i)
 		{
-			sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->hydred[k][i]);
-			strcat(sw_outstr, str);
+			s = _add_outvalue(s, vo->hydred[k][i]);
 		}
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets hydred and hydred_total when dealing with RSOILWAT.
@@ -2058,11 +2064,11 @@ void get_aet_text(OutPeriod pd)
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->aet);
+	_add_outvalue(sw_outstr, vo->aet);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets actual evapotranspiration when dealing with OUTTEXT.
@@ -2131,20 +2137,17 @@ void get_pet_text(OutPeriod pd)
 {
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
-	sprintf(
-		sw_outstr,
-		"%c%.*f%c%.*f%c%.*f%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, vo->pet,
-		_Sep, OUT_DIGITS, vo->H_oh,
-		_Sep, OUT_DIGITS, vo->H_ot,
-		_Sep, OUT_DIGITS, vo->H_gh,
-		_Sep, OUT_DIGITS, vo->H_gt
-	);
+	s = _add_outvalue(s, vo->pet);
+	s = _add_outvalue(s, vo->H_oh);
+	s = _add_outvalue(s, vo->H_ot);
+	s = _add_outvalue(s, vo->H_gh);
+	s = _add_outvalue(s, vo->H_gt);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets potential evapotranspiration and radiation
@@ -2228,7 +2231,7 @@ void get_wetdays_text(OutPeriod pd)
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets is_wet and wetdays when dealing with RSOILWAT.
@@ -2309,14 +2312,14 @@ void get_snowpack_text(OutPeriod pd)
 {
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f%c%.*f",
-		_Sep, OUT_DIGITS, vo->snowpack,
-		_Sep, OUT_DIGITS, vo->snowdepth);
+	s = _add_outvalue(s, vo->snowpack);
+	s = _add_outvalue(s, vo->snowdepth);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets snowpack and snowdepth when dealing with OUTTEXT.
@@ -2373,11 +2376,11 @@ void get_deepswc_text(OutPeriod pd)
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
 	sw_outstr[0] = '\0';
-	sprintf(sw_outstr, "%c%.*f", _Sep, OUT_DIGITS, vo->deep);
+	_add_outvalue(sw_outstr, vo->deep);
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets deep for when dealing with RSOILWAT.
@@ -2432,18 +2435,17 @@ void get_soiltemp_text(OutPeriod pd)
 	LyrIndex i;
 	SW_SOILWAT_OUTPUTS *vo = SW_Soilwat.p_oagg[pd];
 
-	char str[OUTSTRLEN];
+	char *s = sw_outstr;
 	sw_outstr[0] = '\0';
 
 	ForEachSoilLayer(i)
 	{
-		sprintf(str, "%c%.*f", _Sep, OUT_DIGITS, vo->sTemp[i]);
-		strcat(sw_outstr, str);
+		s = _add_outvalue(s, vo->sTemp[i]);
 	}
 }
 #endif
 
-#if defined(RSOILWAT)
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 
 /**
 @brief Gets soil temperature for when dealing with RSOILWAT.
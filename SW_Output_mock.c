@@ -35,39 +35,39 @@
 #include "SW_VegProd.h"
 
 // Global Variables
-extern SW_SITE SW_Site;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_MODEL SW_Model;
-extern SW_WEATHER SW_Weather;
-extern SW_VEGPROD SW_VegProd;
-extern SW_VEGESTAB SW_VegEstab;
-extern Bool EchoInits;
-extern SW_CARBON SW_Carbon;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS Bool EchoInits;
+extern SW_TLS SW_CARBON SW_Carbon;
 
 // Copy-paste from SW_Output.c (lines 81-103)
-SW_OUTPUT SW_Output[SW_OUTNKEYS];
+SW_TLS SW_OUTPUT SW_Output[SW_OUTNKEYS];
 
-char _Sep; /* output delimiter */
-TimeInt tOffset; /* 1 or 0 means we're writing previous or current period */
+SW_TLS char _Sep; /* output delimiter */
+SW_TLS TimeInt tOffset; /* 1 or 0 means we're writing previous or current period */
 
 
 // Global variables describing output periods:
 /** `timeSteps` is the array that keeps track of the output time periods that
     are required for `text` and/or `array`-based output for each output key. */
-OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
+SW_TLS OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
 /** The number of different time steps/periods that are used/requested
 		Note: Under STEPWAT2, this may be larger than the sum of `use_OutPeriod`
 			because it also incorporates information from `timeSteps_SXW`. */
-IntUS used_OUTNPERIODS;
+SW_TLS IntUS used_OUTNPERIODS;
 /** TRUE if time step/period is active for any output key. */
-Bool use_OutPeriod[SW_OUTNPERIODS];
+SW_TLS Bool use_OutPeriod[SW_OUTNPERIODS];
 
 
 // Global variables describing size and names of output
 /** names of output columns for each output key; number is an expensive guess */
-char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+SW_TLS char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
 /** number of output columns for each output key */
-IntUS ncol_OUT[SW_OUTNKEYS];
+SW_TLS IntUS ncol_OUT[SW_OUTNKEYS];
 
 
 
@@ -95,6 +95,30 @@ void SW_OUT_deconstruct(Bool full_reset)
 	if (full_reset) {}
 }
 
+void SW_OUT_store_run(SW_OUT_RUN *r)
+{
+	memcpy(r->Output, SW_Output, sizeof SW_Output);
+	r->sep = _Sep;
+	r->tOffset = tOffset;
+	memcpy(r->timeSteps, timeSteps, sizeof timeSteps);
+	r->used_OUTNPERIODS = used_OUTNPERIODS;
+	memcpy(r->ncol_OUT, ncol_OUT, sizeof ncol_OUT);
+	memcpy(r->use_OutPeriod, use_OutPeriod, sizeof use_OutPeriod);
+	memcpy(r->colnames_OUT, colnames_OUT, sizeof colnames_OUT);
+}
+
+void SW_OUT_restore_run(const SW_OUT_RUN *r)
+{
+	memcpy(SW_Output, r->Output, sizeof SW_Output);
+	_Sep = r->sep;
+	tOffset = r->tOffset;
+	memcpy(timeSteps, r->timeSteps, sizeof timeSteps);
+	used_OUTNPERIODS = r->used_OUTNPERIODS;
+	memcpy(ncol_OUT, r->ncol_OUT, sizeof ncol_OUT);
+	memcpy(use_OutPeriod, r->use_OutPeriod, sizeof use_OutPeriod);
+	memcpy(colnames_OUT, r->colnames_OUT, sizeof colnames_OUT);
+}
+
 void SW_OUT_new_year(void)
 {}
 
@@ -37,18 +37,20 @@
 #endif
 
 
+#ifdef SW_OUTARRAY
+
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
+extern SW_TLS SW_MODEL SW_Model;
 
 // defined in `SW_Output.c`:
-extern SW_OUTPUT SW_Output[];
-extern TimeInt tOffset;
-extern Bool use_OutPeriod[];
-extern IntUS used_OUTNPERIODS;
-extern IntUS ncol_OUT[];
-extern OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
+extern SW_TLS SW_OUTPUT SW_Output[];
+extern SW_TLS TimeInt tOffset;
+extern SW_TLS Bool use_OutPeriod[];
+extern SW_TLS IntUS used_OUTNPERIODS;
+extern SW_TLS IntUS ncol_OUT[];
+extern SW_TLS OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
 
 
 // defined here:
@@ -61,7 +63,7 @@ extern OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
   The variable p_OUT used by rSOILWAT2 for output and by STEPWAT2 for
   mean aggregation.
 */
-RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+SW_TLS RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
 
 /** \brief A 2-dim array of pointers to output arrays of standard deviations.
 
@@ -87,8 +89,8 @@ RealD *p_OUTsd[SW_OUTNKEYS][SW_OUTNPERIODS];
 Bool prepare_IterationSummary;
 #endif
 
-size_t nrow_OUT[SW_OUTNPERIODS]; // number of years/months/weeks/days
-size_t irow_OUT[SW_OUTNPERIODS]; // row index of current year/month/week/day output; incremented at end of each day
+SW_TLS size_t nrow_OUT[SW_OUTNPERIODS]; // number of years/months/weeks/days
+SW_TLS size_t irow_OUT[SW_OUTNPERIODS]; // row index of current year/month/week/day output; incremented at end of each day
 const IntUS ncol_TimeOUT[SW_OUTNPERIODS] = { 2, 2, 2, 1 }; // number of time header columns for each output period
 
 
@@ -196,7 +198,7 @@ void SW_OUT_deconstruct_outarray(void)
 }
 
 
-#ifdef RSOILWAT
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 /** @brief Corresponds to function `get_outstrleader` of `SOILWAT2-standalone`
 */
 void get_outvalleader(RealD *p, OutPeriod pd) {
@@ -271,3 +273,5 @@ void setGlobalSTEPWAT2_OutputVariables(void)
 }
 
 #endif
+
+#endif
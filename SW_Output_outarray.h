@@ -5,7 +5,8 @@
   Purpose: Support for SW_Output_outarray.c
   Application: SOILWAT - soilwater dynamics simulator
   Purpose: define functions to deal with array outputs; currently, used
-    by rSOILWAT2 and STEPWAT2
+    by rSOILWAT2, STEPWAT2, and SOILWAT2 with `SW_OUTBINARY` or
+    `SW_OUTMEMORY`
 
   History:
   2018 June 15 (drs) moved functions from `SW_Output.c`
@@ -43,7 +44,7 @@ extern "C" {
 void SW_OUT_set_nrow(void);
 void SW_OUT_deconstruct_outarray(void);
 
-#ifdef RSOILWAT
+#if defined(RSOILWAT) || defined(SW_OUTBINARY) || defined(SW_OUTMEMORY)
 void get_outvalleader(RealD *p, OutPeriod pd);
 #endif
 
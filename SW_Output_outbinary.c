@@ -0,0 +1,280 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Output functionality for binary, columnar output files of
+  SOILWAT2-standalone compiled with `SW_OUTBINARY`
+
+  Values are formatted by the array-based output functions `get_XXX_mem`
+  into the output arrays `p_OUT` which hold a block of
+  `SW_OUTBINARY_NROWS` rows per output period; full blocks are appended
+  to one binary file per output period, see `SW_OUTBINARY_HEADER`.
+  No text formatting takes place, and values are stored at full precision.
+
+  See the \ref out_algo "output algorithm documentation" for details.
+
+  History:
+  10/18/2026	INITIAL CODING
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
+
+#include "SW_Defines.h"
+#include "SW_Files.h"
+
+#include "SW_Output.h"
+#include "SW_Output_outarray.h"
+#include "SW_Output_outbinary.h"
+
+
+#ifdef SW_OUTBINARY
+
+/* =================================================== */
+/*                  Global Variables                   */
+/* --------------------------------------------------- */
+
+// defined in `SW_Output.c`
+extern SW_TLS SW_OUTPUT SW_Output[];
+extern SW_TLS Bool use_OutPeriod[];
+extern SW_TLS char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+extern SW_TLS IntUS ncol_OUT[];
+
+extern char const *key2str[];
+extern char const *pd2longstr[];
+
+// defined in `SW_Output_outarray.c`
+extern const IntUS ncol_TimeOUT[];
+extern SW_TLS size_t nrow_OUT[];
+extern SW_TLS size_t irow_OUT[];
+extern SW_TLS RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+
+
+// defined here:
+
+/** Binary output file of each output period */
+SW_TLS FILE *fp_bin[SW_OUTNPERIODS];
+
+/** Number of rows written to the binary output file of each output period */
+SW_TLS size_t nrow_bin[SW_OUTNPERIODS];
+
+
+
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+static Bool _has_key(OutKey k, OutPeriod pd) {
+	return (Bool) (SW_Output[k].use && has_OutPeriod_inUse(pd, k));
+}
+
+static void _write(const void *x, size_t size, size_t n, OutPeriod pd) {
+	if (fwrite(x, size, n, fp_bin[pd]) != n) {
+		LogError(logfp, LOGFATAL, "Cannot write %s binary output.",
+			pd2longstr[pd]);
+	}
+}
+
+static void _write_uint32(uint32_t x, OutPeriod pd) {
+	_write(&x, sizeof x, 1, pd);
+}
+
+static void _write_name(const char *name, OutPeriod pd) {
+	uint32_t n = (uint32_t) strlen(name);
+
+	_write_uint32(n, pd);
+	_write(name, 1, n, pd);
+}
+
+/** @brief Replace the file extension of the text output file of period `pd`
+    with `SW_OUTBINARY_EXT`
+*/
+static void _binary_filename(OutPeriod pd, char *fname) {
+	char *ext, *sep;
+
+	// PROGRAMMER Note: see `_create_csv_files` for `eOutputDaily + pd`
+	strcpy(fname, SW_F_name(eOutputDaily + pd));
+
+	ext = strrchr(fname, '.');
+	sep = strrchr(fname, '/');
+	if (isnull(ext) || (!isnull(sep) && ext < sep)) {
+		ext = fname + strlen(fname);
+	}
+
+	strcpy(ext, SW_OUTBINARY_EXT);
+}
+
+static void _write_header(OutPeriod pd) {
+	SW_OUTBINARY_HEADER h;
+	OutKey k;
+	IntUS i;
+
+	memset(&h, 0, sizeof h);
+	strcpy(h.magic, SW_OUTBINARY_MAGIC);
+	h.version = SW_OUTBINARY_VERSION;
+	h.byteorder = SW_OUTBINARY_BYTEORDER;
+	h.size_real = sizeof(RealD);
+	h.period = pd;
+	h.ncol_time = ncol_TimeOUT[pd];
+
+	ForEachOutKey(k) {
+		if (_has_key(k, pd)) {
+			h.n_keys++;
+		}
+	}
+
+	_write(&h, sizeof h, 1, pd);
+
+	// names of time columns match the header of the text output
+	_write_name("Year", pd);
+	if (pd != eSW_Year) {
+		_write_name(pd2longstr[pd], pd);
+	}
+
+	ForEachOutKey(k) {
+		if (!_has_key(k, pd)) {
+			continue;
+		}
+
+		_write_uint32(k, pd);
+		_write_uint32(ncol_OUT[k], pd);
+		_write_name(key2str[k], pd);
+
+		for (i = 0; i < ncol_OUT[k]; i++) {
+			_write_name(colnames_OUT[k][i], pd);
+		}
+	}
+}
+
+
+
+/* =================================================== */
+/*             Function Definitions                    */
+/*             (declared in SW_Output_outbinary.h)     */
+/* --------------------------------------------------- */
+
+/** @brief Create binary output files and allocate output arrays that
+    hold one block of rows for each output period in use.
+
+    @note Call this routine after `SW_OUT_set_ncol()` and
+    `SW_OUT_set_colnames()`.
+*/
+void SW_OUT_create_files(void) {
+	char fname[MAX_FILENAMESIZE];
+	OutPeriod pd;
+	OutKey k;
+
+	ForEachOutPeriod(pd) {
+		nrow_OUT[pd] = 0;
+		irow_OUT[pd] = 0;
+		nrow_bin[pd] = 0;
+
+		if (!use_OutPeriod[pd]) {
+			continue;
+		}
+
+		nrow_OUT[pd] = SW_OUTBINARY_NROWS;
+
+		ForEachOutKey(k) {
+			if (_has_key(k, pd)) {
+				p_OUT[k][pd] = (RealD *) Mem_Calloc(
+					nrow_OUT[pd] * (ncol_OUT[k] + ncol_TimeOUT[pd]),
+					sizeof(RealD), "SW_OUT_create_files()");
+			}
+		}
+
+		_binary_filename(pd, fname);
+		fp_bin[pd] = OpenFile(fname, "wb");
+		_write_header(pd);
+	}
+}
+
+
+/** @brief Append the buffered rows of output period `pd` as one block to
+    its binary output file and empty the output arrays
+
+    Called by `SW_OUT_write_today()` when a block is full and by
+    `SW_OUT_close_files()`.
+
+    @param pd The output period.
+*/
+void SW_OUT_write_binary(OutPeriod pd) {
+	size_t n = irow_OUT[pd];
+	IntUS i;
+	OutKey k;
+	Bool has_time = swFALSE;
+
+	if (n == 0) {
+		return;
+	}
+
+	_write_uint32((uint32_t) n, pd);
+
+	ForEachOutKey(k) {
+		if (!_has_key(k, pd)) {
+			continue;
+		}
+
+		// every output array holds the time columns; write them once
+		if (!has_time) {
+			for (i = 0; i < ncol_TimeOUT[pd]; i++) {
+				_write(p_OUT[k][pd] + nrow_OUT[pd] * i, sizeof(RealD), n, pd);
+			}
+			has_time = swTRUE;
+		}
+
+		for (i = 0; i < ncol_OUT[k]; i++) {
+			_write(p_OUT[k][pd] + nrow_OUT[pd] * (ncol_TimeOUT[pd] + i),
+				sizeof(RealD), n, pd);
+		}
+	}
+
+	nrow_bin[pd] += n;
+	irow_OUT[pd] = 0;
+}
+
+
+/** @brief Write remaining rows, complete the headers, and close the binary
+    output files; free the output arrays.
+
+    Call this routine at the end of the program run.
+*/
+void SW_OUT_close_files(void) {
+	OutPeriod pd;
+	uint64_t n;
+
+	ForEachOutPeriod(pd) {
+		if (!use_OutPeriod[pd] || isnull(fp_bin[pd])) {
+			continue;
+		}
+
+		SW_OUT_write_binary(pd);
+
+		n = nrow_bin[pd];
+		if (fseek(fp_bin[pd], offsetof(SW_OUTBINARY_HEADER, n_rows), SEEK_SET)) {
+			LogError(logfp, LOGFATAL, "Cannot complete %s binary output.",
+				pd2longstr[pd]);
+		}
+		_write(&n, sizeof n, 1, pd);
+
+		CloseFile(&fp_bin[pd]);
+		nrow_OUT[pd] = 0;
+	}
+
+	SW_OUT_deconstruct_outarray();
+}
+
+#endif
@@ -0,0 +1,69 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Output_outbinary.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Output_outbinary.c: binary, columnar output files
+    of SOILWAT2-standalone compiled with `SW_OUTBINARY`
+
+  History:
+  10/18/2026	INITIAL CODING
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_OUTPUT_BINARY_H
+#define SW_OUTPUT_BINARY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define SW_OUTBINARY_EXT ".sw2o" /**< File extension of a binary output file */
+#define SW_OUTBINARY_MAGIC "SW2OUTB" /**< Identifies a binary output file */
+#define SW_OUTBINARY_VERSION 1 /**< Version of the file format */
+#define SW_OUTBINARY_BYTEORDER 0x01020304 /**< Detects foreign byte order */
+#define SW_OUTBINARY_NROWS 1024 /**< Number of rows that are buffered per block */
+
+
+/** Header of a binary output file (one file per output period)
+
+  The file layout is
+    - header
+    - names of the time columns: `ncol_time` x name
+    - for each output key: key id (`uint32_t`), number of columns
+      (`uint32_t`), key name, and `ncol` x column name
+    - blocks of rows until the end of the file: number of rows `n`
+      (`uint32_t`), then the time columns and the columns of each output key
+      in the order of the header, each as `n` values of `RealD`
+
+  A name is stored as its length (`uint32_t`) followed by its characters
+  (without `\0`). All values are in native byte order.
+*/
+typedef struct {
+	char magic[8];
+	uint32_t
+		version,
+		byteorder,
+		size_real, /**< `sizeof(RealD)` of the writing platform */
+		period, /**< Output period, see `OutPeriod` */
+		n_keys, /**< Number of output keys that are stored */
+		ncol_time; /**< Number of time columns, see `ncol_TimeOUT` */
+	uint64_t n_rows; /**< Total number of rows; updated when file is closed */
+} SW_OUTBINARY_HEADER;
+
+
+// Function declarations
+void SW_OUT_create_files(void);
+void SW_OUT_write_binary(OutPeriod pd);
+void SW_OUT_close_files(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,250 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Output functionality for in-memory output arrays of SOILWAT2
+  compiled with `SW_OUTMEMORY`
+
+  Values are formatted by the array-based output functions `get_XXX_mem`
+  into the output arrays `p_OUT` which are allocated for all rows of the
+  simulation period (see `SW_OUT_set_nrow()`); no files are written.
+  Alternatively, if a streaming output sink is set (see `SW_OUT_set_sink()`),
+  then the output arrays hold only the current row, and each completed row
+  is passed to the sink; memory use does then not depend on the length of
+  the simulation period.
+  This is meant for programs that link the SOILWAT2 library and use the
+  output directly, for instance,
+
+    SW_CTL_setup_model(NULL, firstfile);
+    SW_CTL_read_inputs_from_disk(NULL);
+    SW_CTL_init_run(NULL);
+    SW_OUT_set_ncol();
+    SW_OUT_set_colnames();
+    SW_OUT_create_files(); // allocate output arrays
+    SW_CTL_main(NULL);
+    p = SW_OUT_get_array(eSW_Temp, eSW_Day, &nrow, &ncol);
+    ... // use `p` and `SW_OUT_get_colname()`
+    SW_OUT_close_files(); // free output arrays
+    SW_CTL_clear_model(NULL, swTRUE);
+
+  See the \ref out_algo "output algorithm documentation" for details.
+
+  History:
+  10/18/2026	INITIAL CODING
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
+
+#include "SW_Defines.h"
+
+#include "SW_Output.h"
+#include "SW_Output_outarray.h"
+#include "SW_Output_outmemory.h"
+
+
+#ifdef SW_OUTMEMORY
+
+/* =================================================== */
+/*                  Global Variables                   */
+/* --------------------------------------------------- */
+
+// defined in `SW_Output.c`
+extern SW_TLS SW_OUTPUT SW_Output[];
+extern SW_TLS char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+extern SW_TLS IntUS ncol_OUT[];
+
+extern char const *pd2longstr[];
+
+// defined in `SW_Output_outarray.c`
+extern const IntUS ncol_TimeOUT[];
+extern SW_TLS size_t nrow_OUT[];
+extern SW_TLS size_t irow_OUT[];
+extern SW_TLS RealD *p_OUT[SW_OUTNKEYS][SW_OUTNPERIODS];
+
+
+// defined here:
+
+/** Streaming output sink of the thread; NULL if output rows are kept in
+    the output arrays */
+SW_TLS SW_OUT_SINK sink_OUT;
+
+/** Pointer that is passed to each call of `sink_OUT` */
+SW_TLS void *sinkdata_OUT;
+
+
+
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+static Bool _has_key(OutKey k, OutPeriod pd) {
+	return (Bool) (SW_Output[k].use && has_OutPeriod_inUse(pd, k));
+}
+
+static Bool _is_valid(OutKey k, OutPeriod pd) {
+	return (Bool) (k > eSW_NoKey && k < eSW_LastKey && pd < SW_OUTNPERIODS);
+}
+
+
+
+/* =================================================== */
+/*             Function Definitions                    */
+/*             (declared in SW_Output_outmemory.h)     */
+/* --------------------------------------------------- */
+
+/** @brief Set the streaming output sink of the calling thread
+
+    @param sink The function that receives each completed output row;
+      NULL to keep all rows in the output arrays.
+    @param data A pointer that is passed to each call of `sink`.
+
+    @note Call this routine before `SW_OUT_create_files()`.
+*/
+void SW_OUT_set_sink(SW_OUT_SINK sink, void *data) {
+	sink_OUT = sink;
+	sinkdata_OUT = data;
+}
+
+
+/** @brief Pass the completed row of output period `pd` of each output key
+    to the streaming output sink and empty the output arrays
+
+    Called by `SW_OUT_write_today()` if a sink is set.
+
+    @param pd The output period.
+*/
+void SW_OUT_write_sink(OutPeriod pd) {
+	OutKey k;
+
+	ForEachOutKey(k) {
+		if (!isnull(p_OUT[k][pd])) {
+			sink_OUT(k, pd, p_OUT[k][pd], ncol_TimeOUT[pd] + ncol_OUT[k],
+				sinkdata_OUT);
+		}
+	}
+
+	irow_OUT[pd] = 0;
+}
+
+
+/** @brief Allocate output arrays for each output key and output period in
+    use; no files are created.
+
+    The output arrays hold all rows of the simulation period or, if a
+    streaming output sink is set, one row. A simulation run without output
+    arrays, e.g., if this routine was not called, produces no output.
+
+    @note Call this routine after `SW_OUT_set_ncol()` and
+    `SW_OUT_set_colnames()`.
+*/
+void SW_OUT_create_files(void) {
+	OutPeriod pd;
+	OutKey k;
+
+	SW_OUT_set_nrow();
+
+	ForEachOutPeriod(pd) {
+		irow_OUT[pd] = 0;
+
+		if (!isnull(sink_OUT) && nrow_OUT[pd] > 0) {
+			nrow_OUT[pd] = 1;
+		}
+
+		ForEachOutKey(k) {
+			if (_has_key(k, pd) && nrow_OUT[pd] > 0) {
+				p_OUT[k][pd] = (RealD *) Mem_Calloc(
+					nrow_OUT[pd] * (ncol_OUT[k] + ncol_TimeOUT[pd]),
+					sizeof(RealD), "SW_OUT_create_files()");
+			}
+		}
+	}
+}
+
+
+/** @brief Free the output arrays.
+
+    Call this routine after the output was used and before the next
+    simulation run of the same model state.
+*/
+void SW_OUT_close_files(void) {
+	OutPeriod pd;
+
+	SW_OUT_deconstruct_outarray();
+
+	ForEachOutPeriod(pd) {
+		nrow_OUT[pd] = 0;
+		irow_OUT[pd] = 0;
+	}
+}
+
+
+/** @brief Output array of output key `k` and output period `pd`
+
+    The array is organized by columns: column `i` consists of the values
+    `p[nrow * i]` to `p[nrow * i + nrow - 1]`. The first columns are the time
+    columns, i.e., year and (unless `pd` is `eSW_Year`) day, week, or month,
+    followed by the `ncol_OUT[k]` columns of the output key; see
+    `SW_OUT_get_colname()`. Rows are complete once `SW_CTL_main()` returned.
+    If a streaming output sink is set, then the array holds only the
+    current row.
+
+    @param k The output key.
+    @param pd The output period.
+    @param[out] nrow Number of rows, i.e., the length of each column.
+    @param[out] ncol Number of columns including the time columns.
+
+    @return A pointer to the output array; NULL (and `nrow` and `ncol` set to
+      0) if output key `k` is not in use for output period `pd`.
+*/
+const RealD *SW_OUT_get_array(OutKey k, OutPeriod pd, size_t *nrow,
+	IntUS *ncol)
+{
+	*nrow = 0;
+	*ncol = 0;
+
+	if (!_is_valid(k, pd) || isnull(p_OUT[k][pd])) {
+		return NULL;
+	}
+
+	*nrow = nrow_OUT[pd];
+	*ncol = ncol_TimeOUT[pd] + ncol_OUT[k];
+
+	return p_OUT[k][pd];
+}
+
+
+/** @brief Name of column `i` of the output array of output key `k` and
+    output period `pd`, see `SW_OUT_get_array()`
+
+    @return The column name; NULL if there is no such column.
+*/
+const char *SW_OUT_get_colname(OutKey k, OutPeriod pd, IntUS i)
+{
+	if (!_is_valid(k, pd) || i >= ncol_TimeOUT[pd] + ncol_OUT[k]) {
+		return NULL;
+	}
+
+	if (i == 0) {
+		return "Year";
+	}
+
+	if (i < ncol_TimeOUT[pd]) {
+		return pd2longstr[pd];
+	}
+
+	return colnames_OUT[k][i - ncol_TimeOUT[pd]];
+}
+
+#endif
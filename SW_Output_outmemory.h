@@ -0,0 +1,42 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Output_outmemory.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Output_outmemory.c: in-memory output arrays of
+    SOILWAT2 compiled with `SW_OUTMEMORY`, e.g., to embed the SOILWAT2
+    library in other programs
+
+  History:
+  10/18/2026	INITIAL CODING
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_OUTPUT_MEMORY_H
+#define SW_OUTPUT_MEMORY_H
+
+#include <stddef.h>
+#include "generic.h"
+#include "SW_Output.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Function declarations
+void SW_OUT_set_sink(SW_OUT_SINK sink, void *data);
+void SW_OUT_write_sink(OutPeriod pd);
+void SW_OUT_create_files(void);
+void SW_OUT_close_files(void);
+const RealD *SW_OUT_get_array(OutKey k, OutPeriod pd, size_t *nrow,
+	IntUS *ncol);
+const char *SW_OUT_get_colname(OutKey k, OutPeriod pd, IntUS i);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -36,33 +36,34 @@
 #include "SW_Output_outtext.h"
 
 
+#ifdef SW_OUTTEXT
 
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
-extern SW_SITE SW_Site;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
 
 // defined in `SW_Output.c`
-extern SW_OUTPUT SW_Output[];
-extern char _Sep;
-extern TimeInt tOffset;
+extern SW_TLS SW_OUTPUT SW_Output[];
+extern SW_TLS char _Sep;
+extern SW_TLS TimeInt tOffset;
 
-extern Bool use_OutPeriod[];
-extern IntUS used_OUTNPERIODS;
-extern OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
+extern SW_TLS Bool use_OutPeriod[];
+extern SW_TLS IntUS used_OUTNPERIODS;
+extern SW_TLS OutPeriod timeSteps[SW_OUTNKEYS][SW_OUTNPERIODS];
 
-extern char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
-extern IntUS ncol_OUT[];
+extern SW_TLS char *colnames_OUT[SW_OUTNKEYS][5 * NVEGTYPES + MAX_LAYERS];
+extern SW_TLS IntUS ncol_OUT[];
 
 extern char const *key2str[];
 extern char const *pd2longstr[];
 
 
 // defined here:
-SW_FILE_STATUS SW_OutFiles;
+SW_TLS SW_FILE_STATUS SW_OutFiles;
 
-Bool
+SW_TLS Bool
   /** `print_IterationSummary` is TRUE if STEPWAT2 is called with `-o` flag
       and if STEPWAT2 is currently in its last iteration/repetition */
   print_IterationSummary,
@@ -75,7 +76,7 @@ Bool
   Used for output as returned from any function `get_XXX_text` which are used
   for SOILWAT2-standalone and for a single iteration/repeat for STEPWAT2
 */
-char sw_outstr[MAX_LAYERS * OUTSTRLEN];
+SW_TLS char sw_outstr[MAX_LAYERS * OUTSTRLEN];
 
 /** \brief Formatted output string for aggregated output
 
@@ -186,6 +187,28 @@ static void get_outstrheader(OutPeriod pd, char *str) {
 
 
 #if defined(SOILWAT)
+/** @brief Open a text output file with a buffer of size `SW_OUTTEXT_BUFSIZE`
+
+  @param fname Name of the file.
+  @param iobuf Set to the allocated buffer which must be freed after the file
+    is closed; `NULL` if the default buffer is used.
+
+  @return The opened file.
+*/
+static FILE *_open_buffered(const char *fname, char **iobuf)
+{
+	FILE *fp = OpenFile(fname, "w");
+
+	*iobuf = (char *) Mem_Malloc(SW_OUTTEXT_BUFSIZE, "_open_buffered()");
+
+	if (setvbuf(fp, *iobuf, _IOFBF, SW_OUTTEXT_BUFSIZE) != 0) {
+		Mem_Free(*iobuf);
+		*iobuf = NULL;
+	}
+
+	return fp;
+}
+
 /**
   \brief Create `csv` output files for specified time step
 
@@ -200,11 +223,13 @@ void _create_csv_files(OutPeriod pd)
 	// a basename, etc.
 
 	if (SW_OutFiles.make_regular[pd]) {
-		SW_OutFiles.fp_reg[pd] = OpenFile(SW_F_name(eOutputDaily + pd), "w");
+		SW_OutFiles.fp_reg[pd] = _open_buffered(SW_F_name(eOutputDaily + pd),
+			&SW_OutFiles.iobuf_reg[pd]);
 	}
 
 	if (SW_OutFiles.make_soil[pd]) {
-		SW_OutFiles.fp_soil[pd] = OpenFile(SW_F_name(eOutputDaily_soil + pd), "w");
+		SW_OutFiles.fp_soil[pd] = _open_buffered(SW_F_name(eOutputDaily_soil + pd),
+			&SW_OutFiles.iobuf_soil[pd]);
 	}
 }
 
@@ -445,6 +470,36 @@ void find_TXToutputSoilReg_inUse(void)
 }
 
 
+/** @brief Write buffered output of all open output files to disk
+
+    Called at the end of each simulated year by `SW_OUT_flush()`;
+    STEPWAT2 may call it whenever it needs the output files to be complete.
+*/
+void SW_OUT_flush_files(void) {
+	OutPeriod p;
+
+	ForEachOutPeriod(p) {
+		if (!isnull(SW_OutFiles.fp_reg[p])) {
+			fflush(SW_OutFiles.fp_reg[p]);
+		}
+
+		if (!isnull(SW_OutFiles.fp_soil[p])) {
+			fflush(SW_OutFiles.fp_soil[p]);
+		}
+
+		#ifdef STEPWAT
+		if (!isnull(SW_OutFiles.fp_reg_agg[p])) {
+			fflush(SW_OutFiles.fp_reg_agg[p]);
+		}
+
+		if (!isnull(SW_OutFiles.fp_soil_agg[p])) {
+			fflush(SW_OutFiles.fp_soil_agg[p]);
+		}
+		#endif
+	}
+}
+
+
 /** @brief close all of the user-specified output files.
     call this routine at the end of the program run.
 */
@@ -475,6 +530,13 @@ void SW_OUT_close_files(void) {
 				CloseFile(&SW_OutFiles.fp_soil[p]);
 			}
 
+			#if defined(SOILWAT)
+			Mem_Free(SW_OutFiles.iobuf_reg[p]);
+			SW_OutFiles.iobuf_reg[p] = NULL;
+			Mem_Free(SW_OutFiles.iobuf_soil[p]);
+			SW_OutFiles.iobuf_soil[p] = NULL;
+			#endif
+
 			if (close_aggs) {
 				#ifdef STEPWAT
 				CloseFile(&SW_OutFiles.fp_reg_agg[p]);
@@ -487,3 +549,5 @@ void SW_OUT_close_files(void) {
 		}
 	}
 }
+
+#endif
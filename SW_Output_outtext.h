@@ -21,6 +21,13 @@ extern "C" {
 #endif
 
 
+/** Size of the buffer of each text output file (bytes); output is written
+    to disk when a buffer is full and at the end of each simulated year */
+#ifndef SW_OUTTEXT_BUFSIZE
+#define SW_OUTTEXT_BUFSIZE 65536
+#endif
+
+
 typedef struct {
 	Bool make_soil[SW_OUTNPERIODS], make_regular[SW_OUTNPERIODS];
 
@@ -42,6 +49,9 @@ typedef struct {
 	FILE *fp_soil[SW_OUTNPERIODS];
 	char buf_soil[SW_OUTNPERIODS][MAX_LAYERS * OUTSTRLEN];
 
+	// if SOILWAT: buffers of size `SW_OUTTEXT_BUFSIZE` of `fp_reg` and `fp_soil`
+	char *iobuf_reg[SW_OUTNPERIODS], *iobuf_soil[SW_OUTNPERIODS];
+
 } SW_FILE_STATUS;
 
 
@@ -61,6 +71,7 @@ void SW_OUT_create_iteration_files(int iteration);
 void get_outstrleader(OutPeriod pd, char *str);
 void write_headers_to_csv(OutPeriod pd, FILE *fp_reg, FILE *fp_soil, Bool does_agg);
 void find_TXToutputSoilReg_inUse(void);
+void SW_OUT_flush_files(void);
 void SW_OUT_close_files(void);
 
 
@@ -45,6 +45,9 @@
  06/05/2016 (ctd) Modified threshold for condition involving gravel in _read_layers() function - as per Caitlin's request.
  									Also, added print statements to notify the user that values may be invalid if the gravel content does not follow
 									parameters of Corey-Brooks equation.
+ 10/18/2026	soil layers are stored as per-layer arrays in SW_SITE instead of allocated SW_LAYER_INFO structs;
+						_newlayer() checks MAX_LAYERS before a layer is added
+ 10/18/2026	water_eqn() clears the cache of soil water potential of the layer
  */
 /********************************************************/
 /********************************************************/
@@ -74,28 +77,28 @@
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
 
-extern SW_VEGPROD SW_VegProd;
-extern SW_CARBON SW_Carbon;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_CARBON SW_Carbon;
 
-SW_SITE SW_Site; /* declared here, externed elsewhere */
+SW_TLS SW_SITE SW_Site; /* declared here, externed elsewhere */
 
-extern Bool EchoInits;
+extern SW_TLS Bool EchoInits;
 extern char const *key2veg[];
 
 
 /* transpiration regions  shallow, moderately shallow,  */
 /* deep and very deep. units are in layer numbers. */
-LyrIndex _TranspRgnBounds[MAX_TRANSP_REGIONS];
+SW_TLS LyrIndex _TranspRgnBounds[MAX_TRANSP_REGIONS];
 
 /* for these three, units are cm/cm if < 1, -bars if >= 1 */
-RealD _SWCInitVal, /* initialization value for swc */
+SW_TLS RealD _SWCInitVal, /* initialization value for swc */
 _SWCWetVal, /* value for a "wet" day,       */
 _SWCMinVal; /* lower bound on swc.          */
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 /* =================================================== */
 /* =================================================== */
@@ -103,6 +106,8 @@ static char *MyFileName;
 /* --------------------------------------------------- */
 
 static void _read_layers(void);
+static void _clear_layer(LyrIndex n);
+static RealD _sum_transp_coeff(LyrIndex n);
 
 
 
@@ -149,14 +154,14 @@ void water_eqn(RealD fractionGravel, RealD sand, RealD clay, LyrIndex n) {
 		 https://doi.org/10.1029/WR020i006p00682. */
 
 	/* Table 4 */
-	SW_Site.lyr[n]->thetasMatric = -14.2 * sand - 3.7 * clay + 50.5;
-	SW_Site.lyr[n]->psisMatric = powe(10.0, -1.58 * sand - 0.63 * clay + 2.17);
-	SW_Site.lyr[n]->bMatric = -0.3 * sand + 15.7 * clay + 3.10;
+	SW_Site.thetasMatric[n] = -14.2 * sand - 3.7 * clay + 50.5;
+	SW_Site.psisMatric[n] = powe(10.0, -1.58 * sand - 0.63 * clay + 2.17);
+	SW_Site.bMatric[n] = -0.3 * sand + 15.7 * clay + 3.10;
 
 
 	if (
-		LE(SW_Site.lyr[n]->thetasMatric, 0.0) ||
-		GT(SW_Site.lyr[n]->thetasMatric, 100.0)
+		LE(SW_Site.thetasMatric[n], 0.0) ||
+		GT(SW_Site.thetasMatric[n], 100.0)
 	) {
 		LogError(
 			logfp,
@@ -164,20 +169,20 @@ void water_eqn(RealD fractionGravel, RealD sand, RealD clay, LyrIndex n) {
 			"water_eqn(): invalid value of "
 			"theta(saturated, matric, [%]; Cosby et al. 1984) = %f "
 			"(must within 0-100%)\n",
-			SW_Site.lyr[n]->thetasMatric
+			SW_Site.thetasMatric[n]
 		);
 	}
 
-	if (ZRO(SW_Site.lyr[n]->bMatric)) {
+	if (ZRO(SW_Site.bMatric[n])) {
 		LogError(
 			logfp,
 			LOGFATAL,
 			"water_eqn(): invalid value of beta = %f (must be != 0)\n",
-			SW_Site.lyr[n]->bMatric
+			SW_Site.bMatric[n]
 		);
 	}
 
-	SW_Site.lyr[n]->binverseMatric = 1.0 / SW_Site.lyr[n]->bMatric;
+	SW_Site.binverseMatric[n] = 1.0 / SW_Site.bMatric[n];
 
 
 	/* Saxton, K. E. and W. J. Rawls. 2006. Soil water characteristic estimates
@@ -231,8 +236,10 @@ void water_eqn(RealD fractionGravel, RealD sand, RealD clay, LyrIndex n) {
 		);
 	}
 
-	SW_Site.lyr[n]->swcBulk_saturated =
-		SW_Site.lyr[n]->width * (1. - fractionGravel) * theta_S;
+	SW_Site.swcBulk_saturated[n] =
+		SW_Site.width[n] * (1. - fractionGravel) * theta_S;
+
+	SW_SWC_clear_swp(n);
 }
 
 
@@ -263,7 +270,7 @@ LyrIndex nlayers_bsevap() {
 
 	ForEachSoilLayer(s)
 	{
-		if (GT(v->lyr[s]->evap_coeff, 0.0))
+		if (GT(v->evap_coeff[s], 0.0))
 		{
 			n++;
 		} else{
@@ -291,7 +298,7 @@ void nlayers_vegroots(LyrIndex n_transp_lyrs[]) {
 
 		ForEachSoilLayer(s)
 		{
-			if (GT(v->lyr[s]->transp_coeff[k], 0.0)) {
+			if (GT(v->transp_coeff[k][s], 0.0)) {
 				n_transp_lyrs[k]++;
 			} else {
 				break;
@@ -310,15 +317,11 @@ void add_deepdrain_layer(void) {
 
 		/* check if deep drain dummy layer was already added */
 		if (SW_Site.deep_lyr == 0) {
-			/* `_newlayer()` sets n_layers */
-			LyrIndex s = _newlayer();
-			SW_Site.lyr[s]->width = 1.0;
-
-			/* sp->deepdrain indicates an extra (dummy) layer for deep drainage
-			* has been added, so n_layers really should be n_layers -1
+			/* the dummy layer follows the deepest soil layer; it has no soil
+			* parameters and is thus not stored in the per-layer arrays
 			* NOTE: deep_lyr is base0, n_layers is BASE1
 			*/
-			SW_Site.deep_lyr = --SW_Site.n_layers;
+			SW_Site.deep_lyr = SW_Site.n_layers;
 		}
 
 	} else {
@@ -330,30 +333,62 @@ void add_deepdrain_layer(void) {
 
 
 /**
-@brief First time called with no layers so SW_Site.lyr
- not initialized yet, malloc() required.  For each
- layer thereafter realloc() is called.
+@brief Adds a soil layer with all values set to zero.
+
+@return Index (base0) of the new soil layer.
 */
 LyrIndex _newlayer(void) {
 
 	SW_SITE *v = &SW_Site;
-	v->n_layers++;
 
-	v->lyr = (!v->lyr) /* if not yet defined */
-		? (SW_LAYER_INFO **) Mem_Calloc(v->n_layers, sizeof(SW_LAYER_INFO *), "_newlayer()") /* malloc() it  */
-		: (SW_LAYER_INFO **) Mem_ReAlloc(v->lyr, sizeof(SW_LAYER_INFO *) * (v->n_layers)); /* else realloc() */
+	if (v->n_layers >= MAX_LAYERS) {
+		LogError(logfp, LOGFATAL, "Too many soil layers (%d).\n"
+			"Maximum number of layers is %d\n", v->n_layers + 1, MAX_LAYERS);
+	}
 
-	v->lyr[v->n_layers - 1] = (SW_LAYER_INFO *) Mem_Calloc(1, sizeof(SW_LAYER_INFO), "_newlayer()");
+	_clear_layer(v->n_layers);
+	v->n_layers++;
 
 	return v->n_layers - 1;
 }
 
-/*static void _clear_layer(LyrIndex n) {
- ---------------------------------------------------
+static void _clear_layer(LyrIndex n) {
+	/* --------------------------------------------------- */
+
+	SW_SITE *v = &SW_Site;
+	int k;
+
+	v->width[n] = v->soilMatric_density[n] = v->evap_coeff[n] = 0.;
+	v->fractionVolBulk_gravel[n] = v->fractionWeightMatric_sand[n] = 0.;
+	v->fractionWeightMatric_clay[n] = v->impermeability[n] = v->sTemp[n] = 0.;
+
+	v->soilBulk_density[n] = v->swcBulk_fieldcap[n] = v->swcBulk_wiltpt[n] = 0.;
+	v->swcBulk_halfwiltpt[n] = v->swcBulk_min[n] = v->swcBulk_wet[n] = 0.;
+	v->swcBulk_init[n] = v->swcBulk_saturated[n] = 0.;
 
- memset(SW_Site.lyr[n], 0, sizeof(SW_LAYER_INFO));
+	v->thetasMatric[n] = v->psisMatric[n] = 0.;
+	v->bMatric[n] = v->binverseMatric[n] = 0.;
 
- }*/
+	ForEachVegType(k) {
+		v->transp_coeff[k][n] = v->swcBulk_atSWPcrit[k][n] = 0.;
+		v->my_transp_rgn[k][n] = 0;
+	}
+
+	memset(&v->swpTable[n], 0, sizeof(SW_SWPTABLE));
+}
+
+/** @brief Sum of the transpiration coefficients of soil layer `n` across
+    vegetation types, cf. `sum_across_vegtypes()` */
+static RealD _sum_transp_coeff(LyrIndex n) {
+	int k;
+	RealD sum = 0.;
+
+	ForEachVegType(k) {
+		sum += SW_Site.transp_coeff[k][n];
+	}
+
+	return sum;
+}
 
 /* =================================================== */
 /* =================================================== */
@@ -545,8 +580,14 @@ void SW_SIT_read(void) {
 			if (debug) swprintf("'SW_SIT_read': scenario = %s\n", c->scenario);
 			#endif
 			break;
+		case 41:
+			v->swp_tolerance = atof(inbuf);
+			break;
+		case 42:
+			v->stMethod = atoi(inbuf);
+			break;
 		default:
-			if (lineno > 40 + MAX_TRANSP_REGIONS)
+			if (lineno > 42 + MAX_TRANSP_REGIONS)
 				break; /* skip extra lines */
 
 			if (MAX_TRANSP_REGIONS < v->n_transp_rgn) {
@@ -579,6 +620,17 @@ void SW_SIT_read(void) {
 		  "as daily runon = %f (value ranges between 0 and +inf)\n", MyFileName, v->percentRunon);
 	}
 
+	if (LT(v->swp_tolerance, 0.) || GE(v->swp_tolerance, 1.)) {
+		LogError(logfp, LOGFATAL, "%s : tolerance of tabulated soil water potential"
+		  " = %f (value ranges between 0 and 1)\n", MyFileName, v->swp_tolerance);
+	}
+
+	if (v->stMethod != SW_ST_EXPLICIT && v->stMethod != SW_ST_IMPLICIT) {
+		LogError(logfp, LOGFATAL, "%s : numerical scheme of soil temperature"
+		  " = %u (value is %d = explicit or %d = implicit)\n", MyFileName,
+		  v->stMethod, SW_ST_EXPLICIT, SW_ST_IMPLICIT);
+	}
+
 	if (too_many_regions) {
 		LogError(logfp, LOGFATAL, "%s : Number of transpiration regions"
 				" exceeds maximum allowed (%d > %d)\n", MyFileName, v->n_transp_rgn, MAX_TRANSP_REGIONS);
@@ -612,6 +664,17 @@ static void _read_layers(void) {
 	f = OpenFile(MyFileName, "r");
 
 	while (GetALine(f, inbuf)) {
+		if (v->n_layers >= MAX_LAYERS) {
+			CloseFile(&f);
+			LogError(
+				logfp,
+				LOGFATAL,
+				"%s : Too many layers specified (%d).\n"
+				"Maximum number of layers is %d\n",
+				MyFileName, v->n_layers + 1, MAX_LAYERS
+			);
+		}
+
 		lyrno = _newlayer();
 
 		x = sscanf(
@@ -640,35 +703,24 @@ static void _read_layers(void) {
 			);
 		}
 
-		v->lyr[lyrno]->width = dmax - dmin;
+		v->width[lyrno] = dmax - dmin;
 
 		/* checks for valid values now carried out by `SW_SIT_init_run()` */
 
 		dmin = dmax;
-		v->lyr[lyrno]->fractionVolBulk_gravel = f_gravel;
-		v->lyr[lyrno]->soilMatric_density = matricd;
-		v->lyr[lyrno]->evap_coeff = evco;
+		v->fractionVolBulk_gravel[lyrno] = f_gravel;
+		v->soilMatric_density[lyrno] = matricd;
+		v->evap_coeff[lyrno] = evco;
 
 		ForEachVegType(k)
 		{
-			v->lyr[lyrno]->transp_coeff[k] = trco_veg[k];
+			v->transp_coeff[k][lyrno] = trco_veg[k];
 		}
 
-		v->lyr[lyrno]->fractionWeightMatric_sand = psand;
-		v->lyr[lyrno]->fractionWeightMatric_clay = pclay;
-		v->lyr[lyrno]->impermeability = imperm;
-		v->lyr[lyrno]->sTemp = soiltemp;
-
-		if (lyrno >= MAX_LAYERS) {
-			CloseFile(&f);
-			LogError(
-				logfp,
-				LOGFATAL,
-				"%s : Too many layers specified (%d).\n"
-				"Maximum number of layers is %d\n",
-				MyFileName, lyrno + 1, MAX_LAYERS
-			);
-		}
+		v->fractionWeightMatric_sand[lyrno] = psand;
+		v->fractionWeightMatric_clay[lyrno] = pclay;
+		v->impermeability[lyrno] = imperm;
+		v->sTemp[lyrno] = soiltemp;
 	}
 
 	CloseFile(&f);
@@ -709,7 +761,7 @@ static void _read_layers(void) {
     `lowerBounds[0]`.
 
   @sideeffect After deleting any previous data in the soil layer array
-    SW_Site.lyr, it creates new soil layers based on the argument inputs.
+    the soil layers of SW_Site, it creates new soil layers based on the argument inputs.
 
   @note
     - This function is a modified version of the function _read_layers() in
@@ -737,35 +789,35 @@ void set_soillayers(LyrIndex nlyrs, RealF *dmax, RealF *matricd, RealF *f_gravel
     // Create the next soil layer
     lyrno = _newlayer();
 
-    v->lyr[lyrno]->width = dmax[i] - dmin;
+    v->width[lyrno] = dmax[i] - dmin;
     dmin = dmax[i];
-    v->lyr[lyrno]->soilMatric_density = matricd[i];
-    v->lyr[lyrno]->fractionVolBulk_gravel = f_gravel[i];
-    v->lyr[lyrno]->evap_coeff = evco[i];
+    v->soilMatric_density[lyrno] = matricd[i];
+    v->fractionVolBulk_gravel[lyrno] = f_gravel[i];
+    v->evap_coeff[lyrno] = evco[i];
 
     ForEachVegType(k)
     {
       switch (k)
       {
         case SW_TREES:
-          v->lyr[lyrno]->transp_coeff[k] = trco_tree[i];
+          v->transp_coeff[k][lyrno] = trco_tree[i];
           break;
         case SW_SHRUB:
-          v->lyr[lyrno]->transp_coeff[k] = trco_shrub[i];
+          v->transp_coeff[k][lyrno] = trco_shrub[i];
           break;
         case SW_FORBS:
-          v->lyr[lyrno]->transp_coeff[k] = trco_forb[i];
+          v->transp_coeff[k][lyrno] = trco_forb[i];
           break;
         case SW_GRASS:
-          v->lyr[lyrno]->transp_coeff[k] = trco_grass[i];
+          v->transp_coeff[k][lyrno] = trco_grass[i];
           break;
       }
     }
 
-    v->lyr[lyrno]->fractionWeightMatric_sand = psand[i];
-    v->lyr[lyrno]->fractionWeightMatric_clay = pclay[i];
-    v->lyr[lyrno]->impermeability = imperm[i];
-    v->lyr[lyrno]->sTemp = soiltemp[i];
+    v->fractionWeightMatric_sand[lyrno] = psand[i];
+    v->fractionWeightMatric_clay[lyrno] = pclay[i];
+    v->impermeability[lyrno] = imperm[i];
+    v->sTemp[lyrno] = soiltemp[i];
   }
 
 
@@ -819,7 +871,7 @@ void derive_soilRegions(int nRegions, RealD *regionLowerBounds){
 
 	/* ----------------- Derive Regions ------------------- */
 	// Loop through the regions the user wants to derive
-	layer = 0; // SW_Site.lyr is base0-indexed
+	layer = 0; // soil layers of SW_Site are base0-indexed
 	totalDepth = 0;
 	for(i = 0; i < nRegions; ++i){
 		_TranspRgnBounds[i] = layer;
@@ -827,8 +879,8 @@ void derive_soilRegions(int nRegions, RealD *regionLowerBounds){
 		// It becomes the bound.
 		while(totalDepth < regionLowerBounds[i] &&
 		      layer < v->n_layers &&
-		      sum_across_vegtypes(v->lyr[layer]->transp_coeff)) {
-			totalDepth += v->lyr[layer]->width;
+		      _sum_transp_coeff(layer)) {
+			totalDepth += v->width[layer];
 			_TranspRgnBounds[i] = layer;
 			layer++;
 		}
@@ -864,7 +916,6 @@ void SW_SIT_init_run(void) {
 	/* 1-Oct-03 (cwb) removed sum_evap_coeff and sum_transp_coeff  */
 
 	SW_SITE *sp = &SW_Site;
-	SW_LAYER_INFO *lyr;
 	LyrIndex s, r, curregion;
 	int k, wiltminflag = 0, initminflag = 0;
 	Bool fail = swFALSE;
@@ -892,60 +943,58 @@ void SW_SIT_init_run(void) {
 	/* Loop over soil layers check variables and calculate parameters */
 	ForEachSoilLayer(s)
 	{
-		lyr = sp->lyr[s];
-
 		/* Check validity of soil variables:
 			previously, checked by code in `_read_layers()`,
 			erroneously skipped by `set_soillayers()`,
 			and checked by code in rSOILWAT2's `onSet_SW_LYR()`
 		*/
-		if (LE(lyr->width, 0.)) {
+		if (LE(sp->width[s], 0.)) {
 			fail = swTRUE;
-			fval = lyr->width;
+			fval = sp->width[s];
 			errtype = Str_Dup("layer width");
 
-		} else if (LT(lyr->soilMatric_density, 0.)) {
+		} else if (LT(sp->soilMatric_density[s], 0.)) {
 			fail = swTRUE;
-			fval = lyr->soilMatric_density;
+			fval = sp->soilMatric_density[s];
 			errtype = Str_Dup("soil density");
 
 		} else if (
-			LT(lyr->fractionVolBulk_gravel, 0.) ||
-			GE(lyr->fractionVolBulk_gravel, 1.)
+			LT(sp->fractionVolBulk_gravel[s], 0.) ||
+			GE(sp->fractionVolBulk_gravel[s], 1.)
 		) {
 			fail = swTRUE;
-			fval = lyr->fractionVolBulk_gravel;
+			fval = sp->fractionVolBulk_gravel[s];
 			errtype = Str_Dup("gravel content");
 
 		} else if (
-			LE(lyr->fractionWeightMatric_sand, 0.) ||
-			GE(lyr->fractionWeightMatric_sand, 1.)
+			LE(sp->fractionWeightMatric_sand[s], 0.) ||
+			GE(sp->fractionWeightMatric_sand[s], 1.)
 		) {
 			fail = swTRUE;
-			fval = lyr->fractionWeightMatric_sand;
+			fval = sp->fractionWeightMatric_sand[s];
 			errtype = Str_Dup("sand proportion");
 
 		} else if (
-			LE(lyr->fractionWeightMatric_clay, 0.) ||
-			GE(lyr->fractionWeightMatric_clay, 1.)
+			LE(sp->fractionWeightMatric_clay[s], 0.) ||
+			GE(sp->fractionWeightMatric_clay[s], 1.)
 		) {
 			fail = swTRUE;
-			fval = lyr->fractionWeightMatric_clay;
+			fval = sp->fractionWeightMatric_clay[s];
 			errtype = Str_Dup("clay proportion");
 
 		} else if (
-			GE(lyr->fractionWeightMatric_sand + lyr->fractionWeightMatric_clay, 1.)
+			GE(sp->fractionWeightMatric_sand[s] + sp->fractionWeightMatric_clay[s], 1.)
 		) {
 			fail = swTRUE;
-			fval = lyr->fractionWeightMatric_sand + lyr->fractionWeightMatric_clay;
+			fval = sp->fractionWeightMatric_sand[s] + sp->fractionWeightMatric_clay[s];
 			errtype = Str_Dup("sand+clay proportion");
 
 		} else if (
-			LT(lyr->impermeability, 0.) ||
-			GT(lyr->impermeability, 1.)
+			LT(sp->impermeability[s], 0.) ||
+			GT(sp->impermeability[s], 1.)
 		) {
 			fail = swTRUE;
-			fval = lyr->impermeability;
+			fval = sp->impermeability[s];
 			errtype = Str_Dup("impermeability");
 		}
 
@@ -959,42 +1008,45 @@ void SW_SIT_init_run(void) {
 		}
 
 		/* Update soil density for gravel */
-		lyr->soilBulk_density = calculate_soilBulkDensity(
-			lyr->soilMatric_density,
-			lyr->fractionVolBulk_gravel
+		sp->soilBulk_density[s] = calculate_soilBulkDensity(
+			sp->soilMatric_density[s],
+			sp->fractionVolBulk_gravel[s]
 		);
 
 		/* Calculate pedotransfer function paramaters */
 		water_eqn(
-			lyr->fractionVolBulk_gravel,
-			lyr->fractionWeightMatric_sand,
-			lyr->fractionWeightMatric_clay,
+			sp->fractionVolBulk_gravel[s],
+			sp->fractionWeightMatric_sand[s],
+			sp->fractionWeightMatric_clay[s],
 			s
 		);
 
 		/* Calculate SWC at field capacity and at wilting point */
-		lyr->swcBulk_fieldcap = lyr->width * SW_SWPmatric2VWCBulk(
-			lyr->fractionVolBulk_gravel,
+		sp->swcBulk_fieldcap[s] = sp->width[s] * SW_SWPmatric2VWCBulk(
+			sp->fractionVolBulk_gravel[s],
 			0.333,
 			s
 		);
 
-		lyr->swcBulk_wiltpt = lyr->width * SW_SWPmatric2VWCBulk(
-			lyr->fractionVolBulk_gravel,
+		sp->swcBulk_wiltpt[s] = sp->width[s] * SW_SWPmatric2VWCBulk(
+			sp->fractionVolBulk_gravel[s],
 			15,
 			s
 		);
 
+		/* soil evaporation extracts water down to half of the wilting point */
+		sp->swcBulk_halfwiltpt[s] = sp->swcBulk_wiltpt[s] / 2.;
+
 
 		/* sum ev and tr coefficients for later */
-		evsum += lyr->evap_coeff;
+		evsum += sp->evap_coeff[s];
 		ForEachVegType(k)
 		{
-			trsum_veg[k] += lyr->transp_coeff[k];
+			trsum_veg[k] += sp->transp_coeff[k][s];
 
 			/* calculate soil water content at SWPcrit for each vegetation type */
-			lyr->swcBulk_atSWPcrit[k] = SW_SWPmatric2VWCBulk(lyr->fractionVolBulk_gravel,
-				SW_VegProd.veg[k].SWPcrit, s) * lyr->width;
+			sp->swcBulk_atSWPcrit[k][s] = SW_SWPmatric2VWCBulk(sp->fractionVolBulk_gravel[s],
+				SW_VegProd.veg[k].SWPcrit, s) * sp->width[s];
 
 			/* Find which transpiration region the current soil layer
 			 * is in and check validity of result. Region bounds are
@@ -1003,7 +1055,7 @@ void SW_SIT_init_run(void) {
 			ForEachTranspRegion(r)
 			{
 				if (s < _TranspRgnBounds[r]) {
-					if (ZRO(lyr->transp_coeff[k]))
+					if (ZRO(sp->transp_coeff[k][s]))
 						break; /* end of transpiring layers */
 					curregion = r + 1;
 					break;
@@ -1011,7 +1063,7 @@ void SW_SIT_init_run(void) {
 			}
 
 			if (curregion || _TranspRgnBounds[curregion] == 0) {
-				lyr->my_transp_rgn[k] = curregion;
+				sp->my_transp_rgn[k][s] = curregion;
 				sp->n_transp_lyrs[k] = max(sp->n_transp_lyrs[k], s);
 
 			} else if (s == 0) {
@@ -1024,7 +1076,7 @@ void SW_SIT_init_run(void) {
 						"  Please fix the discrepancy and try again.\n",
 						SW_F_name(eSite), r + 1, key2veg[k], s, SW_F_name(eLayers));
 			} else {
-				lyr->my_transp_rgn[k] = 0;
+				sp->my_transp_rgn[k][s] = 0;
 			}
 		}
 
@@ -1035,58 +1087,58 @@ void SW_SIT_init_run(void) {
 
 			/* residual SWC of Rawls & Brakensiek (1985) */
 			swcmin_help1 = SW_VWCBulkRes(
-				lyr->fractionVolBulk_gravel,
-				lyr->fractionWeightMatric_sand,
-				lyr->fractionWeightMatric_clay,
-				lyr->swcBulk_saturated / ((1. - lyr->fractionVolBulk_gravel) * lyr->width)
+				sp->fractionVolBulk_gravel[s],
+				sp->fractionWeightMatric_sand[s],
+				sp->fractionWeightMatric_clay[s],
+				sp->swcBulk_saturated[s] / ((1. - sp->fractionVolBulk_gravel[s]) * sp->width[s])
 			);
 
 			/* residual SWC at -3 MPa (Fredlund DG, Xing AQ (1994)
 				EQUATIONS FOR THE SOIL-WATER CHARACTERISTIC CURVE.
 				Canadian Geotechnical Journal, 31, 521-532.)
 			*/
-			swcmin_help2 = SW_SWPmatric2VWCBulk(lyr->fractionVolBulk_gravel, 30., s);
+			swcmin_help2 = SW_SWPmatric2VWCBulk(sp->fractionVolBulk_gravel[s], 30., s);
 
 			// if `SW_VWCBulkRes()` returns SW_MISSING then use `swcmin_help2`
 			if (missing(swcmin_help1)){
-				lyr->swcBulk_min = swcmin_help2;
+				sp->swcBulk_min[s] = swcmin_help2;
 
 			} else{
-				lyr->swcBulk_min = fmax(0., fmin(swcmin_help1, swcmin_help2));
+				sp->swcBulk_min[s] = fmax(0., fmin(swcmin_help1, swcmin_help2));
 			}
 
 		} else if (GE(_SWCMinVal, 1.0)) {
 			/* input: fixed SWP value as minimum SWC; unit(_SWCMinVal) == -bar */
-			lyr->swcBulk_min = SW_SWPmatric2VWCBulk(
-				lyr->fractionVolBulk_gravel,
+			sp->swcBulk_min[s] = SW_SWPmatric2VWCBulk(
+				sp->fractionVolBulk_gravel[s],
 				_SWCMinVal,
 				s
 			);
 
 		} else {
 			/* input: fixed VWC value as minimum SWC; unit(_SWCMinVal) == cm/cm */
-			lyr->swcBulk_min = _SWCMinVal;
+			sp->swcBulk_min[s] = _SWCMinVal;
 		}
 
 		/* Convert VWC to SWC */
-		lyr->swcBulk_min *= lyr->width;
+		sp->swcBulk_min[s] *= sp->width[s];
 
 		#ifdef SWDEBUG
 		if (debug) {
 			swprintf(
 				"L[%d] swcmin=%f = swpmin=%f\n",
 				s,
-				lyr->swcBulk_min,
-				SW_SWCbulk2SWPmatric(lyr->fractionVolBulk_gravel, lyr->swcBulk_min, s)
+				sp->swcBulk_min[s],
+				SW_SWCbulk2SWPmatric(sp->fractionVolBulk_gravel[s], sp->swcBulk_min[s], s)
 			);
 
 			swprintf(
 				"L[%d] SWC(HalfWiltpt)=%f = swp(hw)=%f\n",
 				s,
-				lyr->swcBulk_wiltpt / 2,
+				sp->swcBulk_wiltpt[s] / 2,
 				SW_SWCbulk2SWPmatric(
-					lyr->fractionVolBulk_gravel,
-					lyr->swcBulk_wiltpt / 2,
+					sp->fractionVolBulk_gravel[s],
+					sp->swcBulk_wiltpt[s] / 2,
 					s
 				)
 			);
@@ -1095,21 +1147,24 @@ void SW_SIT_init_run(void) {
 
 
 		/* Calculate wet limit of SWC for what inputs defined as wet */
-		lyr->swcBulk_wet = GE(_SWCWetVal, 1.0) ? SW_SWPmatric2VWCBulk(lyr->fractionVolBulk_gravel, _SWCWetVal, s) * lyr->width : _SWCWetVal * lyr->width;
+		sp->swcBulk_wet[s] = GE(_SWCWetVal, 1.0) ? SW_SWPmatric2VWCBulk(sp->fractionVolBulk_gravel[s], _SWCWetVal, s) * sp->width[s] : _SWCWetVal * sp->width[s];
 		/* Calculate initial SWC based on inputs */
-		lyr->swcBulk_init = GE(_SWCInitVal, 1.0) ? SW_SWPmatric2VWCBulk(lyr->fractionVolBulk_gravel, _SWCInitVal, s) * lyr->width : _SWCInitVal * lyr->width;
+		sp->swcBulk_init[s] = GE(_SWCInitVal, 1.0) ? SW_SWPmatric2VWCBulk(sp->fractionVolBulk_gravel[s], _SWCInitVal, s) * sp->width[s] : _SWCInitVal * sp->width[s];
 
 		/* test validity of values */
-		if (LT(lyr->swcBulk_init, lyr->swcBulk_min))
+		if (LT(sp->swcBulk_init[s], sp->swcBulk_min[s]))
 			initminflag++;
-		if (LT(lyr->swcBulk_wiltpt, lyr->swcBulk_min))
+		if (LT(sp->swcBulk_wiltpt[s], sp->swcBulk_min[s]))
 			wiltminflag++;
-		if (LE(lyr->swcBulk_wet, lyr->swcBulk_min)) {
+		if (LE(sp->swcBulk_wet[s], sp->swcBulk_min[s])) {
 			LogError(logfp, LOGFATAL, "%s : Layer %d\n"
 					"  calculated swcBulk_wet (%7.4f) <= swcBulk_min (%7.4f).\n"
-					"  Recheck parameters and try again.", MyFileName, s + 1, lyr->swcBulk_wet, lyr->swcBulk_min);
+					"  Recheck parameters and try again.", MyFileName, s + 1, sp->swcBulk_wet[s], sp->swcBulk_min[s]);
 		}
 
+		/* Set up lookup table of SWP if requested */
+		SW_SWC_init_swptable(s, sp->swp_tolerance);
+
 	} /*end ForEachSoilLayer */
 
 	if (wiltminflag) {
@@ -1134,9 +1189,9 @@ void SW_SIT_init_run(void) {
 
 		ForEachEvapLayer(s)
 		{
-			SW_Site.lyr[s]->evap_coeff /= evsum;
+			SW_Site.evap_coeff[s] /= evsum;
 			LogError(logfp, LOGNOTE, "  Layer %2d : %.4f",
-				s + 1, SW_Site.lyr[s]->evap_coeff);
+				s + 1, SW_Site.evap_coeff[s]);
 		}
 
 		LogError(logfp, LOGQUIET, "");
@@ -1152,11 +1207,11 @@ void SW_SIT_init_run(void) {
 
 			ForEachSoilLayer(s)
 			{
-				if (GT(SW_Site.lyr[s]->transp_coeff[k], 0.))
+				if (GT(SW_Site.transp_coeff[k][s], 0.))
 				{
-					SW_Site.lyr[s]->transp_coeff[k] /= trsum_veg[k];
+					SW_Site.transp_coeff[k][s] /= trsum_veg[k];
 					LogError(logfp, LOGNOTE, "  Layer %2d : %.4f",
-						s + 1, SW_Site.lyr[s]->transp_coeff[k]);
+						s + 1, SW_Site.transp_coeff[k][s]);
 				}
 			}
 
@@ -1200,24 +1255,15 @@ void SW_SIT_init_run(void) {
 
 /**
 @brief For multiple runs with the shared library, the need to remove the allocated
-			soil layers arises to avoid leaks. (rjm 2013)
+			memory of soil layers arises to avoid leaks (rjm 2013), i.e., the
+			lookup tables of soil water potential.
 */
 void SW_SIT_clear_layers(void) {
-	SW_SITE *s = &SW_Site;
-	LyrIndex i, j;
-
-	j = SW_Site.n_layers;
-
-	if (s->deepdrain && s->deep_lyr > 0) {
-		j++;
-	}
+	LyrIndex i;
 
-	for (i = 0; i < j; i++) {
-		free(s->lyr[i]);
-		s->lyr[i] = NULL;
+	ForEachSoilLayer(i) {
+		SW_SWC_deconstruct_swptable(i);
 	}
-	free(s->lyr);
-	s->lyr = NULL;
 }
 
 
@@ -1258,6 +1304,7 @@ void _echo_inputs(void) {
 	LogError(logfp, LOGNOTE, "  PET Scale: %5.4f\n", s->pet_scale);
 	LogError(logfp, LOGNOTE, "  Runoff: proportion of surface water lost: %5.4f\n", s->percentRunoff);
 	LogError(logfp, LOGNOTE, "  Runon: proportion of new surface water gained: %5.4f\n", s->percentRunon);
+	LogError(logfp, LOGNOTE, "  Tolerance of tabulated soil water potential: %g\n", s->swp_tolerance);
 	LogError(logfp, LOGNOTE, "  Longitude (degree): %4.2f\n", s->longitude * rad_to_deg);
 	LogError(logfp, LOGNOTE, "  Latitude (degree): %4.2f\n", s->latitude * rad_to_deg);
 	LogError(logfp, LOGNOTE, "  Altitude (m a.s.l.): %4.2f \n", s->altitude);
@@ -1284,6 +1331,8 @@ void _echo_inputs(void) {
 	LogError(logfp, LOGNOTE, "  max depth: %5.4f\n", s->stMaxDepth);
 	LogError(logfp, LOGNOTE, "  Make soil temperature calculations: %s\n", (s->use_soil_temp) ? "swTRUE" : "swFALSE");
 	LogError(logfp, LOGNOTE, "  Number of regressions for the soil temperature function: %d\n", s->stNRGR);
+	LogError(logfp, LOGNOTE, "  Numerical scheme of the soil temperature function: %s\n",
+		(s->stMethod == SW_ST_IMPLICIT) ? "implicit" : "explicit");
 
 	LogError(logfp, LOGNOTE, "\nLayer Related Values:\n----------------------\n");
 	LogError(logfp, LOGNOTE, "  Soils File: %s\n", SW_F_name(eLayers));
@@ -1307,14 +1356,14 @@ void _echo_inputs(void) {
 	{
 		LogError(logfp, LOGNOTE,
 				"  %3d %5.1f %9.5f %6.2f %8.5f %8.5f %6.2f %6.2f %6.2f %6.2f %6.2f %6.2f %9.2f %9.2f %9.2f %9.2f %9.2f %10d %10d %15d %15d %15.4f %9.4f %9.4f %9.4f %9.4f\n",
-				i + 1, s->lyr[i]->width, s->lyr[i]->soilBulk_density, s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_fieldcap / s->lyr[i]->width,
-				s->lyr[i]->swcBulk_wiltpt / s->lyr[i]->width, s->lyr[i]->fractionWeightMatric_sand, s->lyr[i]->fractionWeightMatric_clay,
-				s->lyr[i]->swcBulk_atSWPcrit[SW_FORBS] / s->lyr[i]->width, s->lyr[i]->swcBulk_atSWPcrit[SW_TREES] / s->lyr[i]->width,
-				s->lyr[i]->swcBulk_atSWPcrit[SW_SHRUB] / s->lyr[i]->width, s->lyr[i]->swcBulk_atSWPcrit[SW_GRASS] / s->lyr[i]->width, s->lyr[i]->evap_coeff,
-				s->lyr[i]->transp_coeff[SW_FORBS], s->lyr[i]->transp_coeff[SW_TREES], s->lyr[i]->transp_coeff[SW_SHRUB], s->lyr[i]->transp_coeff[SW_GRASS], s->lyr[i]->my_transp_rgn[SW_FORBS],
-				s->lyr[i]->my_transp_rgn[SW_TREES], s->lyr[i]->my_transp_rgn[SW_SHRUB], s->lyr[i]->my_transp_rgn[SW_GRASS], s->lyr[i]->swcBulk_wet / s->lyr[i]->width,
-				s->lyr[i]->swcBulk_min / s->lyr[i]->width, s->lyr[i]->swcBulk_init / s->lyr[i]->width, s->lyr[i]->swcBulk_saturated / s->lyr[i]->width,
-				s->lyr[i]->impermeability);
+				i + 1, s->width[i], s->soilBulk_density[i], s->fractionVolBulk_gravel[i], s->swcBulk_fieldcap[i] / s->width[i],
+				s->swcBulk_wiltpt[i] / s->width[i], s->fractionWeightMatric_sand[i], s->fractionWeightMatric_clay[i],
+				s->swcBulk_atSWPcrit[SW_FORBS][i] / s->width[i], s->swcBulk_atSWPcrit[SW_TREES][i] / s->width[i],
+				s->swcBulk_atSWPcrit[SW_SHRUB][i] / s->width[i], s->swcBulk_atSWPcrit[SW_GRASS][i] / s->width[i], s->evap_coeff[i],
+				s->transp_coeff[SW_FORBS][i], s->transp_coeff[SW_TREES][i], s->transp_coeff[SW_SHRUB][i], s->transp_coeff[SW_GRASS][i], s->my_transp_rgn[SW_FORBS][i],
+				s->my_transp_rgn[SW_TREES][i], s->my_transp_rgn[SW_SHRUB][i], s->my_transp_rgn[SW_GRASS][i], s->swcBulk_wet[i] / s->width[i],
+				s->swcBulk_min[i] / s->width[i], s->swcBulk_init[i] / s->width[i], s->swcBulk_saturated[i] / s->width[i],
+				s->impermeability[i]);
 
 	}
 	LogError(logfp, LOGNOTE, "\n  Actual per-layer values:\n");
@@ -1327,10 +1376,10 @@ void _echo_inputs(void) {
 
 	ForEachSoilLayer(i)
 	{
-		LogError(logfp, LOGNOTE, "  %3d %5.1f %9.5f %6.2f %8.5f %8.5f %6.2f %6.2f %7.4f %7.4f %7.4f %7.4f %7.4f %7.4f %8.4f %7.4f %5.4f\n", i + 1, s->lyr[i]->width,
-				s->lyr[i]->soilBulk_density, s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_fieldcap, s->lyr[i]->swcBulk_wiltpt, s->lyr[i]->fractionWeightMatric_sand,
-				s->lyr[i]->fractionWeightMatric_clay, s->lyr[i]->swcBulk_atSWPcrit[SW_FORBS], s->lyr[i]->swcBulk_atSWPcrit[SW_TREES], s->lyr[i]->swcBulk_atSWPcrit[SW_SHRUB],
-				s->lyr[i]->swcBulk_atSWPcrit[SW_GRASS], s->lyr[i]->swcBulk_wet, s->lyr[i]->swcBulk_min, s->lyr[i]->swcBulk_init, s->lyr[i]->swcBulk_saturated, s->lyr[i]->sTemp);
+		LogError(logfp, LOGNOTE, "  %3d %5.1f %9.5f %6.2f %8.5f %8.5f %6.2f %6.2f %7.4f %7.4f %7.4f %7.4f %7.4f %7.4f %8.4f %7.4f %5.4f\n", i + 1, s->width[i],
+				s->soilBulk_density[i], s->fractionVolBulk_gravel[i], s->swcBulk_fieldcap[i], s->swcBulk_wiltpt[i], s->fractionWeightMatric_sand[i],
+				s->fractionWeightMatric_clay[i], s->swcBulk_atSWPcrit[SW_FORBS][i], s->swcBulk_atSWPcrit[SW_TREES][i], s->swcBulk_atSWPcrit[SW_SHRUB][i],
+				s->swcBulk_atSWPcrit[SW_GRASS][i], s->swcBulk_wet[i], s->swcBulk_min[i], s->swcBulk_init[i], s->swcBulk_saturated[i], s->sTemp[i]);
 	}
 
 	LogError(logfp, LOGNOTE, "\n  Water Potential values:\n");
@@ -1343,15 +1392,15 @@ void _echo_inputs(void) {
 	ForEachSoilLayer(i)
 	{
 		LogError(logfp, LOGNOTE, "  %3d   %15.4f   %15.4f  %15.4f %15.4f  %15.4f  %15.4f  %15.4f   %15.4f   %15.4f\n", i + 1,
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_fieldcap, i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_wiltpt, i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_atSWPcrit[SW_FORBS], i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_atSWPcrit[SW_TREES], i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_atSWPcrit[SW_SHRUB], i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_atSWPcrit[SW_GRASS], i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_wet, i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_min, i),
-				SW_SWCbulk2SWPmatric(s->lyr[i]->fractionVolBulk_gravel, s->lyr[i]->swcBulk_init, i));
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_fieldcap[i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_wiltpt[i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_atSWPcrit[SW_FORBS][i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_atSWPcrit[SW_TREES][i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_atSWPcrit[SW_SHRUB][i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_atSWPcrit[SW_GRASS][i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_wet[i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_min[i], i),
+				SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], s->swcBulk_init[i], i));
 
 	}
 
@@ -1374,9 +1423,10 @@ void SW_SIT_SetMemoryRefs( void) {
 	 */
 	LyrIndex l;
 
-	NoteMemoryRef(SW_Site.lyr);
 	ForEachSoilLayer(l) {
-		NoteMemoryRef(SW_Site.lyr[l]);
+		if (!isnull(SW_Site.swpTable[l].swp)) {
+			NoteMemoryRef(SW_Site.swpTable[l].swp);
+		}
 	}
 }
 
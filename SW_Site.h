@@ -41,6 +41,8 @@
  						due to the renaming, also had to update the use of these variables in the other files.
 	07/09/2013	(clk)	added the variables transp_coeff[SW_FORBS], swcBulk_atSWPcrit[SW_FORBS], and my_transp_rgn[SW_FORBS] to SW_LAYER_INFO
 	07/09/2013	(clk)	added the variable n_transp_lyrs_forb to SW_SITE
+	10/18/2026	replaced SW_LAYER_INFO (one allocated struct per soil layer) by
+						per-layer arrays in SW_SITE, i.e., SW_Site.width[i] instead of SW_Site.lyr[i]->width
 */
 /********************************************************/
 /********************************************************/
@@ -56,42 +58,20 @@ extern "C" {
 
 typedef unsigned int LyrIndex;
 
-typedef struct {
-	/* bulk = relating to the whole soil, i.e., matric + rock/gravel/coarse fragments */
-	/* matric = relating to the < 2 mm fraction of the soil, i.e., sand, clay, and silt */
 
-	RealD
-		/* Inputs */
-		width, /* width of the soil layer (cm) */
-		soilMatric_density, /* matric soil density of the < 2 mm fraction, i.e., gravel component excluded, (g/cm3) */
-		evap_coeff, /* prop. of total soil evap from this layer */
-		transp_coeff[NVEGTYPES], /* prop. of total transp from this layer    */
-		fractionVolBulk_gravel, /* gravel content (> 2 mm) as volume-fraction of bulk soil (g/cm3) */
-		fractionWeightMatric_sand, /* sand content (< 2 mm & > . mm) as weight-fraction of matric soil (g/g) */
-		fractionWeightMatric_clay, /* clay content (< . mm & > . mm) as weight-fraction of matric soil (g/g) */
-		impermeability, /* fraction of how impermeable a layer is (0=permeable, 1=impermeable)    */
-		sTemp, /* initial soil temperature for each soil layer */
-
-		/* Derived soil characteristics */
-		soilBulk_density, /* bulk soil density of the whole soil, i.e., including rock/gravel component, (g/cm3) */
-		swcBulk_fieldcap, /* Soil water content (SWC) corresponding to field capacity (SWP = -0.033 MPa) [cm] */
-		swcBulk_wiltpt, /* SWC corresponding to wilting point (SWP = -1.5 MPa) [cm] */
-		swcBulk_min, /* Minimal SWC [cm] */
-		swcBulk_wet, /* SWC considered "wet" [cm] */
-		swcBulk_init, /* Initial SWC for first day of simulation [cm] */
-		swcBulk_atSWPcrit[NVEGTYPES], /* SWC corresponding to critical SWP for transpiration */
+/** Lookup table of the soil water retention curve of a soil layer,
+    see `SW_SWC_init_swptable()`
 
-		/* Saxton et al. 2006 */
-		swcBulk_saturated, /* saturated bulk SWC [cm] */
-
-		/* Cosby et al. (1984): SOILWAT2's soil water retention curve */
-		thetasMatric, /* saturated matric SWC [cm] */
-		psisMatric, /* saturated matric SWP [cm] */
-		bMatric, /* slope of the logarithmic retention curve */
-		binverseMatric; /* inverse of bMatric */
+    SWP [-bar] of matric VWC `theta` [%] is linearly interpolated between
+    `n + 1` nodes per binary order of magnitude of `theta`, i.e.,
+    for `theta` in `[2^(e - 1), 2^e)` with `e` in `[e_min, e_max]`.
+*/
+typedef struct {
+	RealD *swp; /* SWP at nodes; NULL if SWP is calculated exactly */
+	int e_min, e_max; /* binary exponents of `theta` covered by the table */
+	unsigned int n; /* number of intervals per binary order of magnitude */
+} SW_SWPTABLE;
 
-	LyrIndex my_transp_rgn[NVEGTYPES]; /* which transp zones from Site am I in? */
-} SW_LAYER_INFO;
 
 
 typedef struct {
@@ -130,17 +110,56 @@ typedef struct {
 		stDeltaX,		/* for the soil_temperature function, deltaX is the distance between profile points (default: 15) */
 		stMaxDepth,		/* for the soil_temperature function, the maxDepth of the interpolation function */
 		percentRunoff,	/* the percentage of surface water lost daily */
-		percentRunon;	/* the percentage of water that is added to surface gained daily */
+		percentRunon,	/* the percentage of water that is added to surface gained daily */
+		swp_tolerance;	/* relative error of tabulated SWP; 0 = SWP is calculated exactly */
 
-	unsigned int stNRGR; /* number of interpolations, for the soil_temperature function */
+	unsigned int stNRGR, /* number of interpolations, for the soil_temperature function */
+		stMethod; /* numerical scheme of the soil_temperature function: SW_ST_EXPLICIT or SW_ST_IMPLICIT */
 	/* params for tanfunc rate calculations for evap and transp. */
 	/* tanfunc() creates a logistic-type graph if shift is positive,
 	 * the graph has a negative slope, if shift is 0, slope is positive.
 	 */
 	tanfunc_t evap, transp;
 
-	SW_LAYER_INFO **lyr; 	/* one struct per soil layer pointed to by   */
-							/* a dynamically allocated block of pointers */
+	/* Soil layers: one contiguous array per variable, indexed by layer,
+	 * so that the flow routines use them directly (see `_newlayer()`) */
+	/* bulk = relating to the whole soil, i.e., matric + rock/gravel/coarse fragments */
+	/* matric = relating to the < 2 mm fraction of the soil, i.e., sand, clay, and silt */
+
+	RealD
+		/* Inputs */
+		width[MAX_LAYERS], /* width of the soil layer (cm) */
+		soilMatric_density[MAX_LAYERS], /* matric soil density of the < 2 mm fraction, i.e., gravel component excluded, (g/cm3) */
+		evap_coeff[MAX_LAYERS], /* prop. of total soil evap from this layer */
+		transp_coeff[NVEGTYPES][MAX_LAYERS], /* prop. of total transp from this layer    */
+		fractionVolBulk_gravel[MAX_LAYERS], /* gravel content (> 2 mm) as volume-fraction of bulk soil (g/cm3) */
+		fractionWeightMatric_sand[MAX_LAYERS], /* sand content (< 2 mm & > . mm) as weight-fraction of matric soil (g/g) */
+		fractionWeightMatric_clay[MAX_LAYERS], /* clay content (< . mm & > . mm) as weight-fraction of matric soil (g/g) */
+		impermeability[MAX_LAYERS], /* fraction of how impermeable a layer is (0=permeable, 1=impermeable)    */
+		sTemp[MAX_LAYERS], /* initial soil temperature for each soil layer */
+
+		/* Derived soil characteristics */
+		soilBulk_density[MAX_LAYERS], /* bulk soil density of the whole soil, i.e., including rock/gravel component, (g/cm3) */
+		swcBulk_fieldcap[MAX_LAYERS], /* Soil water content (SWC) corresponding to field capacity (SWP = -0.033 MPa) [cm] */
+		swcBulk_wiltpt[MAX_LAYERS], /* SWC corresponding to wilting point (SWP = -1.5 MPa) [cm] */
+		swcBulk_halfwiltpt[MAX_LAYERS], /* half of `swcBulk_wiltpt`: lower limit of soil evaporation [cm] */
+		swcBulk_min[MAX_LAYERS], /* Minimal SWC [cm] */
+		swcBulk_wet[MAX_LAYERS], /* SWC considered "wet" [cm] */
+		swcBulk_init[MAX_LAYERS], /* Initial SWC for first day of simulation [cm] */
+		swcBulk_atSWPcrit[NVEGTYPES][MAX_LAYERS], /* SWC corresponding to critical SWP for transpiration */
+
+		/* Saxton et al. 2006 */
+		swcBulk_saturated[MAX_LAYERS], /* saturated bulk SWC [cm] */
+
+		/* Cosby et al. (1984): SOILWAT2's soil water retention curve */
+		thetasMatric[MAX_LAYERS], /* saturated matric SWC [cm] */
+		psisMatric[MAX_LAYERS], /* saturated matric SWP [cm] */
+		bMatric[MAX_LAYERS], /* slope of the logarithmic retention curve */
+		binverseMatric[MAX_LAYERS]; /* inverse of bMatric */
+
+	SW_SWPTABLE swpTable[MAX_LAYERS]; /* lookup table of SWP, see `swp_tolerance` */
+
+	LyrIndex my_transp_rgn[NVEGTYPES][MAX_LAYERS]; /* which transp zones from Site am I in? */
 
 } SW_SITE;
 
@@ -36,14 +36,14 @@
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
 
-SW_SKY SW_Sky; /* declared here, externed elsewhere */
-extern SW_WEATHER SW_Weather;
-extern SW_MODEL SW_Model;
+SW_TLS SW_SKY SW_Sky; /* declared here, externed elsewhere */
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_MODEL SW_Model;
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 /* =================================================== */
 /* =================================================== */
@@ -0,0 +1,934 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Binary snapshot of the parsed inputs of a simulation run
+
+  `SW_CTL_read_inputs_from_disk()` parses and validates more than a dozen
+  text input files for each simulation run. A snapshot holds the result,
+  i.e., the input state of the modules after parsing, in one binary file.
+  Repeated runs of a site (e.g., scenario runs) that find an up-to-date
+  snapshot load it instead of parsing (see `SW_SNAP_read()`).
+
+  A snapshot is up-to-date if size and modification time (including
+  nanoseconds where the file system records them) of each input
+  file that it was parsed from (including the species files of
+  `estab.in`) are unchanged, and if it was written by the same build of
+  SOILWAT2. Otherwise, the run parses its inputs and replaces the snapshot
+  (see `SW_SNAP_write()`).
+
+  If `InputSnapshot` is set (e.g., via `SOILWAT2 -s snapshot.bin`), then
+  each run uses the snapshot of that name in its project directory.
+
+  Daily weather is not part of a snapshot; weather stores and preloaded
+  weather are set up as if the inputs were parsed
+  (see `SW_WTH_setup_daily()`).
+
+  A checkpoint holds the state of a run at the end of a simulation year
+  (see `SW_SNAP_write_state()`). Runs that load a checkpoint continue with
+  the following year (see `SW_SNAP_read_state()`), e.g., runs of future
+  scenarios that share a spin-up period.
+  Checkpoints can also be kept in memory (see `SW_SNAP_store_state()`).
+
+  History:
+  10/18/2026	INITIAL CODING
+  10/18/2026	added checkpoints of the state of a run (`SW_CTL_save_state()`)
+  10/18/2026	added checkpoints in memory (`SW_SNAP_store_state()`)
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+/* `st_mtim` of `struct stat` is POSIX.1-2008, not part of `-std=c11` */
+#if !defined(__APPLE__) && !defined(_WIN32)
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
+#include "SW_Defines.h"
+#include "rands.h"
+#include "SW_Files.h"
+#include "SW_Model.h"
+#include "SW_Weather.h"
+#include "SW_Sky.h"
+#include "SW_Markov.h"
+#include "SW_VegProd.h"
+#include "SW_Site.h"
+#include "SW_VegEstab.h"
+#include "SW_Output.h"
+#include "SW_Carbon.h"
+#include "SW_SoilWater.h"
+#include "SW_Flow_lib.h"
+#include "SW_Snapshot.h"
+
+/* Nanoseconds of the modification time of a file */
+#if defined(__APPLE__)
+	#define _mtime_ns(st) ((st).st_mtimespec.tv_nsec)
+#elif defined(_WIN32)
+	#define _mtime_ns(st) 0
+#else
+	#define _mtime_ns(st) ((st).st_mtim.tv_nsec)
+#endif
+
+
+/* =================================================== */
+/*                  Global Variables                   */
+/* --------------------------------------------------- */
+
+/** Name of the input snapshot relative to the project directory of a run;
+    empty if runs always parse their inputs (see `SW_SNAP_read()`);
+    process-wide setting */
+char InputSnapshot[MAX_FILENAMESIZE] = "";
+
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_SKY SW_Sky;
+extern SW_TLS SW_MARKOV SW_Markov;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS SW_CARBON SW_Carbon;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+
+extern SW_TLS char *InFiles[SW_NFILES];
+extern SW_TLS LyrIndex _TranspRgnBounds[MAX_TRANSP_REGIONS];
+extern SW_TLS RealD _SWCInitVal, _SWCWetVal, _SWCMinVal;
+
+extern SW_TLS TimeInt _prevweek, _prevmonth, _prevyear;
+extern SW_TLS RealD temp_snow;
+extern SW_TLS Bool weth_found;
+extern SW_TLS sw_random_t markov_rng;
+extern SW_TLS RealD surfaceTemp[TWO_DAYS], veg_int_storage[NVEGTYPES],
+	litter_int_storage, standingWater[TWO_DAYS], drainout;
+extern SW_TLS ST_RGR_VALUES stValues;
+extern SW_TLS unsigned int soil_temp_init, fusion_pool_init;
+extern SW_TLS Bool do_once_at_soiltempError;
+extern SW_TLS double delta_time;
+
+
+/* =================================================== */
+/*                Module-Level Variables               */
+/* --------------------------------------------------- */
+
+/* Input files of `SW_CTL_read_inputs_from_disk()` whose stamps are stored
+   in this order at the beginning of a snapshot */
+static const SW_FileIndex _infiles[] = {
+	eFirst, eModel, eSite, eLayers, eWeather, eMarkovProb, eMarkovCov, eSky,
+	eVegProd, eVegEstab, eCarbon, eSoilwat, eOutput
+};
+
+#define _n_infiles (sizeof(_infiles) / sizeof(_infiles[0]))
+
+/* =================================================== */
+/*                Module-Level Declarations            */
+/* --------------------------------------------------- */
+
+static void _header(SW_SNAP_HEADER *h, const char *magic);
+static uint64_t _fnv1a(const unsigned char *p, size_t n);
+static void _stamp(const char *path, SW_SNAP_STAMP *s);
+static void _put(SW_SNAP_BUFFER *b, const void *src, size_t n);
+static void _put_str(SW_SNAP_BUFFER *b, const char *s);
+static void _get(SW_SNAP_BUFFER *b, void *dst, size_t n);
+static char *_get_str(SW_SNAP_BUFFER *b);
+static Bool _is_current(SW_SNAP_BUFFER *b, uint32_t n_stamps);
+static void _put_inputs(SW_SNAP_BUFFER *b);
+static void _get_inputs(SW_SNAP_BUFFER *b);
+static void _state(SW_SNAP_BUFFER *b, Bool restore);
+static void _put_checkpoint(SW_SNAP_BUFFER *b, const char *name);
+static void _get_checkpoint(SW_SNAP_BUFFER *b, const char *name,
+	Bool owned);
+static Bool _read_file(const char *fname, const char *magic,
+	SW_SNAP_HEADER *h, SW_SNAP_BUFFER *b);
+static Bool _write_file(const char *fname, SW_SNAP_HEADER *h,
+	SW_SNAP_BUFFER *b);
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+/** @brief Set up the header of a snapshot or checkpoint of this build
+
+  @param h The header; `n_stamps`, `size`, and `checksum` are zero.
+  @param magic Either `SW_SNAP_MAGIC` or `SW_SNAP_STATE_MAGIC`.
+*/
+static void _header(SW_SNAP_HEADER *h, const char *magic) {
+	memset(h, 0, sizeof(SW_SNAP_HEADER));
+	strcpy(h->magic, magic);
+	h->version = SW_SNAP_VERSION;
+	h->byteorder = SW_SNAP_BYTEORDER;
+
+	#ifdef SW_OUTTEXT
+	h->flags |= 1;
+	#endif
+
+	h->size_structs[0] = sizeof(SW_MODEL);
+	h->size_structs[1] = sizeof(SW_WEATHER);
+	h->size_structs[2] = sizeof(SW_SKY);
+	h->size_structs[3] = sizeof(SW_VEGPROD);
+	h->size_structs[4] = sizeof(SW_SITE);
+	h->size_structs[5] = sizeof(SW_VEGESTAB_INFO);
+	h->size_structs[6] = sizeof(SW_OUT_PLAN);
+	h->size_structs[7] = sizeof(SW_CARBON);
+	h->size_structs[8] = sizeof(SW_SOILWAT);
+	h->size_structs[9] = sizeof(ST_RGR_VALUES);
+	h->size_structs[10] = sizeof(SW_WEATHER_2DAYS);
+	h->size_structs[11] = sizeof(SW_WEATHER_OUTPUTS);
+	h->size_structs[12] = sizeof(SW_SOILWAT_OUTPUTS);
+	h->size_structs[13] = sizeof(SW_VEGPROD_OUTPUTS);
+	h->size_structs[14] = sizeof(sw_random_t);
+	h->size_structs[15] = sizeof(TimeInt);
+
+	strncpy(h->sw2_version, SW2_VERSION, sizeof(h->sw2_version) - 1);
+}
+
+
+/** @brief 64-bit FNV-1a hash of `n` bytes */
+static uint64_t _fnv1a(const unsigned char *p, size_t n) {
+	uint64_t x = 14695981039346656037ULL;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		x = (x ^ p[i]) * 1099511628211ULL;
+	}
+
+	return x;
+}
+
+
+/** @brief Size and modification time of an input file
+
+  @param path Name of the file.
+  @param s The stamp of the file.
+*/
+static void _stamp(const char *path, SW_SNAP_STAMP *s) {
+	struct stat st;
+
+	memset(s, 0, sizeof(SW_SNAP_STAMP));
+	strncpy(s->path, isnull(path) ? "" : path, MAX_FILENAMESIZE - 1);
+
+	if (0 == stat(s->path, &st)) {
+		s->size = (int64_t) st.st_size;
+		s->mtime = (int64_t) st.st_mtime;
+		s->mtime_ns = (int64_t) _mtime_ns(st);
+	} else {
+		s->size = s->mtime = s->mtime_ns = -1;
+	}
+}
+
+
+static void _put(SW_SNAP_BUFFER *b, const void *src, size_t n) {
+	if (0 == n) {
+		return;
+	}
+
+	if (b->pos + n > b->size) {
+		b->size = 2 * (b->pos + n);
+		b->data = isnull(b->data) ?
+			(unsigned char *) Mem_Malloc(b->size, "_put()") :
+			(unsigned char *) Mem_ReAlloc(b->data, b->size);
+	}
+
+	memcpy(b->data + b->pos, src, n);
+	b->pos += n;
+}
+
+
+/* Strings are stored with their length plus one; 0 codes for `NULL` */
+static void _put_str(SW_SNAP_BUFFER *b, const char *s) {
+	uint32_t n = isnull(s) ? 0 : (uint32_t) strlen(s) + 1;
+
+	_put(b, &n, sizeof(n));
+	_put(b, s, n);
+}
+
+
+static void _get(SW_SNAP_BUFFER *b, void *dst, size_t n) {
+	if (b->pos + n > b->size) {
+		LogError(logfp, LOGFATAL, "Input snapshot is truncated.");
+	}
+
+	memcpy(dst, b->data + b->pos, n);
+	b->pos += n;
+}
+
+
+static char *_get_str(SW_SNAP_BUFFER *b) {
+	uint32_t n;
+	char *s = NULL;
+
+	_get(b, &n, sizeof(n));
+
+	if (n > 0) {
+		s = (char *) Mem_Malloc(n, "_get_str()");
+		_get(b, s, n);
+		s[n - 1] = '\0';
+	}
+
+	return s;
+}
+
+
+/** @brief Check that the input files of a snapshot are unchanged
+
+  @param b The contents of a snapshot positioned at its stamps;
+    positioned at its inputs on return.
+  @param n_stamps Number of stamps of the snapshot.
+
+  @return `swTRUE` if the snapshot was parsed from the current input files
+    and none of them changed since.
+*/
+static Bool _is_current(SW_SNAP_BUFFER *b, uint32_t n_stamps) {
+	SW_SNAP_STAMP s, now;
+	uint32_t i;
+	Bool ok = (Bool) (n_stamps >= _n_infiles);
+
+	for (i = 0; ok && i < n_stamps; i++) {
+		_get(b, &s, sizeof(s));
+
+		if (i < _n_infiles) {
+			_stamp(InFiles[_infiles[i]], &now);
+			ok = (Bool) (0 == strcmp(s.path, now.path));
+		} else {
+			_stamp(s.path, &now);
+		}
+
+		ok = (Bool) (ok && s.size == now.size && s.mtime == now.mtime &&
+			s.mtime_ns == now.mtime_ns);
+	}
+
+	return ok;
+}
+
+
+/** @brief Store the parsed inputs of the active run */
+static void _put_inputs(SW_SNAP_BUFFER *b) {
+	SW_MARKOV *m = &SW_Markov;
+	SW_OUT_RUN *r;
+	IntU i;
+	IntUS k;
+
+	_put(b, &SW_Model, sizeof(SW_MODEL));
+	_put(b, &SW_Weather, sizeof(SW_WEATHER));
+	_put(b, &SW_Sky, sizeof(SW_SKY));
+
+	if (SW_Weather.use_weathergenerator) {
+		_put(b, m->wetprob, MAX_DAYS * sizeof(RealD));
+		_put(b, m->dryprob, MAX_DAYS * sizeof(RealD));
+		_put(b, m->avg_ppt, MAX_DAYS * sizeof(RealD));
+		_put(b, m->std_ppt, MAX_DAYS * sizeof(RealD));
+		_put(b, m->cfxw, MAX_DAYS * sizeof(RealD));
+		_put(b, m->cfxd, MAX_DAYS * sizeof(RealD));
+		_put(b, m->cfnw, MAX_DAYS * sizeof(RealD));
+		_put(b, m->cfnd, MAX_DAYS * sizeof(RealD));
+		_put(b, m->u_cov, sizeof(m->u_cov));
+		_put(b, m->v_cov, sizeof(m->v_cov));
+	}
+
+	_put(b, &SW_VegProd, sizeof(SW_VEGPROD));
+
+	_put(b, &SW_Site, sizeof(SW_SITE));
+	_put(b, _TranspRgnBounds, sizeof(_TranspRgnBounds));
+	_put(b, &_SWCInitVal, sizeof(RealD));
+	_put(b, &_SWCWetVal, sizeof(RealD));
+	_put(b, &_SWCMinVal, sizeof(RealD));
+
+	_put(b, &SW_VegEstab.use, sizeof(Bool));
+	_put(b, &SW_VegEstab.count, sizeof(IntU));
+	for (i = 0; i < SW_VegEstab.count; i++) {
+		_put(b, SW_VegEstab.parms[i], sizeof(SW_VEGESTAB_INFO));
+	}
+
+	// Output setup without the pointers to output routines, files, and arrays
+	r = (SW_OUT_RUN *) Mem_Calloc(1, sizeof(SW_OUT_RUN), "_put_inputs()");
+	SW_OUT_store_run(r);
+
+	ForEachOutKey(k) {
+		_put(b, &r->Output[k].sumtype, sizeof(OutSum));
+		_put(b, &r->Output[k].use, sizeof(Bool));
+		_put(b, &r->Output[k].first, sizeof(TimeInt));
+		_put(b, &r->Output[k].last, sizeof(TimeInt));
+		_put(b, &r->Output[k].first_orig, sizeof(TimeInt));
+		_put(b, &r->Output[k].last_orig, sizeof(TimeInt));
+	}
+	_put(b, &r->sep, sizeof(char));
+	_put(b, r->timeSteps, sizeof(r->timeSteps));
+	_put(b, &r->used_OUTNPERIODS, sizeof(IntUS));
+	_put(b, r->use_OutPeriod, sizeof(r->use_OutPeriod));
+	_put(b, &r->plan, sizeof(SW_OUT_PLAN));
+	#ifdef SW_OUTTEXT
+	_put(b, r->make_soil, sizeof(r->make_soil));
+	_put(b, r->make_regular, sizeof(r->make_regular));
+	#endif
+
+	Mem_Free(r);
+
+	_put(b, &SW_Carbon, sizeof(SW_CARBON));
+
+	_put(b, &SW_Soilwat.hist_use, sizeof(Bool));
+	_put(b, &SW_Soilwat.hist.method, sizeof(int));
+	_put(b, &SW_Soilwat.hist.yr, sizeof(SW_TIMES));
+	_put_str(b, SW_Soilwat.hist.file_prefix);
+}
+
+
+/** @brief Make the inputs of a snapshot the inputs of the active run
+
+  The memory that the modules allocated for the run (e.g., output
+  accumulators) is kept; the memory for the inputs is allocated as
+  if the inputs were parsed.
+*/
+static void _get_inputs(SW_SNAP_BUFFER *b) {
+	SW_MARKOV *m = &SW_Markov;
+	SW_OUT_RUN *r;
+	IntU i, n;
+	IntUS k;
+	OutPeriod pd;
+
+	SW_WEATHER_OUTPUTS *w_accu[SW_OUTNPERIODS], *w_oagg[SW_OUTNPERIODS];
+	SW_VEGPROD_OUTPUTS *v_accu[SW_OUTNPERIODS], *v_oagg[SW_OUTNPERIODS];
+	struct SW_WEATHER_STORE *store = SW_Weather.store;
+	SW_SWPTABLE swpTable[MAX_LAYERS];
+
+	_get(b, &SW_Model, sizeof(SW_MODEL));
+
+	ForEachOutPeriod(pd) {
+		w_accu[pd] = SW_Weather.p_accu[pd];
+		w_oagg[pd] = SW_Weather.p_oagg[pd];
+	}
+	_get(b, &SW_Weather, sizeof(SW_WEATHER));
+	ForEachOutPeriod(pd) {
+		SW_Weather.p_accu[pd] = w_accu[pd];
+		SW_Weather.p_oagg[pd] = w_oagg[pd];
+	}
+	SW_Weather.store = store;
+	SW_WTH_setup_daily();
+
+	_get(b, &SW_Sky, sizeof(SW_SKY));
+
+	if (SW_Weather.use_weathergenerator) {
+		SW_MKV_construct();
+		_get(b, m->wetprob, MAX_DAYS * sizeof(RealD));
+		_get(b, m->dryprob, MAX_DAYS * sizeof(RealD));
+		_get(b, m->avg_ppt, MAX_DAYS * sizeof(RealD));
+		_get(b, m->std_ppt, MAX_DAYS * sizeof(RealD));
+		_get(b, m->cfxw, MAX_DAYS * sizeof(RealD));
+		_get(b, m->cfxd, MAX_DAYS * sizeof(RealD));
+		_get(b, m->cfnw, MAX_DAYS * sizeof(RealD));
+		_get(b, m->cfnd, MAX_DAYS * sizeof(RealD));
+		_get(b, m->u_cov, sizeof(m->u_cov));
+		_get(b, m->v_cov, sizeof(m->v_cov));
+	}
+
+	ForEachOutPeriod(pd) {
+		v_accu[pd] = SW_VegProd.p_accu[pd];
+		v_oagg[pd] = SW_VegProd.p_oagg[pd];
+	}
+	_get(b, &SW_VegProd, sizeof(SW_VEGPROD));
+	ForEachOutPeriod(pd) {
+		SW_VegProd.p_accu[pd] = v_accu[pd];
+		SW_VegProd.p_oagg[pd] = v_oagg[pd];
+	}
+
+	memcpy(swpTable, SW_Site.swpTable, sizeof(swpTable));
+	_get(b, &SW_Site, sizeof(SW_SITE));
+	memcpy(SW_Site.swpTable, swpTable, sizeof(swpTable));
+	_get(b, _TranspRgnBounds, sizeof(_TranspRgnBounds));
+	_get(b, &_SWCInitVal, sizeof(RealD));
+	_get(b, &_SWCWetVal, sizeof(RealD));
+	_get(b, &_SWCMinVal, sizeof(RealD));
+
+	_get(b, &SW_VegEstab.use, sizeof(Bool));
+	_get(b, &n, sizeof(IntU));
+	for (i = 0; i < n; i++) {
+		_get(b, SW_VegEstab.parms[_new_species()], sizeof(SW_VEGESTAB_INFO));
+	}
+	if (SW_VegEstab.use) {
+		SW_VegEstab_construct();
+	}
+
+	r = (SW_OUT_RUN *) Mem_Calloc(1, sizeof(SW_OUT_RUN), "_get_inputs()");
+	SW_OUT_store_run(r);
+
+	ForEachOutKey(k) {
+		_get(b, &r->Output[k].sumtype, sizeof(OutSum));
+		_get(b, &r->Output[k].use, sizeof(Bool));
+		_get(b, &r->Output[k].first, sizeof(TimeInt));
+		_get(b, &r->Output[k].last, sizeof(TimeInt));
+		_get(b, &r->Output[k].first_orig, sizeof(TimeInt));
+		_get(b, &r->Output[k].last_orig, sizeof(TimeInt));
+	}
+	_get(b, &r->sep, sizeof(char));
+	_get(b, r->timeSteps, sizeof(r->timeSteps));
+	_get(b, &r->used_OUTNPERIODS, sizeof(IntUS));
+	_get(b, r->use_OutPeriod, sizeof(r->use_OutPeriod));
+	_get(b, &r->plan, sizeof(SW_OUT_PLAN));
+	#ifdef SW_OUTTEXT
+	_get(b, r->make_soil, sizeof(r->make_soil));
+	_get(b, r->make_regular, sizeof(r->make_regular));
+	#endif
+
+	SW_OUT_restore_run(r);
+	Mem_Free(r);
+
+	_get(b, &SW_Carbon, sizeof(SW_CARBON));
+
+	_get(b, &SW_Soilwat.hist_use, sizeof(Bool));
+	_get(b, &SW_Soilwat.hist.method, sizeof(int));
+	_get(b, &SW_Soilwat.hist.yr, sizeof(SW_TIMES));
+	SW_Soilwat.hist.file_prefix = _get_str(b);
+
+	// see `SW_SWC_read()`
+	SW_Soilwat.surfaceTemp = 0;
+	ForEachSoilLayer(i) {
+		SW_Soilwat.sTemp[i] = SW_Site.sTemp[i];
+	}
+}
+
+
+/** @brief Store or restore the state of the active run that is carried
+    from one simulation year to the next
+
+  @param b The contents of a checkpoint.
+  @param restore If `swTRUE`, then the state is read from `b`; otherwise,
+    the state is appended to `b`.
+*/
+static void _state(SW_SNAP_BUFFER *b, Bool restore) {
+	#define xstate(var, n) \
+		if (restore) _get(b, (var), (n)); \
+		else _put(b, (var), (n))
+	#define xaccu(p, n) \
+		if (!isnull(p)) { xstate((p), (n)); }
+
+	SW_SOILWAT *keep;
+	OutPeriod pd;
+	IntU i;
+
+	// soil water, except its inputs and output accumulators
+	if (restore) {
+		keep = (SW_SOILWAT *) Mem_Malloc(sizeof(SW_SOILWAT), "_state()");
+		memcpy(keep, &SW_Soilwat, sizeof(SW_SOILWAT));
+		_get(b, &SW_Soilwat, sizeof(SW_SOILWAT));
+
+		memcpy(SW_Soilwat.p_accu, keep->p_accu, sizeof(keep->p_accu));
+		memcpy(SW_Soilwat.p_oagg, keep->p_oagg, sizeof(keep->p_oagg));
+		SW_Soilwat.hist_use = keep->hist_use;
+		memcpy(&SW_Soilwat.hist, &keep->hist, sizeof(SW_SOILWAT_HIST));
+		// cached soil water potentials belong to the soil of this run
+		memcpy(SW_Soilwat.swpCache_swc, keep->swpCache_swc,
+			sizeof(keep->swpCache_swc));
+		memcpy(SW_Soilwat.swpCache_swp, keep->swpCache_swp,
+			sizeof(keep->swpCache_swp));
+		#ifdef SWDEBUG
+		memcpy(SW_Soilwat.wbErrorNames, keep->wbErrorNames,
+			sizeof(keep->wbErrorNames));
+		#endif
+
+		Mem_Free(keep);
+
+	} else {
+		_put(b, &SW_Soilwat, sizeof(SW_SOILWAT));
+	}
+	xstate(&temp_snow, sizeof(RealD));
+
+	// weather of the previous day and weather generator
+	xstate(&SW_Weather.now, sizeof(SW_WEATHER_2DAYS));
+	xstate(&weth_found, sizeof(Bool));
+	xstate(&markov_rng, sizeof(sw_random_t));
+	xstate(&SW_Markov.ppt_events, sizeof(int));
+
+	// water flow
+	xstate(surfaceTemp, sizeof(RealD) * TWO_DAYS);
+	xstate(veg_int_storage, sizeof(RealD) * NVEGTYPES);
+	xstate(&litter_int_storage, sizeof(RealD));
+	xstate(standingWater, sizeof(RealD) * TWO_DAYS);
+	xstate(&drainout, sizeof(RealD));
+
+	// soil temperature
+	xstate(&stValues, sizeof(ST_RGR_VALUES));
+	xstate(&soil_temp_init, sizeof(unsigned int));
+	xstate(&fusion_pool_init, sizeof(unsigned int));
+	xstate(&do_once_at_soiltempError, sizeof(Bool));
+	xstate(&delta_time, sizeof(double));
+
+	// time
+	xstate(&_prevweek, sizeof(TimeInt));
+	xstate(&_prevmonth, sizeof(TimeInt));
+	xstate(&_prevyear, sizeof(TimeInt));
+
+	// establishment
+	for (i = 0; i < SW_VegEstab.count; i++) {
+		SW_VEGESTAB_INFO *v = SW_VegEstab.parms[i];
+
+		xstate(&v->estab_doy, sizeof(TimeInt));
+		xstate(&v->germ_days, sizeof(TimeInt));
+		xstate(&v->drydays_postgerm, sizeof(TimeInt));
+		xstate(&v->wetdays_for_germ, sizeof(TimeInt));
+		xstate(&v->wetdays_for_estab, sizeof(TimeInt));
+		xstate(&v->germd, sizeof(Bool));
+		xstate(&v->no_estab, sizeof(Bool));
+	}
+	if (SW_VegEstab.count > 0) {
+		xstate(SW_VegEstab.p_accu[eSW_Year]->days,
+			SW_VegEstab.count * sizeof(TimeInt));
+	}
+
+	// output accumulators; aggregated values (`p_oagg`) are re-computed
+	// before they are written and `p_oagg[eSW_Day]` may alias `p_accu`
+	ForEachOutPeriod(pd) {
+		xaccu(SW_Weather.p_accu[pd], sizeof(SW_WEATHER_OUTPUTS));
+		xaccu(SW_Soilwat.p_accu[pd], sizeof(SW_SOILWAT_OUTPUTS));
+		xaccu(SW_VegProd.p_accu[pd], sizeof(SW_VEGPROD_OUTPUTS));
+	}
+
+	#undef xaccu
+	#undef xstate
+}
+
+
+/** @brief Read and check a snapshot or checkpoint file
+
+  @param fname Name of the file.
+  @param magic Either `SW_SNAP_MAGIC` or `SW_SNAP_STATE_MAGIC`.
+  @param h The header of the file.
+  @param b The contents of the file after the header; `b->data` is
+    allocated if and only if the file was read.
+
+  @return `swTRUE` if the file exists, was written by this build, and is
+    complete.
+*/
+static Bool _read_file(const char *fname, const char *magic,
+	SW_SNAP_HEADER *h, SW_SNAP_BUFFER *b) {
+
+	SW_SNAP_HEADER hthis;
+	FILE *f;
+	Bool ok;
+
+	if (NULL == (f = fopen(fname, "rb"))) {
+		return swFALSE;
+	}
+
+	_header(&hthis, magic);
+
+	ok = (Bool) (1 == fread(h, sizeof(SW_SNAP_HEADER), 1, f) &&
+		0 == memcmp(h->magic, hthis.magic, sizeof(h->magic)) &&
+		h->version == hthis.version &&
+		h->byteorder == hthis.byteorder &&
+		h->flags == hthis.flags &&
+		0 == memcmp(h->size_structs, hthis.size_structs,
+			sizeof(h->size_structs)) &&
+		0 == strncmp(h->sw2_version, hthis.sw2_version,
+			sizeof(h->sw2_version)) &&
+		h->size > sizeof(SW_SNAP_HEADER));
+
+	if (ok) {
+		b->pos = 0;
+		b->size = (size_t) (h->size - sizeof(SW_SNAP_HEADER));
+		b->data = (unsigned char *) Mem_Malloc(b->size, "_read_file()");
+
+		ok = (Bool) (b->size == fread(b->data, 1, b->size, f) &&
+			EOF == fgetc(f) &&
+			h->checksum == _fnv1a(b->data, b->size));
+
+		if (!ok) {
+			Mem_Free(b->data);
+			b->data = NULL;
+		}
+	}
+
+	fclose(f);
+
+	return ok;
+}
+
+
+/** @brief Write a snapshot or checkpoint file
+
+  The file is written to a temporary file that replaces `fname` once it
+  is complete.
+
+  @param fname Name of the file.
+  @param h The header of the file; `size` and `checksum` are set.
+  @param b The contents of the file after the header.
+
+  @return `swTRUE` if the file was written.
+*/
+static Bool _write_file(const char *fname, SW_SNAP_HEADER *h,
+	SW_SNAP_BUFFER *b) {
+
+	char tmpname[MAX_FILENAMESIZE + 4];
+	FILE *f;
+	Bool ok;
+
+	h->size = sizeof(SW_SNAP_HEADER) + b->pos;
+	h->checksum = _fnv1a(b->data, b->pos);
+
+	snprintf(tmpname, sizeof(tmpname), "%s.tmp", fname);
+
+	ok = (Bool) (NULL != (f = fopen(tmpname, "wb")));
+
+	if (ok) {
+		ok = (Bool) (1 == fwrite(h, sizeof(SW_SNAP_HEADER), 1, f) &&
+			b->pos == fwrite(b->data, 1, b->pos, f));
+		ok = (Bool) (0 == fclose(f) && ok && 0 == rename(tmpname, fname));
+
+		if (!ok) {
+			remove(tmpname);
+		}
+	}
+
+	return ok;
+}
+
+
+/** @brief Put a checkpoint of the active run into a buffer
+
+  The checkpoint consists of the completed year, the numbers of soil layers
+  and of species, and the state of the modules (see `_state()`).
+
+  @param b The buffer.
+  @param name Name of the checkpoint for error messages.
+*/
+static void _put_checkpoint(SW_SNAP_BUFFER *b, const char *name) {
+	TimeInt year = min(SW_Model.year, SW_Model.endyr);
+
+	if (SW_Model.lastdoy == 0 || SW_Model.doy <= SW_Model.lastdoy) {
+		LogError(logfp, LOGFATAL, "%s : checkpoints can only be written "
+			"at the end of a simulated year.", name);
+	}
+
+	_put(b, &year, sizeof(TimeInt));
+	_put(b, &SW_Site.n_layers, sizeof(LyrIndex));
+	_put(b, &SW_VegEstab.count, sizeof(IntU));
+	_state(b, swFALSE);
+}
+
+
+/** @brief Restore the active run from a checkpoint in a buffer
+
+  @param b The buffer, positioned at the beginning of the checkpoint.
+  @param name Name of the checkpoint for error messages.
+  @param owned If `swTRUE`, then `b->data` is freed before a fatal error.
+*/
+static void _get_checkpoint(SW_SNAP_BUFFER *b, const char *name,
+	Bool owned) {
+
+	TimeInt year;
+	LyrIndex n_layers;
+	IntU n_spp;
+
+	_get(b, &year, sizeof(TimeInt));
+	_get(b, &n_layers, sizeof(LyrIndex));
+	_get(b, &n_spp, sizeof(IntU));
+
+	if (n_layers != SW_Site.n_layers || n_spp != SW_VegEstab.count) {
+		if (owned) {
+			Mem_Free(b->data);
+		}
+		LogError(logfp, LOGFATAL, "%s : checkpoint has %d soil layers and "
+			"%d species but the run has %d and %d.", name, n_layers, n_spp,
+			SW_Site.n_layers, SW_VegEstab.count);
+	}
+
+	if (year + 1 < SW_Model.startyr || year >= SW_Model.endyr) {
+		if (owned) {
+			Mem_Free(b->data);
+		}
+		LogError(logfp, LOGFATAL, "%s : checkpoint of year %d cannot continue "
+			"a run of the years %d-%d.", name, year, SW_Model.startyr,
+			SW_Model.endyr);
+	}
+
+	_state(b, swTRUE);
+
+	if (b->pos != b->size) {
+		if (owned) {
+			Mem_Free(b->data);
+		}
+		LogError(logfp, LOGFATAL, "%s : checkpoint does not match the "
+			"outputs of the run.", name);
+	}
+
+	SW_Model.startyr = year + 1;
+	SW_Model.startstart = 1;
+	SW_Model.year = year;
+}
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Public Function Definitions             */
+/* --------------------------------------------------- */
+
+/** @brief Load the inputs of the active run from a snapshot
+
+  The run must have read its main input file (see `SW_F_read()`) and
+  nothing else; an up-to-date snapshot replaces the remaining steps of
+  `SW_CTL_read_inputs_from_disk()`.
+
+  Warnings that were logged while parsing the inputs are not repeated.
+
+  @param fname Name of the snapshot file.
+
+  @return `swTRUE` if the inputs were loaded; `swFALSE` if the snapshot
+    does not exist, is not up-to-date, or was written by another build,
+    and the run has to parse its inputs.
+*/
+Bool SW_SNAP_read(const char *fname) {
+	SW_SNAP_HEADER h;
+	SW_SNAP_BUFFER b = {NULL, 0, 0};
+	Bool ok = _read_file(fname, SW_SNAP_MAGIC, &h, &b);
+
+	if (ok && _is_current(&b, h.n_stamps)) {
+		_get_inputs(&b);
+	} else {
+		ok = swFALSE;
+	}
+
+	if (!isnull(b.data)) {
+		Mem_Free(b.data);
+	}
+
+	return ok;
+}
+
+
+/** @brief Write the parsed inputs of the active run to a snapshot
+
+  The run must have read its inputs (see `SW_CTL_read_inputs_from_disk()`)
+  and not yet initialized the simulation (see `SW_CTL_init_run()`).
+  Failure to write a snapshot is not fatal.
+
+  @param fname Name of the snapshot file.
+*/
+void SW_SNAP_write(const char *fname) {
+	SW_SNAP_HEADER h;
+	SW_SNAP_STAMP s;
+	SW_SNAP_BUFFER b = {NULL, 0, 0};
+	IntU i;
+
+	_header(&h, SW_SNAP_MAGIC);
+
+	// Stamps of the input files
+	for (i = 0; i < _n_infiles; i++) {
+		_stamp(InFiles[_infiles[i]], &s);
+		_put(&b, &s, sizeof(s));
+	}
+
+	for (i = 0; i < SW_VegEstab.count; i++) {
+		_stamp(SW_VegEstab.parms[i]->sppFileName, &s);
+		_put(&b, &s, sizeof(s));
+	}
+
+	h.n_stamps = _n_infiles + SW_VegEstab.count;
+
+	// Parsed inputs
+	_put_inputs(&b);
+
+	if (!_write_file(fname, &h, &b)) {
+		LogError(logfp, LOGWARN, "Failed to write input snapshot %s", fname);
+	}
+
+	Mem_Free(b.data);
+}
+
+
+/** @brief Continue the active run from a checkpoint
+
+  The run must be set up from its inputs (see `SW_CTL_init_run()`) but
+  not yet simulated; it continues with the year after the year of the
+  checkpoint, i.e., `SW_MODEL.startyr` becomes that year. The inputs of the
+  run may differ from those of the run that wrote the checkpoint, e.g.,
+  in weather, CO2, or vegetation of the years to come, but must describe
+  the same soil layers and establishment species.
+
+  Output files and arrays should be created after the checkpoint is loaded
+  so that they cover the remaining years.
+
+  @param fname Name of the checkpoint file.
+*/
+void SW_SNAP_read_state(const char *fname) {
+	SW_SNAP_HEADER h;
+	SW_SNAP_BUFFER b = {NULL, 0, 0};
+
+	if (!_read_file(fname, SW_SNAP_STATE_MAGIC, &h, &b)) {
+		LogError(logfp, LOGFATAL, "%s : not a checkpoint of this version of "
+			"SOILWAT2 or corrupted.", fname);
+	}
+
+	_get_checkpoint(&b, fname, swTRUE);
+	Mem_Free(b.data);
+}
+
+
+/** @brief Write a checkpoint of the active run at the end of a year
+
+  A checkpoint holds the state that is carried from one simulation year to
+  the next, e.g., soil water and temperature, snowpack, intercepted and
+  ponded water, the random number generator of the weather generator, and
+  the output accumulators; inputs are not part of a checkpoint.
+
+  @param fname Name of the checkpoint file.
+*/
+void SW_SNAP_write_state(const char *fname) {
+	SW_SNAP_HEADER h;
+	SW_SNAP_BUFFER b = {NULL, 0, 0};
+
+	_header(&h, SW_SNAP_STATE_MAGIC);
+	_put_checkpoint(&b, fname);
+
+	if (!_write_file(fname, &h, &b)) {
+		Mem_Free(b.data);
+		LogError(logfp, LOGFATAL, "Failed to write checkpoint %s", fname);
+	}
+
+	Mem_Free(b.data);
+}
+
+
+/** @brief Continue the active run from a checkpoint in memory
+
+  As `SW_SNAP_read_state()` but from a checkpoint that was stored by
+  `SW_SNAP_store_state()`; the checkpoint is not modified and may be
+  restored into any number of runs, also concurrently by several threads.
+
+  @param state A checkpoint in memory.
+*/
+void SW_SNAP_restore_state(const SW_SNAP_BUFFER *state) {
+	SW_SNAP_BUFFER b = *state;
+
+	b.size = state->pos;
+	b.pos = 0;
+
+	_get_checkpoint(&b, "in-memory checkpoint", swFALSE);
+}
+
+
+/** @brief Store a checkpoint of the active run at the end of a year
+  in memory
+
+  As `SW_SNAP_write_state()` but without a file, e.g., to continue
+  several runs from the state of one run (see `SW_BAT_ensemble()`).
+
+  @param state Upon return, holds the checkpoint; `data` is allocated and
+    must be freed by the caller, `pos` is the size of the checkpoint.
+*/
+void SW_SNAP_store_state(SW_SNAP_BUFFER *state) {
+	state->data = NULL;
+	state->pos = 0;
+	state->size = 0;
+
+	_put_checkpoint(state, "in-memory checkpoint");
+}
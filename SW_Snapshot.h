@@ -0,0 +1,100 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Snapshot.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Snapshot.c: binary snapshot of the parsed and
+    validated inputs of a simulation run that replaces parsing of the
+    text input files as long as they are unchanged, and binary checkpoints
+    of the state of a simulation run at the end of a year
+
+  History:
+  10/18/2026	INITIAL CODING
+  10/18/2026	added checkpoints of the state of a simulation run
+  10/18/2026	added checkpoints in memory
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_SNAPSHOT_H
+#define SW_SNAPSHOT_H
+
+#include <stdint.h>
+#include "generic.h"
+#include "SW_Defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define SW_SNAP_MAGIC "SW2SNAP" /**< Identifies a snapshot file */
+#define SW_SNAP_STATE_MAGIC "SW2STAT" /**< Identifies a checkpoint file */
+#define SW_SNAP_VERSION 3 /**< Version of the file format */
+#define SW_SNAP_BYTEORDER 0x01020304 /**< Detects foreign byte order */
+#define SW_SNAP_NSIZES 16 /**< Number of struct sizes of the header */
+
+
+/** Header of a snapshot or checkpoint file
+
+  The file layout of a snapshot is
+    - header
+    - `n_stamps` x `SW_SNAP_STAMP` of the input files
+    - parsed inputs of the modules in the order of
+      `SW_CTL_read_inputs_from_disk()` (native byte order and layout)
+
+  The file layout of a checkpoint is
+    - header (`n_stamps` is 0)
+    - year that was completed, number of soil layers and of species
+    - state of the modules that is carried from one year to the next
+      (see `SW_SNAP_write_state()`)
+
+  A snapshot is only loaded by the build that wrote it, i.e., if
+  `SW2_VERSION`, `flags`, and `size_structs` agree.
+*/
+typedef struct {
+	char magic[8];
+	uint32_t
+		version,
+		byteorder,
+		flags, /**< Compile-time options that affect the layout */
+		n_stamps;
+	uint32_t size_structs[SW_SNAP_NSIZES]; /**< `sizeof` of the stored structs */
+	char sw2_version[64];
+	uint64_t
+		size, /**< Size of the file in bytes */
+		checksum; /**< FNV-1a hash of everything after the header */
+} SW_SNAP_HEADER;
+
+/** Size and modification time of an input file at the time of parsing */
+typedef struct {
+	char path[MAX_FILENAMESIZE];
+	int64_t
+		size, /**< Size in bytes; -1 if the file did not exist */
+		mtime, /**< Modification time in seconds; -1 if the file did not exist */
+		mtime_ns; /**< Nanoseconds of `mtime`; -1 if the file did not exist */
+} SW_SNAP_STAMP;
+
+
+/** Contents of a snapshot or checkpoint after its header */
+typedef struct {
+	unsigned char *data;
+	size_t pos, /**< Bytes written or read */
+		size; /**< Bytes allocated or available */
+} SW_SNAP_BUFFER;
+
+
+// Function declarations
+Bool SW_SNAP_read(const char *fname);
+void SW_SNAP_write(const char *fname);
+void SW_SNAP_read_state(const char *fname);
+void SW_SNAP_write_state(const char *fname);
+void SW_SNAP_restore_state(const SW_SNAP_BUFFER *state);
+void SW_SNAP_store_state(SW_SNAP_BUFFER *state);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -29,6 +29,9 @@
  06/24/2013	(rjm)	made temp_snow a module-level static variable (instead of function-level): otherwise it will not get reset to 0 between consecutive calls as a dynamic library
  need to set temp_snow to 0 in function SW_SWC_construct()
  06/26/2013	(rjm)	closed open files at end of functions SW_SWC_read(), _read_hist() or if LogError() with LOGFATAL is called
+ 10/18/2026	moved reset of `surfaceWater_yesterday` to SW_SWC_init_run()
+ 10/18/2026	added SW_SWC_swp(): soil water potential of a layer is calculated
+ once for each value of its soil water content
  */
 /********************************************************/
 /********************************************************/
@@ -63,24 +66,28 @@
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
 
-extern SW_MODEL SW_Model;
-extern SW_SITE SW_Site;
-extern SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_VEGPROD SW_VegProd;
 #ifdef RSOILWAT
 	extern Bool useFiles;
 #endif
 
-SW_SOILWAT SW_Soilwat; /* declared here, externed elsewhere */
+SW_TLS SW_SOILWAT SW_Soilwat; /* declared here, externed elsewhere */
 #ifdef SWDEBUG
-  extern SW_WEATHER SW_Weather;
+  extern SW_TLS SW_WEATHER SW_Weather;
 #endif
 
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
-static RealD temp_snow;
+static SW_TLS char *MyFileName;
+SW_TLS RealD temp_snow; /* externed by `SW_Control.c` for `SW_RUN` */
+
+/** Maximal number of intervals per binary order of magnitude of a
+    lookup table of soil water potential, see `SW_SWC_init_swptable()` */
+#define SW_SWPTABLE_MAXN 65536
 
 
 /* =================================================== */
@@ -107,7 +114,7 @@ static void _reset_swc(void) {
 	/* reset swc */
 	ForEachSoilLayer(lyr)
 	{
-		SW_Soilwat.swcBulk[Today][lyr] = SW_Soilwat.swcBulk[Yesterday][lyr] = SW_Site.lyr[lyr]->swcBulk_init;
+		SW_Soilwat.swcBulk[Today][lyr] = SW_Soilwat.swcBulk[Yesterday][lyr] = SW_Site.swcBulk_init[lyr];
 		SW_Soilwat.drain[lyr] = 0.;
 	}
 
@@ -120,6 +127,39 @@ static void _reset_swc(void) {
   }
 }
 
+/**
+  @brief Interpolate soil water potential from a lookup table
+
+  @param t The lookup table of a soil layer, see `SW_SWC_init_swptable()`.
+  @param theta Matric VWC [%].
+  @param swp Set to the interpolated SWP [-bar].
+
+  @return swTRUE if `theta` is covered by the table.
+**/
+static Bool _lookup_swp(const SW_SWPTABLE *t, RealD theta, RealD *swp) {
+	RealD u;
+	unsigned int i;
+	int e;
+	const RealD *p;
+
+	if (!isfinite(theta)) {
+		return swFALSE;
+	}
+
+	u = frexp(theta, &e); // theta = u * 2^e with u in [0.5, 1)
+	if (e < t->e_min || e > t->e_max) {
+		return swFALSE;
+	}
+
+	u = (2. * u - 1.) * t->n; // position in [0, n) between nodes of order e
+	i = (unsigned int) u;
+	p = t->swp + (size_t) (e - t->e_min) * (t->n + 1) + i;
+
+	*swp = p[0] + (u - i) * (p[1] - p[0]);
+
+	return swTRUE;
+}
+
 
 
 #ifdef SWDEBUG
@@ -142,16 +182,9 @@ void SW_WaterBalance_Checks(void)
     delta_swc_total = 0., delta_swcj[MAX_LAYERS];
   RealD lhs, rhs, wbtol = 1e-9;
 
-  static RealD surfaceWater_yesterday;
   static Bool debug = swFALSE;
 
 
-  // re-init static variables on first day of each simulation
-  // to prevent carry-over
-  if (SW_Model.year == SW_Model.startyr && SW_Model.doy == SW_Model.firstdoy) {
-    surfaceWater_yesterday = 0.;
-  }
-
   // Sum up variables
   ForEachSoilLayer(i)
   {
@@ -206,8 +239,8 @@ void SW_WaterBalance_Checks(void)
   // Get state change values
   intercepted = sw->litter_int + int_veg_total;
 
-  delta_surfaceWater = sw->surfaceWater - surfaceWater_yesterday;
-  surfaceWater_yesterday = sw->surfaceWater;
+  delta_surfaceWater = sw->surfaceWater - sw->surfaceWater_yesterday;
+  sw->surfaceWater_yesterday = sw->surfaceWater;
 
 
   //--- Water balance checks (there are # checks n = N_WBCHECKS)
@@ -343,6 +376,7 @@ void SW_WaterBalance_Checks(void)
 void SW_SWC_construct(void) {
 	/* =================================================== */
 	OutPeriod pd;
+	SW_SOILWAT_OUTPUTS *p_accu[SW_OUTNPERIODS], *p_oagg[SW_OUTNPERIODS];
 
 	// Clear memory before setting it
 	if (!isnull(SW_Soilwat.hist.file_prefix)) {
@@ -350,36 +384,52 @@ void SW_SWC_construct(void) {
 		SW_Soilwat.hist.file_prefix = NULL;
 	}
 
+	// Keep output structures of a model that is reset (see `SW_SWC_deconstruct()`)
+	memcpy(p_accu, SW_Soilwat.p_accu, sizeof(p_accu));
+	memcpy(p_oagg, SW_Soilwat.p_oagg, sizeof(p_oagg));
+
 	// Clear the module structure:
 	memset(&SW_Soilwat, 0, sizeof(SW_SOILWAT));
 
-	// Allocate output structures:
+	// Allocate output structures (or clear the kept ones):
 	ForEachOutPeriod(pd)
 	{
-		SW_Soilwat.p_accu[pd] = (SW_SOILWAT_OUTPUTS *) Mem_Calloc(1,
-			sizeof(SW_SOILWAT_OUTPUTS), "SW_SWC_construct()");
+		SW_Soilwat.p_accu[pd] = isnull(p_accu[pd]) ?
+			(SW_SOILWAT_OUTPUTS *) Mem_Calloc(1, sizeof(SW_SOILWAT_OUTPUTS),
+				"SW_SWC_construct()") :
+			(SW_SOILWAT_OUTPUTS *) memset(p_accu[pd], 0, sizeof(SW_SOILWAT_OUTPUTS));
 		if (pd > eSW_Day) {
-			SW_Soilwat.p_oagg[pd] = (SW_SOILWAT_OUTPUTS *) Mem_Calloc(1,
-				sizeof(SW_SOILWAT_OUTPUTS), "SW_SWC_construct()");
+			SW_Soilwat.p_oagg[pd] = isnull(p_oagg[pd]) ?
+				(SW_SOILWAT_OUTPUTS *) Mem_Calloc(1, sizeof(SW_SOILWAT_OUTPUTS),
+					"SW_SWC_construct()") :
+				(SW_SOILWAT_OUTPUTS *) memset(p_oagg[pd], 0, sizeof(SW_SOILWAT_OUTPUTS));
 		}
 	}
 }
 
-void SW_SWC_deconstruct(void)
+/**
+@brief Deconstructor for SW_Soilwat.
+@param full_reset If `swFALSE`, then output structures are kept for the
+  next `SW_SWC_construct()` of a model that is reset
+  (see `SW_CTL_clear_model()`).
+*/
+void SW_SWC_deconstruct(Bool full_reset)
 {
 	OutPeriod pd;
 
-	// De-allocate output structures:
-	ForEachOutPeriod(pd)
-	{
-		if (pd > eSW_Day && !isnull(SW_Soilwat.p_oagg[pd])) {
-			Mem_Free(SW_Soilwat.p_oagg[pd]);
-			SW_Soilwat.p_oagg[pd] = NULL;
-		}
+	// De-allocate output structures (unless kept for a model that is reset):
+	if (full_reset) {
+		ForEachOutPeriod(pd)
+		{
+			if (pd > eSW_Day && !isnull(SW_Soilwat.p_oagg[pd])) {
+				Mem_Free(SW_Soilwat.p_oagg[pd]);
+				SW_Soilwat.p_oagg[pd] = NULL;
+			}
 
-		if (!isnull(SW_Soilwat.p_accu[pd])) {
-			Mem_Free(SW_Soilwat.p_accu[pd]);
-			SW_Soilwat.p_accu[pd] = NULL;
+			if (!isnull(SW_Soilwat.p_accu[pd])) {
+				Mem_Free(SW_Soilwat.p_accu[pd]);
+				SW_Soilwat.p_accu[pd] = NULL;
+			}
 		}
 	}
 
@@ -443,7 +493,7 @@ void SW_SWC_water_flow(void) {
     #ifdef SWDEBUG
     if (debug) swprintf("\n'SW_SWC_water_flow': call 'SW_Water_Flow'.\n");
     #endif
-		SW_Water_Flow();
+		SW_Water_Flow(NULL);
 	}
 
   #ifdef SWDEBUG
@@ -454,7 +504,7 @@ void SW_SWC_water_flow(void) {
   #endif
 	ForEachSoilLayer(i)
 		SW_Soilwat.is_wet[i] = (Bool) (GE( SW_Soilwat.swcBulk[Today][i],
-				SW_Site.lyr[i]->swcBulk_wet));
+				SW_Site.swcBulk_wet[i]));
 }
 
 /**
@@ -475,7 +525,7 @@ void calculate_repartitioned_soilwater(void){
     val = v->swcBulk[Today][i];
     ForEachVegType(j){
       if(SW_VegProd.veg[j].cov.fCover != 0)
-        v->swa_master[j][j][i] = fmax(0., val - SW_Site.lyr[i]->swcBulk_atSWPcrit[j]);
+        v->swa_master[j][j][i] = fmax(0., val - SW_Site.swcBulk_atSWPcrit[j][i]);
       else
         v->swa_master[j][j][i] = 0.;
       v->dSWA_repartitioned_sum[j][i] = 0.; // need to reset to 0 each time
@@ -653,6 +703,8 @@ void SW_SWC_init_run(void) {
 
 	#ifdef SWDEBUG
 		SW_Soilwat.is_wbError_init = swFALSE;
+		// re-init at start of each simulation to prevent carry-over
+		SW_Soilwat.surfaceWater_yesterday = 0.;
 	#endif
 
 	temp_snow = 0.; // module-level snow temperature
@@ -717,7 +769,7 @@ void SW_SWC_read(void) {
 	v->surfaceTemp = 0;
 	LyrIndex i;
 	ForEachSoilLayer(i)
-		v->sTemp[i] = SW_Site.lyr[i]->sTemp;
+		v->sTemp[i] = SW_Site.sTemp[i];
 
 	MyFileName = SW_F_name(eSoilwat);
 	f = OpenFile(MyFileName, "r");
@@ -878,7 +930,7 @@ void SW_SWC_adjust_swc(TimeInt doy) {
 	/* this will guarantee that any method will not lower swc */
 	/* below the minimum defined for the soil layers          */
 	ForEachSoilLayer(lyr){
-		v->swcBulk[Today][lyr] = fmax(v->swcBulk[Today][lyr], SW_Site.lyr[lyr]->swcBulk_min);
+		v->swcBulk[Today][lyr] = fmax(v->swcBulk[Today][lyr], SW_Site.swcBulk_min[lyr]);
   }
 
 }
@@ -1016,7 +1068,7 @@ RealD SW_SnowDepth(RealD SWE, RealD snowdensity) {
 
   @param fractionGravel Fraction of soil containing gravel.
   @param swcBulk Soilwater content of the current layer (cm/layer)
-  @param n Layer number to index the **lyr pointer
+  @param n Layer number (base0) of the soil layers of SW_Site
 
   @return soil water potential
 **/
@@ -1035,7 +1087,7 @@ HISTORY:
     and the previous limit of swp to 80 seems unreasonable.
     return 0.0 if input value is MISSING
 
-   These are the values for each layer obtained via lyr[n]:
+   These are the values of layer n obtained from SW_Site:
 	 width  - width of current soil layer
 	 psisMatric   - "saturation" matric potential
 	 thetasMatric - saturated moisture content.
@@ -1054,7 +1106,6 @@ HISTORY:
 	 psisMatric, bMatric, binverseMatric, thetasMatric are initialized
 	 **********************************************************************/
 
-	SW_LAYER_INFO *lyr = SW_Site.lyr[n];
 	RealD theta1, theta2, swp = .0;
 
 	if (missing(swcBulk) || ZRO(swcBulk))
@@ -1064,17 +1115,23 @@ HISTORY:
 		// we have soil moisture
 
 		// calculate matric VWC [cm / cm %] from bulk VWC
-		theta1 = (swcBulk / lyr->width) * 100. / (1. - fractionGravel);
+		theta1 = (swcBulk / SW_Site.width[n]) * 100. / (1. - fractionGravel);
+
+		// look up SWP if requested and if theta1 is covered by the table
+		if (!isnull(SW_Site.swpTable[n].swp) &&
+			_lookup_swp(&SW_Site.swpTable[n], theta1, &swp)) {
+			return swp;
+		}
 
 		// calculate (VWC / VWC(saturated)) ^ b
-		theta2 = powe(theta1 / lyr->thetasMatric, lyr->bMatric);
+		theta2 = powe(theta1 / SW_Site.thetasMatric[n], SW_Site.bMatric[n]);
 
 		if (isnan(theta2) || ZRO(theta2)) {
 			LogError(logfp, LOGFATAL, "SW_SWCbulk2SWPmatric(): Year = %d, DOY=%d, Layer = %d:\n"
 					"\tinvalid value of (theta / theta(saturated)) ^ b = %f (must be != 0)\n",
 					SW_Model.year, SW_Model.doy, n, theta2);
 		} else {
-			swp = lyr->psisMatric / theta2 / BARCONV;
+			swp = SW_Site.psisMatric[n] / theta2 / BARCONV;
 		}
 
 	} else {
@@ -1085,11 +1142,137 @@ HISTORY:
 	return swp;
 }
 
+/**
+  @brief Soil water potential of the n-th soil layer with a cache
+
+  Returns the same value as `SW_SWCbulk2SWPmatric()` with the gravel content
+  of the layer, i.e., `SW_Site.fractionVolBulk_gravel[n]`, but calculates it
+  only if `swcBulk` differs from the value of the previous call for this
+  layer. Soil water content usually changes in a few layers at a time, e.g.,
+  when water percolates or is extracted, whereas the soil water potential of
+  all layers is used repeatedly each day, e.g., once per vegetation type.
+
+  The cache is cleared with `SW_SWC_clear_swp()` whenever the parameters
+  of the retention curve of a layer change.
+
+  @param swcBulk Soilwater content of the layer (cm/layer)
+  @param n Layer number (base0) of the soil layers of SW_Site
+
+  @return soil water potential (-bar)
+**/
+RealD SW_SWC_swp(RealD swcBulk, LyrIndex n) {
+	SW_SOILWAT *v = &SW_Soilwat;
+
+	// exact comparison: any change of swcBulk requires a new value
+	if (swcBulk != v->swpCache_swc[n]) {
+		v->swpCache_swp[n] = SW_SWCbulk2SWPmatric(
+			SW_Site.fractionVolBulk_gravel[n], swcBulk, n);
+		v->swpCache_swc[n] = swcBulk;
+	}
+
+	return v->swpCache_swp[n];
+}
+
+/**
+  @brief Clear the cache of soil water potential of the n-th soil layer
+
+  @param n Layer number (base0) of the soil layers of SW_Site
+**/
+void SW_SWC_clear_swp(LyrIndex n) {
+	SW_Soilwat.swpCache_swc[n] = 0.;
+	SW_Soilwat.swpCache_swp[n] = 0.;
+}
+
+/**
+  @brief Set up the lookup table of soil water potential of the n-th soil
+         layer, see `SW_SWCbulk2SWPmatric()`
+
+  SWP is a power function of matric VWC (Cosby et al. 1984), i.e.,
+  `swp = c * theta^(-b)`. The table covers matric VWC from half of the
+  minimal SWC (or an eighth of the wilting point if the minimum is 0)
+  to saturation in intervals that grow with `theta` so that the relative
+  error of the linear interpolation of `theta^(-b)` on an interval
+  `[theta, theta + h]` with `h <= theta / n`, i.e.,
+  `b (b + 1) / (8 n^2) * (1 + 1 / n)^b`, is at most `tolerance`.
+  SWP outside of the table is calculated exactly.
+
+  The code assumes that `SW_SIT_init_run()` has calculated the parameters
+  of the retention curve and the limits of SWC of the layer.
+
+  @param n Layer number (base0) of the soil layers of SW_Site.
+  @param tolerance Maximal relative error of the interpolated SWP;
+    no table is set up if `tolerance` is 0.
+**/
+void SW_SWC_init_swptable(LyrIndex n, RealD tolerance) {
+	SW_SWPTABLE *t = &SW_Site.swpTable[n];
+	RealD
+		b = SW_Site.bMatric[n],
+		convert = 100. / (1. - SW_Site.fractionVolBulk_gravel[n]) / SW_Site.width[n],
+		theta_min, theta_max, theta;
+	unsigned int i, k;
+	int e;
+
+	SW_SWC_deconstruct_swptable(n);
+	SW_SWC_clear_swp(n);
+
+	if (!GT(tolerance, 0.)) {
+		return;
+	}
+
+	// number of intervals per binary order of magnitude of theta
+	t->n = (unsigned int) fmax(1., ceil(sqrt(b * (b + 1.) / (8. * tolerance))));
+	while (t->n <= SW_SWPTABLE_MAXN &&
+		b * (b + 1.) / (8. * squared(t->n)) * pow(1. + 1. / t->n, b) > tolerance) {
+		t->n += 1 + t->n / 100;
+	}
+
+	if (t->n > SW_SWPTABLE_MAXN) {
+		LogError(logfp, LOGWARN, "Layer %d: tolerance of tabulated SWP (%g)"
+			" is too small; SWP is calculated exactly.", n + 1, tolerance);
+		return;
+	}
+
+	// range of matric VWC [%]
+	theta_min = convert * (GT(SW_Site.swcBulk_min[n], 0.) ?
+		SW_Site.swcBulk_min[n] / 2. : SW_Site.swcBulk_wiltpt[n] / 8.);
+	theta_max = fmax(SW_Site.thetasMatric[n], convert * SW_Site.swcBulk_saturated[n]);
+
+	frexp(theta_min, &t->e_min);
+	frexp(theta_max, &t->e_max);
+
+	t->swp = (RealD *) Mem_Malloc(
+		sizeof(RealD) * (t->e_max - t->e_min + 1) * (t->n + 1),
+		"SW_SWC_init_swptable()");
+
+	// nodes of each binary order of magnitude: theta = 2^(e-1) * (1 + i / n)
+	for (e = t->e_min, k = 0; e <= t->e_max; e++) {
+		for (i = 0; i <= t->n; i++, k++) {
+			theta = ldexp(0.5 + 0.5 * i / t->n, e);
+			t->swp[k] = SW_Site.psisMatric[n] /
+				powe(theta / SW_Site.thetasMatric[n], SW_Site.bMatric[n]) / BARCONV;
+		}
+	}
+}
+
+/**
+  @brief Free the lookup table of soil water potential of the n-th soil layer
+
+  @param n Layer number (base0) of the soil layers of SW_Site.
+**/
+void SW_SWC_deconstruct_swptable(LyrIndex n) {
+	SW_SWPTABLE *t = &SW_Site.swpTable[n];
+
+	if (!isnull(t->swp)) {
+		Mem_Free(t->swp);
+		t->swp = NULL;
+	}
+}
+
 /**
 @brief Convert soil water potential to bulk volumetric water content.
 
 @param fractionGravel Fraction of soil containing gravel, percentage.
-@param swpMatric lyr->psisMatric calculated in water equation function
+@param swpMatric SW_Site.psisMatric[n] calculated in water equation function
 @param n Layer of soil.
 
 @return Volumentric water content (cm H<SUB>2</SUB>O/cm SOIL).
@@ -1104,11 +1287,10 @@ RealD SW_SWPmatric2VWCBulk(RealD fractionGravel, RealD swpMatric, LyrIndex n) {
     27-Aug-03 (cwb) moved from the Site module.
 **/
 
-	SW_LAYER_INFO *lyr = SW_Site.lyr[n];
 	RealD t, p;
 	swpMatric *= BARCONV;
-	p = powe(lyr->psisMatric / swpMatric, lyr->binverseMatric); // lyr->psisMatric calculated in water equation function | todo: check to make sure these are calculated before
-  t = lyr->thetasMatric * p * 0.01 * (1 - fractionGravel);
+	p = powe(SW_Site.psisMatric[n] / swpMatric, SW_Site.binverseMatric[n]); // SW_Site.psisMatric[n] calculated in water equation function | todo: check to make sure these are calculated before
+  t = SW_Site.thetasMatric[n] * p * 0.01 * (1 - fractionGravel);
 	return (t);
 }
 
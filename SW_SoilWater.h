@@ -34,6 +34,7 @@
  modified the use of these variables throughout the rest of the code.
  07/09/2013	(clk)	Added the variables transp_forb, evap_veg[SW_FORBS], hydred[SW_FORBS], and int_veg[SW_FORBS] to SW_SOILWAT_OUTPUTS
  Added the variables transpiration_forb, hydred[SW_FORBS], evap_veg[SW_FORBS], and int_veg[SW_FORBS] to SW_SOILWAT
+ 10/18/2026	added cache of soil water potential swpCache_swc, swpCache_swp to SW_SOILWAT
  */
 /********************************************************/
 /********************************************************/
@@ -117,12 +118,18 @@ typedef struct {
 	RealF swa_master[NVEGTYPES][NVEGTYPES][MAX_LAYERS]; // veg_type, crit_val, layer
 	RealF dSWA_repartitioned_sum[NVEGTYPES][MAX_LAYERS];
 
+	/* cache of soil water potential for each layer, see `SW_SWC_swp()`:
+	   swpCache_swp is the soil water potential (-bar) of swpCache_swc;
+	   all zero is valid (no soil water => zero soil water potential) */
+	RealD swpCache_swc[MAX_LAYERS], swpCache_swp[MAX_LAYERS];
+
 	Bool soiltempError; // soil temperature error indicator
 	#ifdef SWDEBUG
 	int wbError[N_WBCHECKS]; /* water balance and water cycling error indicators (currently 8)
 	    0, no error detected; > 0, number of errors detected */
   char *wbErrorNames[N_WBCHECKS];
   Bool is_wbError_init;
+  RealD surfaceWater_yesterday; // ponded water of previous day for water balance checks
   #endif
 
 	SW_SOILWAT_OUTPUTS
@@ -134,7 +141,7 @@ typedef struct {
 } SW_SOILWAT;
 
 void SW_SWC_construct(void);
-void SW_SWC_deconstruct(void);
+void SW_SWC_deconstruct(Bool full_reset);
 void SW_SWC_new_year(void);
 void SW_SWC_read(void);
 void SW_SWC_init_run(void);
@@ -148,7 +155,11 @@ RealD SW_SWC_snowloss(RealD pet, RealD *snowpack);
 RealD SW_SnowDepth(RealD SWE, RealD snowdensity);
 void SW_SWC_end_day(void);
 RealD SW_SWCbulk2SWPmatric(RealD fractionGravel, RealD swcBulk, LyrIndex n);
+RealD SW_SWC_swp(RealD swcBulk, LyrIndex n);
+void SW_SWC_clear_swp(LyrIndex n);
 RealD SW_SWPmatric2VWCBulk(RealD fractionGravel, RealD swpMatric, LyrIndex n);
+void SW_SWC_init_swptable(LyrIndex n, RealD tolerance);
+void SW_SWC_deconstruct_swptable(LyrIndex n);
 RealD SW_VWCBulkRes(RealD fractionGravel, RealD sand, RealD clay, RealD porosity);
 void get_dSWAbulk(int i);
 
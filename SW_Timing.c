@@ -0,0 +1,213 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Wall time and call counts of the phases of the daily step
+
+  The phases of a simulation run (see `SW_TIM_PHASE`) are bracketed by
+  `SW_TIMER_START()` and `SW_TIMER_STOP()` which expand to nothing unless
+  SOILWAT2 is compiled with `SW_TIMING`. Each thread accumulates its own
+  totals; batch workers add theirs to the process-wide totals with
+  `SW_TIM_merge()` when they are done. SOILWAT2-standalone prints the
+  totals at the end of `main()` (see `SW_TIM_print()`).
+
+  History:
+  10/18/2026	INITIAL CODING
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+/* `clock_gettime()` and `CLOCK_MONOTONIC` are POSIX, not part of `-std=c11` */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef SWTHREADS
+	#include <pthread.h>
+#endif
+
+#include "generic.h"
+#include "SW_Timing.h"
+
+
+/* =================================================== */
+/*                Module-Level Variables               */
+/* --------------------------------------------------- */
+
+/** Accumulated wall time and number of calls of each phase */
+typedef struct {
+	double seconds[SW_TIM_NPHASES];
+	unsigned long calls[SW_TIM_NPHASES];
+} SW_TIM_TOTALS;
+
+static SW_TLS SW_TIM_TOTALS _thread; /* totals of the calling thread */
+static SW_TLS double _started[SW_TIM_NPHASES]; /* start of running timers */
+static SW_TIM_TOTALS _merged; /* totals of merged threads; process-wide */
+
+static const char *_names[SW_TIM_NPHASES] = {
+	"SW_WTH_new_day", "solar_radiation+petfunc", "interception",
+	"infiltrate_water_high", "transp_weighted_avg", "hydraulic_redistribution",
+	"soil_temperature", "SW_OUT_sum_today", "SW_OUT_write_today",
+	"SW_F_read", "SW_SNAP_read+write", "SW_MDL_read", "SW_WTH_read",
+	"SW_SKY_read", "SW_MKV_setup", "SW_VPD_read", "SW_SIT_read",
+	"SW_VES_read", "SW_OUT_read", "SW_CBN_read", "SW_SWC_read"
+};
+
+#ifdef SWTHREADS
+static pthread_mutex_t _merged_lock = PTHREAD_MUTEX_INITIALIZER;
+	#define _lock_merged() pthread_mutex_lock(&_merged_lock)
+	#define _unlock_merged() pthread_mutex_unlock(&_merged_lock)
+#else
+	#define _lock_merged()
+	#define _unlock_merged()
+#endif
+
+
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+/** @return Seconds of a monotonic wall clock */
+static double _now(void) {
+	#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+	#else
+	return (double) clock() / CLOCKS_PER_SEC;
+	#endif
+}
+
+
+
+/* =================================================== */
+/*             Function Definitions                    */
+/*             (declared in SW_Timing.h)               */
+/* --------------------------------------------------- */
+
+/** @brief Start the timer of phase `p` of the calling thread
+
+  @param p The phase.
+*/
+void SW_TIM_start(SW_TIM_PHASE p) {
+	_started[p] = _now();
+}
+
+/** @brief Stop the timer of phase `p` of the calling thread and add the
+  elapsed time and one call to its totals
+
+  @param p The phase.
+*/
+void SW_TIM_stop(SW_TIM_PHASE p) {
+	_thread.seconds[p] += _now() - _started[p];
+	_thread.calls[p]++;
+}
+
+/** @brief Add the totals of the calling thread to the process-wide totals
+  and reset the totals of the calling thread
+
+  Call this routine before a worker thread ends.
+*/
+void SW_TIM_merge(void) {
+	int p;
+
+	_lock_merged();
+	for (p = 0; p < SW_TIM_NPHASES; p++) {
+		_merged.seconds[p] += _thread.seconds[p];
+		_merged.calls[p] += _thread.calls[p];
+	}
+	_unlock_merged();
+
+	memset(&_thread, 0, sizeof _thread);
+}
+
+/** @brief Reset the totals of the calling thread and the process-wide totals
+*/
+void SW_TIM_reset(void) {
+	_lock_merged();
+	memset(&_merged, 0, sizeof _merged);
+	_unlock_merged();
+
+	memset(&_thread, 0, sizeof _thread);
+}
+
+/** @brief Wall time spent in a phase
+
+  @param p The phase.
+
+  @return Seconds spent in phase `p` by the calling thread and by all
+    merged threads.
+*/
+double SW_TIM_seconds(SW_TIM_PHASE p) {
+	double res;
+
+	_lock_merged();
+	res = _merged.seconds[p] + _thread.seconds[p];
+	_unlock_merged();
+
+	return res;
+}
+
+/** @brief Number of times a phase was timed
+
+  @param p The phase.
+
+  @return Number of calls of phase `p` by the calling thread and by all
+    merged threads.
+*/
+unsigned long SW_TIM_calls(SW_TIM_PHASE p) {
+	unsigned long res;
+
+	_lock_merged();
+	res = _merged.calls[p] + _thread.calls[p];
+	_unlock_merged();
+
+	return res;
+}
+
+/** @brief Name of a phase
+
+  @param p The phase.
+
+  @return The name of the function (or group of functions) of phase `p`.
+*/
+const char *SW_TIM_name(SW_TIM_PHASE p) {
+	return _names[p];
+}
+
+/** @brief Print a table of the totals of all phases
+
+  @param f An open file, e.g., `stdout`.
+*/
+void SW_TIM_print(FILE *f) {
+	int p;
+	unsigned long n;
+	double s, total = 0.;
+
+	for (p = 0; p < SW_TIM_NPHASES; p++) {
+		total += SW_TIM_seconds((SW_TIM_PHASE) p);
+	}
+
+	fprintf(f, "\n%-26s %12s %12s %7s %12s\n",
+		"Phase", "Calls", "Seconds", "Share", "us/call");
+
+	for (p = 0; p < SW_TIM_NPHASES; p++) {
+		n = SW_TIM_calls((SW_TIM_PHASE) p);
+		s = SW_TIM_seconds((SW_TIM_PHASE) p);
+
+		fprintf(f, "%-26s %12lu %12.4f %6.1f%% %12.3f\n",
+			_names[p], n, s,
+			(total > 0.) ? 100. * s / total : 0.,
+			(n > 0) ? 1e6 * s / (double) n : 0.);
+	}
+
+	fprintf(f, "%-26s %12s %12.4f\n", "Total", "", total);
+}
@@ -0,0 +1,81 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Timing.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Timing.c: wall time and call counts of the
+    phases of the daily step of a simulation run
+
+  History:
+  10/18/2026	INITIAL CODING
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_TIMING_H
+#define SW_TIMING_H
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/** Timed phases of a simulation run */
+typedef enum {
+	eSW_TimNewDay, /**< `SW_WTH_new_day()` */
+	eSW_TimRadiationPET, /**< `solar_radiation()` and `petfunc()` */
+	eSW_TimInterception, /**< canopy and litter interception */
+	eSW_TimInfiltration, /**< `infiltrate_water_high()` */
+	eSW_TimTranspAvg, /**< `transp_weighted_avg()` */
+	eSW_TimHydRed, /**< `hydraulic_redistribution()` */
+	eSW_TimSoilTemp, /**< `soil_temperature()` */
+	eSW_TimOutSum, /**< `SW_OUT_sum_today()` */
+	eSW_TimOutWrite, /**< `SW_OUT_write_today()` */
+	eSW_TimReadFiles, /**< `SW_F_read()` */
+	eSW_TimReadSnapshot, /**< `SW_SNAP_read()` and `SW_SNAP_write()` */
+	eSW_TimReadModel, /**< `SW_MDL_read()` */
+	eSW_TimReadWeather, /**< `SW_WTH_read()` */
+	eSW_TimReadSky, /**< `SW_SKY_read()` */
+	eSW_TimReadMarkov, /**< `SW_MKV_setup()` */
+	eSW_TimReadVegProd, /**< `SW_VPD_read()` */
+	eSW_TimReadSite, /**< `SW_SIT_read()` */
+	eSW_TimReadVegEstab, /**< `SW_VES_read()` */
+	eSW_TimReadOutput, /**< `SW_OUT_read()` */
+	eSW_TimReadCarbon, /**< `SW_CBN_read()` */
+	eSW_TimReadSWC, /**< `SW_SWC_read()` */
+	SW_TIM_NPHASES
+} SW_TIM_PHASE;
+
+
+/** @brief Start and stop timing of phase `p`
+
+  The timer macros expand to nothing unless SOILWAT2 is compiled with
+  `SW_TIMING`, e.g., `make bin CPPFLAGS=-DSW_TIMING`.
+*/
+#ifdef SW_TIMING
+	#define SW_TIMER_START(p) SW_TIM_start(p)
+	#define SW_TIMER_STOP(p) SW_TIM_stop(p)
+#else
+	#define SW_TIMER_START(p)
+	#define SW_TIMER_STOP(p)
+#endif
+
+
+// Function declarations
+void SW_TIM_start(SW_TIM_PHASE p);
+void SW_TIM_stop(SW_TIM_PHASE p);
+void SW_TIM_merge(void);
+void SW_TIM_reset(void);
+double SW_TIM_seconds(SW_TIM_PHASE p);
+unsigned long SW_TIM_calls(SW_TIM_PHASE p);
+const char *SW_TIM_name(SW_TIM_PHASE p);
+void SW_TIM_print(FILE *f);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
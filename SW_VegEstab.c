@@ -50,18 +50,18 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
-extern SW_SITE SW_Site;
-extern SW_WEATHER SW_Weather;
-extern SW_SOILWAT SW_Soilwat;
-extern Bool EchoInits;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS Bool EchoInits;
 
-SW_VEGESTAB SW_VegEstab; /* declared here, externed elsewhere */
+SW_TLS SW_VEGESTAB SW_VegEstab; /* declared here, externed elsewhere */
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 /* =================================================== */
 /* =================================================== */
@@ -88,26 +88,38 @@ void SW_VES_construct(void) {
 	 * before clearing structure.
 	 */
 	OutPeriod pd;
+	SW_VEGESTAB_OUTPUTS *p_accu[SW_OUTNPERIODS], *p_oagg[SW_OUTNPERIODS];
+
+	// Keep output structures of a model that is reset (see `SW_VES_deconstruct()`)
+	memcpy(p_accu, SW_VegEstab.p_accu, sizeof(p_accu));
+	memcpy(p_oagg, SW_VegEstab.p_oagg, sizeof(p_oagg));
 
 	// Clear the module structure:
 	memset(&SW_VegEstab, 0, sizeof(SW_VegEstab));
 
-	// Allocate output structures:
+	// Allocate output structures (or clear the kept ones):
 	ForEachOutPeriod(pd)
 	{
-		SW_VegEstab.p_accu[pd] = (SW_VEGESTAB_OUTPUTS *) Mem_Calloc(1,
-			sizeof(SW_VEGESTAB_OUTPUTS), "SW_VES_construct()");
+		SW_VegEstab.p_accu[pd] = isnull(p_accu[pd]) ?
+			(SW_VEGESTAB_OUTPUTS *) Mem_Calloc(1, sizeof(SW_VEGESTAB_OUTPUTS),
+				"SW_VES_construct()") :
+			(SW_VEGESTAB_OUTPUTS *) memset(p_accu[pd], 0, sizeof(SW_VEGESTAB_OUTPUTS));
 		if (pd > eSW_Day) {
-			SW_VegEstab.p_oagg[pd] = (SW_VEGESTAB_OUTPUTS *) Mem_Calloc(1,
-				sizeof(SW_VEGESTAB_OUTPUTS), "SW_VES_construct()");
+			SW_VegEstab.p_oagg[pd] = isnull(p_oagg[pd]) ?
+				(SW_VEGESTAB_OUTPUTS *) Mem_Calloc(1, sizeof(SW_VEGESTAB_OUTPUTS),
+					"SW_VES_construct()") :
+				(SW_VEGESTAB_OUTPUTS *) memset(p_oagg[pd], 0, sizeof(SW_VEGESTAB_OUTPUTS));
 		}
 	}
 }
 
 /**
 @brief Deconstructor for SW_VegEstab for each period, pd.
+@param full_reset If `swFALSE`, then output structures are kept for the
+  next `SW_VES_construct()` of a model that is reset
+  (see `SW_CTL_clear_model()`).
 */
-void SW_VES_deconstruct(void)
+void SW_VES_deconstruct(Bool full_reset)
 {
 	OutPeriod pd;
 	IntU i;
@@ -140,7 +152,11 @@ void SW_VES_deconstruct(void)
 			}
 		}
 
-		// De-allocate output structures
+		// De-allocate output structures (unless kept for a model that is reset)
+		if (!full_reset) {
+			continue;
+		}
+
 		if (pd > eSW_Day && !isnull(SW_VegEstab.p_oagg[pd])) {
 			Mem_Free(SW_VegEstab.p_oagg[pd]);
 			SW_VegEstab.p_oagg[pd] = NULL;
@@ -419,20 +435,19 @@ static void _read_spp(const char *infile) {
 void _spp_init(unsigned int sppnum) {
 
 	SW_VEGESTAB_INFO *v = SW_VegEstab.parms[sppnum];
-	SW_LAYER_INFO **lyr = SW_Site.lyr;
 	IntU i;
 
 	/* The thetas and psis etc should be initialized by now */
 	/* because init_layers() must be called prior to this routine */
 	/* (see watereqn() ) */
-	v->min_swc_germ = SW_SWPmatric2VWCBulk(lyr[0]->fractionVolBulk_gravel, v->bars[SW_GERM_BARS], 0) * lyr[0]->width;
+	v->min_swc_germ = SW_SWPmatric2VWCBulk(SW_Site.fractionVolBulk_gravel[0], v->bars[SW_GERM_BARS], 0) * SW_Site.width[0];
 
 	/* due to possible differences in layer textures and widths, we need
 	 * to average the estab swc across the given layers to peoperly
 	 * compare the actual swc average in the checkit() routine */
 	v->min_swc_estab = 0.;
 	for (i = 0; i < v->estab_lyrs; i++)
-		v->min_swc_estab += SW_SWPmatric2VWCBulk(lyr[i]->fractionVolBulk_gravel, v->bars[SW_ESTAB_BARS], i) * lyr[i]->width;
+		v->min_swc_estab += SW_SWPmatric2VWCBulk(SW_Site.fractionVolBulk_gravel[i], v->bars[SW_ESTAB_BARS], i) * SW_Site.width[i];
 	v->min_swc_estab /= v->estab_lyrs;
 
 	_sanity_check(sppnum);
@@ -441,7 +456,6 @@ void _spp_init(unsigned int sppnum) {
 
 static void _sanity_check(unsigned int sppnum) {
 	/* =================================================== */
-	SW_LAYER_INFO **lyr = SW_Site.lyr;
 	SW_VEGESTAB_INFO *v = SW_VegEstab.parms[sppnum];
 	LyrIndex min_transp_lyrs;
 	int k;
@@ -464,12 +478,12 @@ static void _sanity_check(unsigned int sppnum) {
 				v->max_days_germ2estab);
 	}
 
-	if (v->min_swc_germ < lyr[0]->swcBulk_wiltpt) {
-		LogError(logfp, LOGFATAL, "%s : Minimum swc for germination (%.4f) < wiltpoint (%.4f)", MyFileName, v->min_swc_germ, lyr[0]->swcBulk_wiltpt);
+	if (v->min_swc_germ < SW_Site.swcBulk_wiltpt[0]) {
+		LogError(logfp, LOGFATAL, "%s : Minimum swc for germination (%.4f) < wiltpoint (%.4f)", MyFileName, v->min_swc_germ, SW_Site.swcBulk_wiltpt[0]);
 	}
 
-	if (v->min_swc_estab < lyr[0]->swcBulk_wiltpt) {
-		LogError(logfp, LOGFATAL, "%s : Minimum swc for establishment (%.4f) < wiltpoint (%.4f)", MyFileName, v->min_swc_estab, lyr[0]->swcBulk_wiltpt);
+	if (v->min_swc_estab < SW_Site.swcBulk_wiltpt[0]) {
+		LogError(logfp, LOGFATAL, "%s : Minimum swc for establishment (%.4f) < wiltpoint (%.4f)", MyFileName, v->min_swc_estab, SW_Site.swcBulk_wiltpt[0]);
 	}
 
 }
@@ -501,7 +515,6 @@ unsigned int _new_species(void) {
 void _echo_VegEstab(void) {
 	/* --------------------------------------------------- */
 	SW_VEGESTAB_INFO **v = SW_VegEstab.parms;
-	SW_LAYER_INFO **lyr = SW_Site.lyr;
 	IntU i;
 	char outstr[2048];
 
@@ -522,7 +535,7 @@ void _echo_VegEstab(void) {
 				"\tFirst possible day  : %d\n"
 				"\tLast  possible day  : %d\n"
 				"\tMinimum consecutive wet days (after first possible day): %d\n",
-				v[i]->sppname, v[i]->bars[SW_GERM_BARS], v[i]->min_swc_germ / lyr[0]->width,
+				v[i]->sppname, v[i]->bars[SW_GERM_BARS], v[i]->min_swc_germ / SW_Site.width[0],
 				v[i]->min_swc_germ, v[i]->min_temp_germ, v[i]->max_temp_germ,
 				v[i]->min_pregerm_days, v[i]->max_pregerm_days, v[i]->min_wetdays_for_germ);
 
@@ -91,7 +91,7 @@ typedef struct {
 
 void SW_VES_read(void);
 void SW_VES_construct(void);
-void SW_VES_deconstruct(void);
+void SW_VES_deconstruct(Bool full_reset);
 void SW_VES_init(void);
 void SW_VegEstab_construct(void);
 void SW_VES_checkestab(void);
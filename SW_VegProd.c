@@ -57,17 +57,17 @@ changed _echo_inits() to now display the bare ground components in logfile.log
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern Bool EchoInits;
-extern SW_MODEL SW_Model;
+extern SW_TLS Bool EchoInits;
+extern SW_TLS SW_MODEL SW_Model;
 
 
 
-SW_VEGPROD SW_VegProd; /* declared here, externed elsewhere */
+SW_TLS SW_VEGPROD SW_VegProd; /* declared here, externed elsewhere */
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 // key2veg must be in the same order as the indices to vegetation types defined in SW_Defines.h
 char const *key2veg[] = {"Trees", "Shrubs", "Forbs", "Grasses"};
@@ -560,18 +560,27 @@ void SW_VPD_fix_cover(void)
 void SW_VPD_construct(void) {
 	/* =================================================== */
 	OutPeriod pd;
+	SW_VEGPROD_OUTPUTS *p_accu[SW_OUTNPERIODS], *p_oagg[SW_OUTNPERIODS];
+
+	// Keep output structures of a model that is reset (see `SW_VPD_deconstruct()`)
+	memcpy(p_accu, SW_VegProd.p_accu, sizeof(p_accu));
+	memcpy(p_oagg, SW_VegProd.p_oagg, sizeof(p_oagg));
 
 	// Clear the module structure:
 	memset(&SW_VegProd, 0, sizeof(SW_VegProd));
 
-	// Allocate output structures:
+	// Allocate output structures (or clear the kept ones):
 	ForEachOutPeriod(pd)
 	{
-		SW_VegProd.p_accu[pd] = (SW_VEGPROD_OUTPUTS *) Mem_Calloc(1,
-			sizeof(SW_VEGPROD_OUTPUTS), "SW_VPD_construct()");
+		SW_VegProd.p_accu[pd] = isnull(p_accu[pd]) ?
+			(SW_VEGPROD_OUTPUTS *) Mem_Calloc(1, sizeof(SW_VEGPROD_OUTPUTS),
+				"SW_VPD_construct()") :
+			(SW_VEGPROD_OUTPUTS *) memset(p_accu[pd], 0, sizeof(SW_VEGPROD_OUTPUTS));
 		if (pd > eSW_Day) {
-			SW_VegProd.p_oagg[pd] = (SW_VEGPROD_OUTPUTS *) Mem_Calloc(1,
-				sizeof(SW_VEGPROD_OUTPUTS), "SW_VPD_construct()");
+			SW_VegProd.p_oagg[pd] = isnull(p_oagg[pd]) ?
+				(SW_VEGPROD_OUTPUTS *) Mem_Calloc(1, sizeof(SW_VEGPROD_OUTPUTS),
+					"SW_VPD_construct()") :
+				(SW_VEGPROD_OUTPUTS *) memset(p_oagg[pd], 0, sizeof(SW_VEGPROD_OUTPUTS));
 		}
 	}
 }
@@ -596,22 +605,27 @@ void SW_VPD_init_run(void) {
 
 /**
 @brief Deconstructor for SW_VegProd.
+@param full_reset If `swFALSE`, then output structures are kept for the
+  next `SW_VPD_construct()` of a model that is reset
+  (see `SW_CTL_clear_model()`).
 */
-void SW_VPD_deconstruct(void)
+void SW_VPD_deconstruct(Bool full_reset)
 {
 	OutPeriod pd;
 
-	// De-allocate output structures:
-	ForEachOutPeriod(pd)
-	{
-		if (pd > eSW_Day && !isnull(SW_VegProd.p_oagg[pd])) {
-			Mem_Free(SW_VegProd.p_oagg[pd]);
-			SW_VegProd.p_oagg[pd] = NULL;
-		}
+	// De-allocate output structures (unless kept for a model that is reset):
+	if (full_reset) {
+		ForEachOutPeriod(pd)
+		{
+			if (pd > eSW_Day && !isnull(SW_VegProd.p_oagg[pd])) {
+				Mem_Free(SW_VegProd.p_oagg[pd]);
+				SW_VegProd.p_oagg[pd] = NULL;
+			}
 
-		if (!isnull(SW_VegProd.p_accu[pd])) {
-			Mem_Free(SW_VegProd.p_accu[pd]);
-			SW_VegProd.p_accu[pd] = NULL;
+			if (!isnull(SW_VegProd.p_accu[pd])) {
+				Mem_Free(SW_VegProd.p_accu[pd]);
+				SW_VegProd.p_accu[pd] = NULL;
+			}
 		}
 	}
 }
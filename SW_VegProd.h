@@ -249,7 +249,7 @@ void SW_VPD_new_year(void);
 void SW_VPD_fix_cover(void);
 void SW_VPD_construct(void);
 void SW_VPD_init_run(void);
-void SW_VPD_deconstruct(void);
+void SW_VPD_deconstruct(Bool full_reset);
 void apply_biomassCO2effect(double* new_biomass, double *biomass, double multiplier);
 RealD sum_across_vegtypes(RealD *x);
 void _echo_VegProd(void);
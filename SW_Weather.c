@@ -34,6 +34,10 @@
  need to set these variables to 0 resp TRUE in function SW_WTH_construct()
  06/27/2013	(drs)	closed open files if LogError() with LOGFATAL is called in SW_WTH_read(), _read_hist()
  08/26/2013 (rjm) removed extern SW_OUTPUT never used.
+ 10/18/2026	daily weather can be read from a binary weather store (see SW_Weather_store.c)
+ 10/18/2026	all years of daily weather can be preloaded (see `PreloadWeather`)
+ 10/18/2026	moved set up of weather stores into SW_WTH_setup_daily() for input snapshots
+ 10/18/2026	years without weather file are generated at once (see SW_MKV_generate_year())
  */
 /********************************************************/
 /********************************************************/
@@ -52,6 +56,7 @@
 #include "SW_Markov.h"
 
 #include "SW_Weather.h"
+#include "SW_Weather_store.h"
 #ifdef RSOILWAT
   #include "../rSW_Weather.h"
 #endif
@@ -59,20 +64,21 @@
 /* =================================================== */
 /*                  Global Variables                   */
 /* --------------------------------------------------- */
-extern SW_MODEL SW_Model;
+extern SW_TLS SW_MODEL SW_Model;
+extern Bool PreloadWeather;
 
-SW_WEATHER SW_Weather; /* declared here, externed elsewhere */
+SW_TLS SW_WEATHER SW_Weather; /* declared here, externed elsewhere */
 
 /** `swTRUE`/`swFALSE` if historical daily meteorological inputs
     are available/not available for the current simulation year
 */
-Bool weth_found;
+SW_TLS Bool weth_found;
 
 
 /* =================================================== */
 /*                Module-Level Variables               */
 /* --------------------------------------------------- */
-static char *MyFileName;
+static SW_TLS char *MyFileName;
 
 
 /* =================================================== */
@@ -81,17 +87,21 @@ static char *MyFileName;
 /* --------------------------------------------------- */
 
 static void _update_yesterday(void);
+static void _clear_hist(SW_WEATHER_HIST *wh);
+
+static void _clear_hist(SW_WEATHER_HIST *wh) {
+	TimeInt d;
+
+	for (d = 0; d < MAX_DAYS; d++)
+		wh->ppt[d] = wh->temp_max[d] = wh->temp_min[d] = wh->temp_avg[d] = SW_MISSING;
+}
 
 /**
 @brief Clears weather history.
 */
 void _clear_hist_weather(void) {
 	/* --------------------------------------------------- */
-	SW_WEATHER_HIST *wh = &SW_Weather.hist;
-	TimeInt d;
-
-	for (d = 0; d < MAX_DAYS; d++)
-		wh->ppt[d] = wh->temp_max[d] = wh->temp_min[d] = SW_MISSING;
+	_clear_hist(&SW_Weather.hist);
 }
 
 
@@ -107,26 +117,29 @@ static void _todays_weth(RealD *tmax, RealD *tmin, RealD *ppt) {
 	 * default is 0.
 	 */
 	SW_WEATHER *w = &SW_Weather;
+	const SW_WEATHER_HIST *wh = isnull(w->p_hist) ? &w->hist : w->p_hist;
 	TimeInt doy = SW_Model.doy - 1;
 	Bool no_missing = swTRUE;
 
 	if (!weth_found) {
-		// no weather input file for current year ==> use weather generator
-		*ppt = w->now.ppt[Yesterday]; /* reqd for markov */
-		SW_MKV_today(doy, tmax, tmin, ppt);
+		// no weather input file for current year ==> use weather that
+		// the weather generator produced for this year (see SW_WTH_new_year())
+		*tmax = w->hist.temp_max[doy];
+		*tmin = w->hist.temp_min[doy];
+		*ppt = w->hist.ppt[doy];
 
 	} else {
 		// weather input file for current year available
 
-		no_missing = (Bool) (!missing(w->hist.temp_max[doy]) &&
-									!missing(w->hist.temp_min[doy]) &&
-									!missing(w->hist.ppt[doy]));
+		no_missing = (Bool) (!missing(wh->temp_max[doy]) &&
+									!missing(wh->temp_min[doy]) &&
+									!missing(wh->ppt[doy]));
 
 		if (no_missing) {
 			// all values available
-			*tmax = w->hist.temp_max[doy];
-			*tmin = w->hist.temp_min[doy];
-			*ppt = w->hist.ppt[doy];
+			*tmax = wh->temp_max[doy];
+			*tmin = wh->temp_min[doy];
+			*ppt = wh->ppt[doy];
 
 		} else {
 			// some of today's values are missing
@@ -139,9 +152,9 @@ static void _todays_weth(RealD *tmax, RealD *tmin, RealD *ppt) {
 			} else {
 				// impute missing values with 0 for precipitation and
 				// with LOCF for temperature (i.e., last-observation-carried-forward)
-				*tmax = (!missing(w->hist.temp_max[doy])) ? w->hist.temp_max[doy] : w->now.temp_max[Yesterday];
-				*tmin = (!missing(w->hist.temp_min[doy])) ? w->hist.temp_min[doy] : w->now.temp_min[Yesterday];
-				*ppt = (!missing(w->hist.ppt[doy])) ? w->hist.ppt[doy] : 0.;
+				*tmax = (!missing(wh->temp_max[doy])) ? wh->temp_max[doy] : w->now.temp_max[Yesterday];
+				*tmin = (!missing(wh->temp_min[doy])) ? wh->temp_min[doy] : w->now.temp_min[Yesterday];
+				*ppt = (!missing(wh->ppt[doy])) ? wh->ppt[doy] : 0.;
 			}
 		}
 	}
@@ -159,46 +172,63 @@ static void _todays_weth(RealD *tmax, RealD *tmin, RealD *ppt) {
 void SW_WTH_construct(void) {
 	/* =================================================== */
 	OutPeriod pd;
+	SW_WEATHER_OUTPUTS *p_accu[SW_OUTNPERIODS], *p_oagg[SW_OUTNPERIODS];
+
+	// Keep output structures of a model that is reset (see `SW_WTH_deconstruct()`)
+	memcpy(p_accu, SW_Weather.p_accu, sizeof(p_accu));
+	memcpy(p_oagg, SW_Weather.p_oagg, sizeof(p_oagg));
 
 	// Clear the module structure:
 	memset(&SW_Weather, 0, sizeof(SW_Weather));
 
-	// Allocate output structures:
+	// Allocate output structures (or clear the kept ones):
 	ForEachOutPeriod(pd)
 	{
-		SW_Weather.p_accu[pd] = (SW_WEATHER_OUTPUTS *) Mem_Calloc(1,
-			sizeof(SW_WEATHER_OUTPUTS), "SW_WTH_construct()");
+		SW_Weather.p_accu[pd] = isnull(p_accu[pd]) ?
+			(SW_WEATHER_OUTPUTS *) Mem_Calloc(1, sizeof(SW_WEATHER_OUTPUTS),
+				"SW_WTH_construct()") :
+			(SW_WEATHER_OUTPUTS *) memset(p_accu[pd], 0, sizeof(SW_WEATHER_OUTPUTS));
 		if (pd > eSW_Day) {
-			SW_Weather.p_oagg[pd] = (SW_WEATHER_OUTPUTS *) Mem_Calloc(1,
-				sizeof(SW_WEATHER_OUTPUTS), "SW_WTH_construct()");
+			SW_Weather.p_oagg[pd] = isnull(p_oagg[pd]) ?
+				(SW_WEATHER_OUTPUTS *) Mem_Calloc(1, sizeof(SW_WEATHER_OUTPUTS),
+					"SW_WTH_construct()") :
+				(SW_WEATHER_OUTPUTS *) memset(p_oagg[pd], 0, sizeof(SW_WEATHER_OUTPUTS));
 		}
 	}
 }
 
 /**
 @brief Deconstructor for SW_Weather and SW_Markov (if used)
+@param full_reset If `swFALSE`, then output structures are kept for the
+  next `SW_WTH_construct()` of a model that is reset
+  (see `SW_CTL_clear_model()`).
 */
-void SW_WTH_deconstruct(void)
+void SW_WTH_deconstruct(Bool full_reset)
 {
 	OutPeriod pd;
 
-	// De-allocate output structures:
-	ForEachOutPeriod(pd)
-	{
-		if (pd > eSW_Day && !isnull(SW_Weather.p_oagg[pd])) {
-			Mem_Free(SW_Weather.p_oagg[pd]);
-			SW_Weather.p_oagg[pd] = NULL;
-		}
+	// De-allocate output structures (unless kept for a model that is reset):
+	if (full_reset) {
+		ForEachOutPeriod(pd)
+		{
+			if (pd > eSW_Day && !isnull(SW_Weather.p_oagg[pd])) {
+				Mem_Free(SW_Weather.p_oagg[pd]);
+				SW_Weather.p_oagg[pd] = NULL;
+			}
 
-		if (!isnull(SW_Weather.p_accu[pd])) {
-			Mem_Free(SW_Weather.p_accu[pd]);
-			SW_Weather.p_accu[pd] = NULL;
+			if (!isnull(SW_Weather.p_accu[pd])) {
+				Mem_Free(SW_Weather.p_accu[pd]);
+				SW_Weather.p_accu[pd] = NULL;
+			}
 		}
 	}
 
 	if (SW_Weather.use_weathergenerator) {
 		SW_MKV_deconstruct();
 	}
+
+	SW_WTH_store_close(&SW_Weather.store);
+	SW_Weather.p_hist = NULL;
 }
 
 /**
@@ -257,7 +287,13 @@ void SW_WTH_new_year(void) {
 		#ifdef RSOILWAT
 		weth_found = onSet_WTH_DATA_YEAR(SW_Model.year);
 		#else
-		weth_found = _read_weather_hist(SW_Model.year);
+		if (!isnull(SW_Weather.store)) {
+			SW_Weather.p_hist = SW_WTH_store_year(SW_Weather.store,
+				SW_Weather.store_site, SW_Model.year);
+			weth_found = (Bool) !isnull(SW_Weather.p_hist);
+		} else {
+			weth_found = _read_weather_hist(SW_Model.year);
+		}
 		#endif
 	}
 
@@ -269,6 +305,15 @@ void SW_WTH_new_year(void) {
 		  SW_Model.year
 		);
 	}
+
+	if (!weth_found) {
+		// generate all days of the year at once (into the year's history)
+		SW_Weather.p_hist = NULL;
+		SW_MKV_generate_year(SW_Model.firstdoy, SW_Model.lastdoy,
+			SW_Weather.now.ppt[Yesterday], SW_Weather.scale_precip,
+			SW_Weather.hist.temp_max, SW_Weather.hist.temp_min,
+			SW_Weather.hist.ppt);
+	}
 }
 
 /**
@@ -410,6 +455,52 @@ void SW_WTH_read(void) {
 	w->yr.last = SW_Model.endyr;
 	w->yr.total = w->yr.last - w->yr.first + 1;
 
+	SW_WTH_setup_daily();
+}
+
+
+/** @brief Set up the source of daily weather of a run
+
+  Opens the weather store of `SW_WEATHER.name_prefix` or, if
+  `PreloadWeather` is set, preloads the weather files of the simulated
+  years; otherwise, `SW_WTH_new_year()` reads the weather file of each year.
+  Called by `SW_WTH_read()` and after loading an input snapshot
+  (see `SW_SNAP_read()`).
+*/
+void SW_WTH_setup_daily(void) {
+	SW_WEATHER *w = &SW_Weather;
+	char store_fname[MAX_FILENAMESIZE], store_site[SW_WTH_STORE_NAMELEN];
+	TimeInt year;
+
+	// Daily weather from a weather store instead of from `weath.YYYY` files
+	SW_WTH_store_close(&w->store);
+	w->p_hist = NULL;
+	if (SW_WTH_store_name(w->name_prefix, store_fname, store_site)) {
+		w->store = SW_WTH_store_open(store_fname);
+		w->store_site = SW_WTH_store_site(w->store, store_site);
+
+		if (w->store_site < 0) {
+			LogError(logfp, LOGFATAL, "%s : site '%s' not found in weather store.",
+				store_fname, store_site);
+		}
+
+	} else if (PreloadWeather && !w->use_weathergenerator_only) {
+		// Read all weather files of the simulated years up front
+		year = max(w->yr.first, SW_Model.startyr);
+
+		if (year <= w->yr.last) {
+			w->store = SW_WTH_store_preload(w->name_prefix, year, w->yr.last);
+			w->store_site = 0;
+
+			for (; !w->use_weathergenerator && year <= w->yr.last; year++) {
+				if (isnull(SW_WTH_store_year(w->store, 0, year))) {
+					LogError(logfp, LOGFATAL, "Markov Simulator turned off and "
+						"weather file not found for year %d", year);
+				}
+			}
+		}
+	}
+
 	if (!w->use_weathergenerator && SW_Model.startyr < w->yr.first) {
     LogError(
       logfp,
@@ -419,7 +510,7 @@ void SW_WTH_read(void) {
         "Please synchronize the years or "
         "activate the weather generator "
         "(and set up input files `mkv_prob.in` and `mkv_covar.in`).",
-      MyFileName, SW_Model.startyr, w->yr.first
+      SW_F_name(eWeather), SW_Model.startyr, w->yr.first
     );
 	}
 	/* else we assume weather files match model run years */
@@ -440,6 +531,22 @@ void SW_WTH_read(void) {
       successfully/unsuccessfully read in.
 */
 Bool _read_weather_hist(TimeInt year) {
+	SW_Weather.p_hist = NULL;
+
+	return SW_WTH_read_hist_file(SW_Weather.name_prefix, year, &SW_Weather.hist);
+}
+
+
+/** @brief Read a historical (observed) weather file into `wh`
+
+    @param prefix The weather path and file prefix, see `_read_weather_hist()`.
+    @param year
+    @param wh Upon return, the daily weather of `year`; all values are
+      missing if the file does not exist.
+
+    @return `swTRUE`/`swFALSE` if the file for `year` exists/doesn't exist.
+*/
+Bool SW_WTH_read_hist_file(const char *prefix, TimeInt year, SW_WEATHER_HIST *wh) {
 	/* =================================================== */
 	/* Read the historical (measured) weather files.
 	 * Format is
@@ -455,7 +562,6 @@ Bool _read_weather_hist(TimeInt year) {
 	 *
 	 */
 
-	SW_WEATHER_HIST *wh = &SW_Weather.hist;
 	FILE *f;
 	int x, lineno = 0, doy;
 	// TimeInt mon, j, k = 0;
@@ -464,9 +570,9 @@ Bool _read_weather_hist(TimeInt year) {
 
 	char fname[MAX_FILENAMESIZE];
 
-	sprintf(fname, "%s.%4d", SW_Weather.name_prefix, year);
+	sprintf(fname, "%s.%4d", prefix, year);
 
-	_clear_hist_weather(); // clear values before returning
+	_clear_hist(wh); // clear values before returning
 
 	if (NULL == (f = fopen(fname, "r")))
 		return swFALSE;
@@ -16,6 +16,7 @@
  06/01/2012  (DLM) added temp_year_avg variable to SW_WEATHER_HIST struct & temp_month_avg[MAX_MONTHS] variable
  11/30/2012	(clk) added variable 'surfaceRunoff' to SW_WEATHER and SW_WEATHER_OUTPUTS
  changed 'runoff' to 'snowRunoff' to better distinguish between surface runoff and snowmelt runoff
+ 10/18/2026	added `p_hist`, `store`, and `store_site` to SW_WEATHER for binary weather stores
 
  */
 /********************************************************/
@@ -87,14 +88,22 @@ typedef struct {
 	SW_WEATHER_HIST hist;
 	SW_WEATHER_2DAYS now;
 
+	/* Historical weather of the current year if it is not held by `hist`,
+	   e.g., a slice of a weather store; `NULL` otherwise */
+	const SW_WEATHER_HIST *p_hist;
+	struct SW_WEATHER_STORE *store; // weather store or `NULL` (see `SW_Weather_store.c`)
+	int store_site; // index of site in `store`
+
 } SW_WEATHER;
 
 void SW_WTH_read(void);
+void SW_WTH_setup_daily(void);
 Bool _read_weather_hist(TimeInt year);
+Bool SW_WTH_read_hist_file(const char *prefix, TimeInt year, SW_WEATHER_HIST *wh);
 void _clear_hist_weather(void);
 void SW_WTH_init_run(void);
 void SW_WTH_construct(void);
-void SW_WTH_deconstruct(void);
+void SW_WTH_deconstruct(Bool full_reset);
 void SW_WTH_new_day(void);
 void SW_WTH_new_year(void);
 void SW_WTH_sum_today(void);
@@ -0,0 +1,769 @@
+/********************************************************/
+/********************************************************/
+/**
+  @file
+  @brief Binary, memory-mapped store of daily weather inputs
+
+  A weather store holds all years of daily maximum and minimum air
+  temperature and precipitation of one or many sites in one file. The file
+  is mapped into memory when a simulation run opens it, and
+  `SW_WTH_new_year()` points the run at the year's slice instead of reading
+  and parsing the text file `weath.YYYY` (see `_read_weather_hist()`).
+
+  A simulation run uses a store if the weather path of `files.in` names
+  a store file, i.e., `path/file.sw2w` for the first site of the store or
+  `path/file.sw2w:site` for a site by name (or by 0-based index).
+
+  Stores are written from the text layout of `data_weather` by
+  `SW_WTH_store_write()`, e.g., via `SOILWAT2 -w path/file.sw2w`.
+
+  If `PreloadWeather` is set (e.g., via `SOILWAT2 -p`), then a run without
+  a store file reads all of its weather files up front into one block
+  that is laid out like a store in memory (see `SW_WTH_store_preload()`).
+
+  Opened stores and preloaded blocks are shared among all runs of the
+  process that use the same store file or the same weather path and years,
+  e.g., runs of a batch that vary soils or vegetation at one weather
+  station. The most recently closed stores are kept for reuse by
+  subsequent runs (see `SW_WTH_STORE_MAXUNUSED`).
+
+  History:
+  10/18/2026	INITIAL CODING
+  10/18/2026	shared stores bypass the memory arena of a run
+  10/18/2026	preloaded weather is shared only after all years were read
+*/
+/********************************************************/
+/********************************************************/
+
+
+/* =================================================== */
+/*                INCLUDES / DEFINES                   */
+/* --------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+	#define SW_WTH_STORE_NOMMAP
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#ifdef SWTHREADS
+	#include <pthread.h>
+#endif
+
+#include "generic.h"
+#include "filefuncs.h"
+#include "myMemory.h"
+#include "SW_Defines.h"
+#include "SW_Weather.h"
+#include "SW_Weather_store.h"
+
+
+/* =================================================== */
+/*                  Global Variables                   */
+/* --------------------------------------------------- */
+
+/** If `swTRUE`, then runs preload all years of their weather files
+    (see `SW_WTH_store_preload()`); process-wide setting */
+Bool PreloadWeather = swFALSE;
+
+
+/* =================================================== */
+/*                Module-Level Variables               */
+/* --------------------------------------------------- */
+
+/* List of opened stores and preloaded blocks; shared among threads */
+static SW_WEATHER_STORE *_shared = NULL;
+
+/* Block that the calling thread is preloading; it is left behind if a fatal
+   error of a weather file (see `FatalJump`) interrupts the preloading */
+static SW_TLS SW_WEATHER_STORE *_preloading = NULL;
+
+#ifdef SWTHREADS
+static pthread_mutex_t _shared_lock = PTHREAD_MUTEX_INITIALIZER;
+	#define _lock_shared() pthread_mutex_lock(&_shared_lock)
+	#define _unlock_shared() pthread_mutex_unlock(&_shared_lock)
+#else
+	#define _lock_shared()
+	#define _unlock_shared()
+#endif
+
+
+/* =================================================== */
+/*                Module-Level Declarations            */
+/* --------------------------------------------------- */
+
+static uint64_t _align8(uint64_t x);
+static void _layout(SW_WEATHER_STORE_HEADER *h, unsigned int n_sites,
+	TimeInt first_year, TimeInt last_year);
+static void _set_pointers(SW_WEATHER_STORE *s);
+static Bool _load(SW_WEATHER_STORE *s);
+static void _free(SW_WEATHER_STORE **store);
+static void _unlink(SW_WEATHER_STORE *s);
+static void _push(SW_WEATHER_STORE *s);
+static SW_WEATHER_STORE *_lookup(const char *fname, Bool is_preloaded,
+	int32_t first_year, int32_t n_years);
+static SW_WEATHER_STORE *_find_shared(const char *fname, Bool is_preloaded,
+	TimeInt first_year, TimeInt last_year);
+static SW_WEATHER_STORE *_share(SW_WEATHER_STORE *s);
+static void _free_preloading(void);
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Private Function Definitions            */
+/* --------------------------------------------------- */
+
+static uint64_t _align8(uint64_t x) {
+	return (x + 7) & ~((uint64_t) 7);
+}
+
+
+/** @brief Set up the header of a store
+
+  @param h The header.
+  @param n_sites Number of sites.
+  @param first_year First calendar year.
+  @param last_year Last calendar year.
+*/
+static void _layout(SW_WEATHER_STORE_HEADER *h, unsigned int n_sites,
+	TimeInt first_year, TimeInt last_year) {
+
+	uint64_t n = (uint64_t) n_sites * (last_year - first_year + 1);
+
+	memset(h, 0, sizeof(SW_WEATHER_STORE_HEADER));
+	strcpy(h->magic, SW_WTH_STORE_MAGIC);
+	h->version = SW_WTH_STORE_VERSION;
+	h->byteorder = SW_WTH_STORE_BYTEORDER;
+	h->size_real = sizeof(RealD);
+	h->n_days = MAX_DAYS;
+	h->n_sites = n_sites;
+	h->first_year = (int32_t) first_year;
+	h->n_years = (int32_t) (last_year - first_year + 1);
+	h->offset_names = sizeof(SW_WEATHER_STORE_HEADER);
+	h->offset_flags = h->offset_names + (uint64_t) n_sites * SW_WTH_STORE_NAMELEN;
+	h->offset_data = _align8(h->offset_flags + n);
+}
+
+
+/** @brief Point names, year flags, and data of a store into its contents
+
+  @param s A store with `map` set.
+*/
+static void _set_pointers(SW_WEATHER_STORE *s) {
+	const SW_WEATHER_STORE_HEADER *h;
+
+	h = s->header = (const SW_WEATHER_STORE_HEADER *) s->map;
+	s->names = (const char *) s->map + h->offset_names;
+	s->has_year = (const unsigned char *) s->map + h->offset_flags;
+	s->data = (const SW_WEATHER_HIST *) ((const char *) s->map + h->offset_data);
+}
+
+
+/** @brief Map (or read) the contents of a weather store file into memory
+
+  @param s A store with `fname` set.
+
+  @return `swFALSE` if the file cannot be opened or read.
+*/
+static Bool _load(SW_WEATHER_STORE *s) {
+#ifdef SW_WTH_STORE_NOMMAP
+	FILE *f;
+	long n;
+
+	if (NULL == (f = fopen(s->fname, "rb"))) {
+		return swFALSE;
+	}
+
+	fseek(f, 0, SEEK_END);
+	n = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	s->size = (n > 0) ? (size_t) n : 0;
+	s->map = Mem_Malloc(s->size > 0 ? s->size : 1, "SW_WTH_store_open()");
+	s->is_mapped = swFALSE;
+
+	if (s->size != fread(s->map, 1, s->size, f)) {
+		fclose(f);
+		return swFALSE;
+	}
+
+	fclose(f);
+
+#else
+	int fd;
+	struct stat st;
+
+	if (-1 == (fd = open(s->fname, O_RDONLY))) {
+		return swFALSE;
+	}
+
+	if (0 != fstat(fd, &st) || st.st_size <= 0) {
+		close(fd);
+		return swFALSE;
+	}
+
+	s->size = (size_t) st.st_size;
+	s->map = mmap(NULL, s->size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); // the mapping stays valid
+
+	if (s->map == MAP_FAILED) {
+		s->map = NULL;
+		return swFALSE;
+	}
+	s->is_mapped = swTRUE;
+#endif
+
+	return swTRUE;
+}
+
+
+/** @brief Release the memory of a store
+
+  @param store The store; set to `NULL` upon return.
+*/
+static void _free(SW_WEATHER_STORE **store) {
+	SW_WEATHER_STORE *s = *store;
+
+	if (!isnull(s->map)) {
+		#ifndef SW_WTH_STORE_NOMMAP
+		if (s->is_mapped) {
+			munmap(s->map, s->size);
+		} else
+		#endif
+		{
+			Mem_Free(s->map);
+		}
+	}
+
+	Mem_Free(s->fname);
+	Mem_Free(s);
+	*store = NULL;
+}
+
+
+/** @brief Remove a store from the list of shared stores; the caller holds
+  the lock
+*/
+static void _unlink(SW_WEATHER_STORE *s) {
+	SW_WEATHER_STORE **p;
+
+	for (p = &_shared; !isnull(*p); p = &(*p)->next) {
+		if (*p == s) {
+			*p = s->next;
+			break;
+		}
+	}
+	s->next = NULL;
+}
+
+
+/** @brief Add a store to the front (most recently used) of the list of
+  shared stores; the caller holds the lock
+*/
+static void _push(SW_WEATHER_STORE *s) {
+	s->next = _shared;
+	_shared = s;
+}
+
+
+/** @brief Search the list of shared stores; the caller holds the lock
+
+  @param fname Name of the store file or, if `is_preloaded`, the weather
+    path and prefix.
+  @param is_preloaded Search for a preloaded block instead of a store file.
+  @param first_year First calendar year of a preloaded block.
+  @param n_years Number of years of a preloaded block.
+
+  @return The shared store or `NULL` if not found.
+*/
+static SW_WEATHER_STORE *_lookup(const char *fname, Bool is_preloaded,
+	int32_t first_year, int32_t n_years) {
+
+	SW_WEATHER_STORE *s;
+
+	for (s = _shared; !isnull(s); s = s->next) {
+		if (
+			s->is_preloaded == is_preloaded &&
+			0 == strcmp(s->fname, fname) &&
+			(!is_preloaded || (
+				s->header->first_year == first_year &&
+				s->header->n_years == n_years
+			))
+		) {
+			break;
+		}
+	}
+
+	return s;
+}
+
+
+/** @brief Look up a shared store and, if found, add a reference to it
+
+  @param fname Name of the store file or, if `is_preloaded`, the weather
+    path and prefix.
+  @param is_preloaded Look up a preloaded block instead of a store file.
+  @param first_year First calendar year of a preloaded block.
+  @param last_year Last calendar year of a preloaded block.
+
+  @return The shared store or `NULL` if not found.
+*/
+static SW_WEATHER_STORE *_find_shared(const char *fname, Bool is_preloaded,
+	TimeInt first_year, TimeInt last_year) {
+
+	SW_WEATHER_STORE *s;
+
+	_lock_shared();
+	s = _lookup(fname, is_preloaded, (int32_t) first_year,
+		(int32_t) (last_year - first_year + 1));
+	if (!isnull(s)) {
+		s->n_refs++;
+		_unlink(s);
+		_push(s);
+	}
+	_unlock_shared();
+
+	return s;
+}
+
+
+/** @brief Add a newly opened store to the list of shared stores
+
+  If another run shared an equivalent store in the meantime, then `s` is
+  released and the other store is used instead.
+
+  @param s A newly opened store.
+
+  @return The shared store with one additional reference.
+*/
+static SW_WEATHER_STORE *_share(SW_WEATHER_STORE *s) {
+	SW_WEATHER_STORE *other;
+
+	_lock_shared();
+	other = _lookup(s->fname, s->is_preloaded, s->header->first_year,
+		s->header->n_years);
+
+	if (isnull(other)) {
+		_push(s);
+		other = s;
+	}
+	other->n_refs++;
+	_unlock_shared();
+
+	if (other != s) {
+		_free(&s);
+	}
+
+	return other;
+}
+
+
+/** @brief Release a block whose preloading was interrupted by a fatal error
+*/
+static void _free_preloading(void) {
+	if (!isnull(_preloading)) {
+		_free(&_preloading);
+	}
+}
+
+
+/* =================================================== */
+/* =================================================== */
+/*             Function Definitions                    */
+/*             (declared in SW_Weather_store.h)        */
+/* --------------------------------------------------- */
+
+/** @brief Determine whether a weather path of `files.in` names a store
+
+  @param prefix The weather path, e.g., `SW_WEATHER.name_prefix`.
+  @param fname Upon return (if a store), the name of the store file;
+    of size `MAX_FILENAMESIZE`.
+  @param site Upon return (if a store), the requested site or an empty
+    string for the first site; of size `SW_WTH_STORE_NAMELEN`.
+
+  @return `swTRUE` if `prefix` is of the form `file.sw2w` or `file.sw2w:site`.
+*/
+Bool SW_WTH_store_name(const char *prefix, char *fname, char *site) {
+	const char *p = strstr(prefix, SW_WTH_STORE_EXT), *q;
+	size_t n;
+
+	if (isnull(p)) {
+		return swFALSE;
+	}
+
+	q = p + strlen(SW_WTH_STORE_EXT);
+	if (*q != '\0' && *q != ':') {
+		return swFALSE;
+	}
+
+	n = (size_t) (q - prefix);
+	if (n >= MAX_FILENAMESIZE || (*q == ':' && strlen(q + 1) >= SW_WTH_STORE_NAMELEN)) {
+		LogError(logfp, LOGFATAL, "Name of weather store is too long: %s", prefix);
+	}
+
+	memcpy(fname, prefix, n);
+	fname[n] = '\0';
+	strcpy(site, (*q == ':') ? q + 1 : "");
+
+	return swTRUE;
+}
+
+
+/** @brief Open a weather store
+
+  The file is memory-mapped (read into memory on platforms without `mmap`)
+  and its header is validated; failure is fatal. A store that is already
+  open (e.g., by another run of a batch) is shared instead.
+
+  @param fname Name of the weather store file.
+
+  @return The opened store; close with `SW_WTH_store_close()`.
+*/
+SW_WEATHER_STORE *SW_WTH_store_open(const char *fname) {
+	SW_WEATHER_STORE *s;
+	const SW_WEATHER_STORE_HEADER *h;
+	uint64_t n;
+	MemArena *arena;
+	Bool ok;
+
+	if (!isnull(s = _find_shared(fname, swFALSE, 0, 0))) {
+		return s;
+	}
+
+	// a shared store outlives the run: bypass the run's arena (if any)
+	arena = Mem_ArenaUse(NULL);
+	s = (SW_WEATHER_STORE *) Mem_Calloc(1, sizeof(SW_WEATHER_STORE),
+		"SW_WTH_store_open()");
+	s->fname = Str_Dup(fname);
+	ok = _load(s);
+	Mem_ArenaUse(arena);
+
+	if (!ok) {
+		_free(&s);
+		LogError(logfp, LOGFATAL, "Cannot read weather store %s", fname);
+	}
+
+	if (s->size < sizeof(SW_WEATHER_STORE_HEADER)) {
+		_free(&s);
+		LogError(logfp, LOGFATAL, "%s : not a weather store.", fname);
+	}
+
+	h = s->header = (const SW_WEATHER_STORE_HEADER *) s->map;
+
+	if (0 != memcmp(h->magic, SW_WTH_STORE_MAGIC, sizeof(h->magic))) {
+		_free(&s);
+		LogError(logfp, LOGFATAL, "%s : not a weather store.", fname);
+	}
+
+	if (h->version != SW_WTH_STORE_VERSION) {
+		n = h->version;
+		_free(&s);
+		LogError(logfp, LOGFATAL, "%s : version %d of weather store is not "
+			"supported (expected version %d).",
+			fname, (int) n, SW_WTH_STORE_VERSION);
+	}
+
+	if (
+		h->byteorder != SW_WTH_STORE_BYTEORDER ||
+		h->size_real != sizeof(RealD) ||
+		h->n_days != MAX_DAYS
+	) {
+		_free(&s);
+		LogError(logfp, LOGFATAL, "%s : weather store was written on an "
+			"incompatible platform; convert the weather again.", fname);
+	}
+
+	n = (uint64_t) h->n_sites * (uint64_t) (h->n_years > 0 ? h->n_years : 0);
+
+	if (
+		h->n_sites == 0 || h->n_years <= 0 ||
+		h->offset_names + (uint64_t) h->n_sites * SW_WTH_STORE_NAMELEN > s->size ||
+		h->offset_flags + n > s->size ||
+		h->offset_data % 8 != 0 ||
+		h->offset_data + n * sizeof(SW_WEATHER_HIST) > s->size
+	) {
+		_free(&s);
+		LogError(logfp, LOGFATAL, "%s : weather store is truncated or corrupt.",
+			fname);
+	}
+
+	_set_pointers(s);
+
+	return _share(s);
+}
+
+
+/** @brief Preload all years of weather files into a block in memory
+
+  The block is laid out like a store of one site so that runs access
+  a year's weather in the same way as with a store file. All weather files
+  are read (and validated) up front instead of one per simulation year.
+  A block with the same weather path and years that is already loaded
+  (e.g., by another run of a batch) is shared instead.
+
+  @param prefix The weather path and file prefix, i.e., files are named
+    `[prefix].[year]` (see `_read_weather_hist()`).
+  @param first_year First calendar year.
+  @param last_year Last calendar year.
+
+  @return The preloaded block; close with `SW_WTH_store_close()`.
+*/
+SW_WEATHER_STORE *SW_WTH_store_preload(const char *prefix,
+	TimeInt first_year, TimeInt last_year) {
+
+	SW_WEATHER_STORE *s;
+	SW_WEATHER_STORE_HEADER h;
+	SW_WEATHER_HIST *data;
+	unsigned char *has_year;
+	TimeInt year;
+	size_t k, size;
+	MemArena *arena;
+
+	_free_preloading();
+
+	if (!isnull(s = _find_shared(prefix, swTRUE, first_year, last_year))) {
+		return s;
+	}
+
+	_layout(&h, 1, first_year, last_year);
+	size = (size_t) (h.offset_data + h.n_years * sizeof(SW_WEATHER_HIST));
+
+	// a shared block outlives the run: bypass the run's arena (if any)
+	arena = Mem_ArenaUse(NULL);
+	s = (SW_WEATHER_STORE *) Mem_Calloc(1, sizeof(SW_WEATHER_STORE),
+		"SW_WTH_store_preload()");
+	s->fname = Str_Dup(prefix);
+	s->is_preloaded = swTRUE;
+	s->size = size;
+	s->map = Mem_Calloc(size, 1, "SW_WTH_store_preload()");
+	Mem_ArenaUse(arena);
+
+	memcpy(s->map, &h, sizeof(h));
+
+	has_year = (unsigned char *) s->map + h.offset_flags;
+	data = (SW_WEATHER_HIST *) ((char *) s->map + h.offset_data);
+
+	// the block is shared only after all years were read; a fatal error of a
+	// weather file (see `FatalJump`) leaves it to `_free_preloading()`
+	_preloading = s;
+	for (k = 0, year = first_year; year <= last_year; k++, year++) {
+		has_year[k] = (unsigned char) SW_WTH_read_hist_file(prefix, year, &data[k]);
+	}
+	_preloading = NULL;
+
+	_set_pointers(s);
+
+	return _share(s);
+}
+
+
+/** @brief Close a weather store
+
+  A store that is no longer used by any run is kept for reuse; the memory
+  of the least recently used store is released once more than
+  `SW_WTH_STORE_MAXUNUSED` stores are unused. A block whose preloading
+  was interrupted by a fatal error is released.
+
+  @param store The store; set to `NULL` upon return.
+*/
+void SW_WTH_store_close(SW_WEATHER_STORE **store) {
+	SW_WEATHER_STORE *s = *store, *p, *evict = NULL;
+	int n_unused = 0;
+
+	_free_preloading();
+
+	if (isnull(s)) {
+		return;
+	}
+
+	_lock_shared();
+	if (--s->n_refs <= 0) {
+		_unlink(s);
+		_push(s);
+
+		for (p = _shared; !isnull(p); p = p->next) {
+			if (p->n_refs <= 0 && ++n_unused > SW_WTH_STORE_MAXUNUSED) {
+				evict = p;
+			}
+		}
+
+		if (!isnull(evict)) {
+			_unlink(evict);
+		}
+	}
+	_unlock_shared();
+
+	if (!isnull(evict)) {
+		_free(&evict);
+	}
+	*store = NULL;
+}
+
+
+/** @brief Release the memory of all stores that are not used by any run
+*/
+void SW_WTH_store_free_unused(void) {
+	SW_WEATHER_STORE *s, *next, *unused = NULL;
+
+	_lock_shared();
+	for (s = _shared; !isnull(s); s = next) {
+		next = s->next;
+		if (s->n_refs <= 0) {
+			_unlink(s);
+			s->next = unused;
+			unused = s;
+		}
+	}
+	_unlock_shared();
+
+	for (s = unused; !isnull(s); s = next) {
+		next = s->next;
+		_free(&s);
+	}
+}
+
+
+/** @brief Locate a site in a weather store
+
+  @param store An opened store.
+  @param site Name of the site, its 0-based index, or an empty string
+    for the first site.
+
+  @return Index of the site or -1 if not found.
+*/
+int SW_WTH_store_site(const SW_WEATHER_STORE *store, const char *site) {
+	unsigned int i;
+	const char *p;
+
+	if (*site == '\0') {
+		return 0;
+	}
+
+	for (i = 0; i < store->header->n_sites; i++) {
+		if (0 == strncmp(store->names + i * SW_WTH_STORE_NAMELEN, site,
+				SW_WTH_STORE_NAMELEN)) {
+			return (int) i;
+		}
+	}
+
+	for (p = site; isdigit((unsigned char) *p); p++);
+	if (*p == '\0' && (unsigned int) atoi(site) < store->header->n_sites) {
+		return atoi(site);
+	}
+
+	return -1;
+}
+
+
+/** @brief Weather of one year of a site
+
+  @param store An opened store.
+  @param site Index of the site (see `SW_WTH_store_site()`).
+  @param year Calendar year.
+
+  @return A pointer into the store or `NULL` if the store has no weather
+    for that year.
+*/
+const SW_WEATHER_HIST *SW_WTH_store_year(const SW_WEATHER_STORE *store,
+	int site, TimeInt year) {
+
+	const SW_WEATHER_STORE_HEADER *h = store->header;
+	long k = (long) year - h->first_year;
+
+	if (site < 0 || (unsigned int) site >= h->n_sites || k < 0 || k >= h->n_years) {
+		return NULL;
+	}
+
+	k += (long) site * h->n_years;
+
+	return store->has_year[k] ? store->data + k : NULL;
+}
+
+
+/** @brief Convert daily weather text files of sites into a weather store
+
+  @param fname Name of the weather store file to (over)write.
+  @param n_sites Number of sites.
+  @param names Names of the sites (at most `SW_WTH_STORE_NAMELEN - 1`
+    characters are kept).
+  @param prefixes Weather path of each site, i.e., files are named
+    `[prefix].[year]` (see `_read_weather_hist()`).
+  @param first_year First calendar year of the store.
+  @param last_year Last calendar year of the store.
+*/
+void SW_WTH_store_write(const char *fname, unsigned int n_sites,
+	char **names, char **prefixes, TimeInt first_year, TimeInt last_year) {
+
+	FILE *f;
+	SW_WEATHER_STORE_HEADER h;
+	SW_WEATHER_HIST *wh;
+	unsigned char *has_year;
+	char name[SW_WTH_STORE_NAMELEN];
+	unsigned int i;
+	TimeInt year;
+	size_t k, n_years, pad;
+	const char zeros[8] = { 0 };
+
+	if (n_sites == 0 || last_year < first_year) {
+		LogError(logfp, LOGFATAL, "%s : no sites or years to store.", fname);
+	}
+
+	SW_WTH_store_free_unused(); // don't reuse a previous version of `fname`
+
+	n_years = last_year - first_year + 1;
+
+	_layout(&h, n_sites, first_year, last_year);
+	pad = (size_t) (h.offset_data - h.offset_flags - (uint64_t) n_sites * n_years);
+
+	if (NULL == (f = fopen(fname, "wb"))) {
+		LogError(logfp, LOGFATAL, "Cannot write weather store %s", fname);
+	}
+
+	fwrite(&h, sizeof(h), 1, f);
+
+	for (i = 0; i < n_sites; i++) {
+		memset(name, 0, SW_WTH_STORE_NAMELEN);
+		strncpy(name, names[i], SW_WTH_STORE_NAMELEN - 1);
+		fwrite(name, SW_WTH_STORE_NAMELEN, 1, f);
+	}
+
+	// Year flags are known after reading the text files: write them last
+	has_year = (unsigned char *) Mem_Calloc((size_t) n_sites * n_years, 1,
+		"SW_WTH_store_write()");
+	fwrite(has_year, 1, (size_t) n_sites * n_years, f);
+	fwrite(zeros, 1, pad, f);
+
+	// Read and write all years of one site at a time
+	wh = (SW_WEATHER_HIST *) Mem_Malloc(n_years * sizeof(SW_WEATHER_HIST),
+		"SW_WTH_store_write()");
+
+	for (i = 0; i < n_sites; i++) {
+		for (k = 0, year = first_year; year <= last_year; k++, year++) {
+			has_year[i * n_years + k] = (unsigned char)
+				SW_WTH_read_hist_file(prefixes[i], year, &wh[k]);
+		}
+
+		if (n_years != fwrite(wh, sizeof(SW_WEATHER_HIST), n_years, f)) {
+			fclose(f);
+			LogError(logfp, LOGFATAL, "Failed to write weather store %s", fname);
+		}
+	}
+
+	fseek(f, (long) h.offset_flags, SEEK_SET);
+	fwrite(has_year, 1, (size_t) n_sites * n_years, f);
+
+	Mem_Free(has_year);
+	Mem_Free(wh);
+
+	if (0 != fclose(f)) {
+		LogError(logfp, LOGFATAL, "Failed to write weather store %s", fname);
+	}
+}
@@ -0,0 +1,99 @@
+/********************************************************/
+/********************************************************/
+/*  Source file: SW_Weather_store.h
+  Type: header
+  Application: SOILWAT - soilwater dynamics simulator
+  Purpose: Support for SW_Weather_store.c: binary, memory-mapped
+    multi-year and multi-site daily weather inputs, and preloaded
+    weather blocks that are shared among simulation runs
+
+  History:
+  10/18/2026	INITIAL CODING
+ */
+/********************************************************/
+/********************************************************/
+
+#ifndef SW_WEATHER_STORE_H
+#define SW_WEATHER_STORE_H
+
+#include <stdint.h>
+#include "generic.h"
+#include "Times.h"
+#include "SW_Weather.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define SW_WTH_STORE_EXT ".sw2w" /**< File extension of a weather store */
+#define SW_WTH_STORE_MAGIC "SW2WTHB" /**< Identifies a weather store file */
+#define SW_WTH_STORE_VERSION 1 /**< Version of the file format */
+#define SW_WTH_STORE_BYTEORDER 0x01020304 /**< Detects foreign byte order */
+#define SW_WTH_STORE_NAMELEN 128 /**< Length of a site name (incl. `\0`) */
+#define SW_WTH_STORE_MAXUNUSED 4 /**< Closed stores that are kept for reuse */
+
+
+/** Header of a weather store file
+
+  The file layout is
+    - header
+    - site names: `n_sites` x `SW_WTH_STORE_NAMELEN` characters
+    - year flags: `n_sites` x `n_years` bytes, 1 if weather of a year
+      is available
+    - weather data: `n_sites` x `n_years` records of `SW_WEATHER_HIST`
+      (native byte order and `RealD`) starting at an 8-byte aligned offset
+*/
+typedef struct {
+	char magic[8];
+	uint32_t
+		version,
+		byteorder,
+		size_real, /**< `sizeof(RealD)` of the writing platform */
+		n_days, /**< `MAX_DAYS` of the writing platform */
+		n_sites;
+	int32_t first_year, n_years;
+	uint32_t reserved[2];
+	uint64_t offset_names, offset_flags, offset_data;
+} SW_WEATHER_STORE_HEADER;
+
+/** An opened (memory-mapped) weather store or a preloaded weather block
+
+  Stores are read-only once opened and are shared by all simulation runs
+  (and threads) that open the same file or preload the same weather files
+  and years; the last `SW_WTH_store_close()` releases the memory.
+*/
+typedef struct SW_WEATHER_STORE {
+	char *fname; /**< Store file or, if preloaded, weather path and prefix */
+	void *map; /**< File contents (mapped or read into memory) */
+	size_t size; /**< Size of the file contents in bytes */
+	Bool is_mapped, is_preloaded;
+
+	int n_refs; /**< Number of runs that share this store */
+	struct SW_WEATHER_STORE *next; /**< Next store of the list of shared stores */
+
+	const SW_WEATHER_STORE_HEADER *header;
+	const char *names;
+	const unsigned char *has_year;
+	const SW_WEATHER_HIST *data;
+} SW_WEATHER_STORE;
+
+
+Bool SW_WTH_store_name(const char *prefix, char *fname, char *site);
+SW_WEATHER_STORE *SW_WTH_store_open(const char *fname);
+SW_WEATHER_STORE *SW_WTH_store_preload(const char *prefix,
+	TimeInt first_year, TimeInt last_year);
+void SW_WTH_store_close(SW_WEATHER_STORE **store);
+void SW_WTH_store_free_unused(void);
+int SW_WTH_store_site(const SW_WEATHER_STORE *store, const char *site);
+const SW_WEATHER_HIST *SW_WTH_store_year(const SW_WEATHER_STORE *store,
+	int site, TimeInt year);
+void SW_WTH_store_write(const char *fname, unsigned int n_sites,
+	char **names, char **prefixes, TimeInt first_year, TimeInt last_year);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -41,7 +41,7 @@ static TimeInt
     a call to Time_new_year() */
   monthdays[12] = { 31, NoDay, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
-static TimeInt
+static SW_TLS TimeInt
   days_in_month[MAX_MONTHS], /* number of days per month for "current" year */
   cum_monthdays[MAX_MONTHS]; /* monthly cumulative number of days for "current" year */
 
@@ -25,10 +25,14 @@
 /* Note that errstr[] is externed in generic.h via filefuncs.h */
 /* 01/05/2011	(drs) removed unused variable *p from MkDir()
  06/21/2013	(DLM)	memory leak in function getfiles(): variables dname and fname need to be free'd
+ 10/18/2026	fatal errors jump to FatalJump (if set) instead of exiting
  */
 
 char **getfiles(const char *fspec, int *nfound);
 
+SW_TLS jmp_buf *FatalJump = NULL; /* see filefuncs.h */
+SW_TLS char FatalMsg[MAX_ERROR];
+
 
 /**
  * @brief Prints an error message and throws an error or warning. Works both for rSOILWAT2
@@ -36,7 +40,8 @@ char **getfiles(const char *fspec, int *nfound);
  *
  * @param code The error/warning code. If `code` is not 0, then it is passed to `exit`
  *  (SOILWAT2) / `error` (rSOILWAT2). If `code` is 0, then it is passed to
- *  `warning` (rSOILWAT2), respectively.
+ *  `warning` (rSOILWAT2), respectively. If `code` is not 0 and `FatalJump`
+ *  is set, then SOILWAT2 jumps to `FatalJump` instead of exiting.
  * @param format The character string with formatting (as for `printf`).
  * @param ... Variables to be printed.
  */
@@ -61,6 +66,13 @@ void sw_error(int code, const char *format, ...)
     #ifdef RSOILWAT
       error("exit %d\n", code);
     #else
+      if (!isnull(FatalJump)) {
+        va_start(ap, format);
+        vsnprintf(FatalMsg, MAX_ERROR, format, ap);
+        va_end(ap);
+        Str_TrimRight(FatalMsg);
+        longjmp(*FatalJump, code);
+      }
       exit(code);
     #endif
   }
@@ -74,11 +86,20 @@ void LogError(FILE *fp, const int mode, const char *fmt, ...) {
 	 *  9-Dec-03 (cwb) Modified to accept argument list similar
 	 *           to fprintf() so sprintf(errstr...) doesn't need
 	 *           to be called each time replacement args occur.
+	 * 18-Oct-26 With LOGEXIT, keep the message in FatalMsg and
+	 *           jump to FatalJump (if set) instead of exiting.
 	 */
 
 	char outfmt[ERRSTRLEN] = {0}; /* to prepend err type str */
 	va_list args;
 
+	if (LOGEXIT & mode) {
+		va_start(args, fmt);
+		vsnprintf(FatalMsg, MAX_ERROR, fmt, args);
+		va_end(args);
+		Str_TrimRight(FatalMsg);
+	}
+
 	va_start(args, fmt);
 
 	if (LOGQUIET & mode)
@@ -112,6 +133,9 @@ void LogError(FILE *fp, const int mode, const char *fmt, ...) {
 	va_end(args);
 
 	if (LOGEXIT & mode) {
+		if (!isnull(FatalJump)) {
+			longjmp(*FatalJump, -1);
+		}
 		sw_error(-1, "@ generic.c LogError");
 	}
 }
@@ -144,7 +168,7 @@ char *DirName(const char *p) {
 	 * Be sure to copy the return value to a more stable buffer
 	 * before moving on.
 	 */
-	static char s[FILENAME_MAX];
+	static SW_TLS char s[FILENAME_MAX];
 	char *c;
 	int l;
 	char sep1 = '/', sep2 = '\\';
@@ -275,7 +299,8 @@ Bool MkDir(const char *dname) {
 	int r, i, n;
 	Bool result = swTRUE;
 	char *a[256] = { 0 }, /* points to each path element for mkdir -p behavior */
-		*c; /* duplicate of dname so we don't change it */
+		*c, /* duplicate of dname so we don't change it */
+		*p;
 	const char *delim = "\\/"; /* path separators */
 
 	if (isnull(dname))
@@ -285,12 +310,25 @@ Bool MkDir(const char *dname) {
 		sw_error(-1, "Out of memory making string in MkDir()");
 	}
 
+	/* parse path; not with strtok() which is not reentrant */
 	n = 0;
-	a[n++] = strtok(c, delim);
-	while (NULL != (a[n++] = strtok(NULL, delim)))
-		; /* parse path */
-	n--;
+	p = c;
+	while (*p != '\0' && n < 256) {
+		p += strspn(p, delim);
+		if (*p != '\0') {
+			a[n++] = p;
+			p += strcspn(p, delim);
+			if (*p != '\0') {
+				*(p++) = '\0';
+			}
+		}
+	}
+
+	/* keep leading separator of an absolute path */
 	errstr[0] = '\0';
+	if (*dname != '\0' && strchr(delim, *dname)) {
+		strcat(errstr, "/");
+	}
 	for (i = 0; i < n; i++) {
 		strcat(errstr, a[i]);
 		if (!DirExists(errstr)) {
@@ -408,8 +446,8 @@ char **getfiles(const char *fspec, int *nfound) {
 	}
 
 	closedir(dir);
-	free(dname);
-	free(fname);
+	Mem_Free(dname);
+	Mem_Free(fname);
 
 	return flist;
 }
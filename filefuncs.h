@@ -9,6 +9,7 @@
 #ifndef FILEFUNCS_H
 #define FILEFUNCS_H
 
+#include <setjmp.h>
 #include "generic.h"
 
 #ifdef __cplusplus
@@ -35,7 +36,16 @@ Bool RemoveFiles(const char *fspec);
 void sw_error(int errorcode, const char *format, ...);
 void LogError(FILE *fp, const int mode, const char *fmt, ...);
 
-extern char inbuf[]; /* declare in main, use anywhere */
+extern SW_TLS char inbuf[]; /* declare in main, use anywhere */
+
+/* If not NULL, then a fatal error of the calling thread (sw_error() with
+ * a non-zero code, e.g., LogError() with LOGFATAL) jumps with longjmp() to
+ * this target instead of terminating the process; the message of the error
+ * is in FatalMsg. The driver that sets the target with setjmp() cleans up
+ * after the failed simulation (see SW_Batch.c).
+ */
+extern SW_TLS jmp_buf *FatalJump;
+extern SW_TLS char FatalMsg[];
 
 
 #ifdef __cplusplus
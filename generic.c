@@ -3,7 +3,9 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <math.h>
+#include <float.h>
 
 /* int logged is to be declared in the main module of your program. */
 /* global variable indicates logfile used: externed via generic.h */
@@ -17,6 +19,7 @@
  05/25/2012  (DLM) added interpolation() function
  05/29/2012  (DLM) added lobf(), lobfM(), & lobfB() function
  05/31/2012  (DLM) added st_getBounds() function for use in the soil_temperature function in SW_Flow_lib.c
+ 10/18/2026  added Str_FromDouble() for fast formatting of output values
  */
 
 #include "generic.h"
@@ -178,6 +181,67 @@ void UnComment(char *s) {
 	Str_TrimRight(s);
 }
 
+/*****************************************************/
+char *Str_FromDouble(char *s, double x, int digits) {
+	/*-------------------------------------------
+	 Write x with `digits` decimal digits into s;
+	 the result is identical to sprintf(s, "%.*f", digits, x).
+	 Return a pointer to the terminating null character of s.
+
+	 Values are scaled and rounded to an integer; if the
+	 scaled value is too large or too close to half-way
+	 between two integers to be rounded exactly, then
+	 sprintf() is used instead.
+	 -------------------------------------------*/
+	static const double p10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+		1e9 };
+	double ax, y, r;
+	uint64_t n, ip, fp;
+	char tmp[24], *q;
+	int i;
+
+	ax = fabs(x);
+
+	if (digits < 0 || digits > 9 || !(ax < 1e9)) {
+		return s + sprintf(s, "%.*f", digits, x);
+	}
+
+	y = ax * p10[digits];
+	r = floor(y);
+	if (fabs(y - r - 0.5) <= 4. * DBL_EPSILON * y) {
+		return s + sprintf(s, "%.*f", digits, x);
+	}
+
+	n = (uint64_t) r + (y - r > 0.5);
+	ip = n / (uint64_t) p10[digits];
+	fp = n % (uint64_t) p10[digits];
+
+	if (signbit(x)) {
+		*s++ = '-';
+	}
+
+	q = tmp;
+	do {
+		*q++ = (char) ('0' + ip % 10);
+		ip /= 10;
+	} while (ip > 0);
+	while (q > tmp) {
+		*s++ = *--q;
+	}
+
+	if (digits > 0) {
+		*s++ = '.';
+		for (i = digits - 1; i >= 0; i--) {
+			s[i] = (char) ('0' + fp % 10);
+			fp /= 10;
+		}
+		s += digits;
+	}
+
+	*s = '\0';
+	return s;
+}
+
 
 
 /**************************************************************************************************************************************
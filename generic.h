@@ -94,6 +94,22 @@ extern "C" {
 
 #define isnull(a) (NULL == (a))
 
+/* ------ Thread-local state ------ */
+/* Module-level variables that hold the state of a simulation are declared
+ * with SW_TLS. If compiled with SWTHREADS, then each thread carries its own
+ * copy and independent simulations can run concurrently (see SW_RUN);
+ * otherwise, SW_TLS expands to nothing.
+ */
+#ifdef SWTHREADS
+  #ifdef __cplusplus
+    #define SW_TLS thread_local
+  #else
+    #define SW_TLS _Thread_local
+  #endif
+#else
+  #define SW_TLS
+#endif
+
 /* ---------   Redefine basic types to be more malleable ---- */
 typedef float RealF;
 typedef double RealD;
@@ -140,20 +156,20 @@ typedef unsigned char byte;
 #define LOGFATAL 0x0c  /* LOGEXIT | LOGERROR */
 #define MAX_ERROR 4096
 
-extern FILE *logfp; /* REQUIRED */
+extern SW_TLS FILE *logfp; /* REQUIRED */
 /* This is the pointer to the log file.  It is declared in the
  * main module and externed here to make it available to any
  * file that needs it so all modules write to the same logfile.
  * See also the comments on 'logged' below.
  */
 
-extern char errstr[]; /* REQUIRED */
+extern SW_TLS char errstr[]; /* REQUIRED */
 /* declared in the main module, this is an ever-ready
  * buffer to put error text into for printing or
  * writing to the log file.
  */
 
-extern int logged; /* REQUIRED */
+extern SW_TLS int logged; /* REQUIRED */
 /* use as a boolean: see gen_funcs.c.
  * Global variable indicates logfile written to via LogError.
  * In the main module, create a subroutine (eg, log_notify)
@@ -222,6 +238,7 @@ char *Str_TrimLeftQ(char *s); /* "quick" version */
 char *Str_ToUpper(char *s, char *r);
 char *Str_ToLower(char *s, char *r);
 int Str_CompareI(char *t, char *s);
+char *Str_FromDouble(char *s, double x, int digits);
 void UnComment(char *s);
 double interpolation(double x1, double x2, double y1, double y2, double deltaX);
 void st_getBounds(unsigned int *x1, unsigned int *x2, unsigned int *equal, unsigned int size, double depth, double bounds[]);
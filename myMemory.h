@@ -18,6 +18,19 @@ extern "C" {
 #endif
 
 
+/* A region of memory that serves all Mem_Malloc(), Mem_Calloc(), and
+ * Mem_ReAlloc() requests of a thread while it is in use (see
+ * Mem_ArenaUse()); Mem_Free() of its blocks is a no-op and
+ * Mem_ArenaReset() releases all blocks at once. */
+typedef struct MemArenaChunk MemArenaChunk;
+
+typedef struct {
+	MemArenaChunk *first, /* list of chunks, kept across resets */
+		*cur; /* chunk that serves the next request */
+	size_t chunk_size; /* default size of a new chunk */
+} MemArena;
+
+
 char *Str_Dup(const char *s); /* return pointer to malloc'ed dup of s */
 void *Mem_Malloc(size_t size, const char *funcname);
 void *Mem_Calloc(size_t nobjs, size_t size, const char *funcname);
@@ -26,6 +39,11 @@ void Mem_Free(void *block);
 void Mem_Set(void *block, byte c, size_t n);
 void Mem_Copy(void *dest, const void *src, size_t n);
 
+void Mem_ArenaInit(MemArena *arena, size_t chunk_size);
+MemArena *Mem_ArenaUse(MemArena *arena);
+void Mem_ArenaReset(MemArena *arena);
+void Mem_ArenaRelease(MemArena *arena);
+
 
 #ifdef __cplusplus
 }
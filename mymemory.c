@@ -48,6 +48,180 @@ void mem_DelNode( void *handle);
 
 /* Note that errstr[] is externed via generic.h */
 
+/* ---------------------------------------------------------------
+ * Arenas: a chunk holds blocks back to back; each block is preceded
+ * by a header with its size (for Mem_ReAlloc()). Chunks are kept
+ * when an arena is reset and are reused in order. The address ranges
+ * of the chunks of all arenas of a thread are kept sorted so that the
+ * arena that owns a block is found by a binary search.
+ * --------------------------------------------------------------- */
+#define MEM_ARENA_ALIGN 16 /* alignment of blocks, size of block headers */
+#define MEM_ARENA_CHUNK 262144 /* default size of a chunk */
+
+struct MemArenaChunk {
+	struct MemArenaChunk *next;
+	size_t size, /* bytes available for blocks */
+		pos; /* bytes in use */
+	byte *data;
+};
+
+typedef struct {
+	const byte *lo, *hi; /* data of a chunk */
+	MemArena *arena; /* owner of the chunk */
+} MemArenaRange;
+
+/* arena that serves the requests of this thread; NULL = system heap */
+static SW_TLS MemArena *_arena = NULL;
+
+/* chunks of all arenas of this thread, sorted by address */
+static SW_TLS MemArenaRange *_ranges = NULL;
+static SW_TLS size_t _n_ranges = 0, _n_ranges_alloc = 0;
+
+static size_t _arena_align(size_t n) {
+	return (n + MEM_ARENA_ALIGN - 1) & ~((size_t) MEM_ARENA_ALIGN - 1);
+}
+
+/* Number of chunks that start at or before p */
+static size_t _ranges_upto(const byte *p) {
+	size_t lo = 0, hi = _n_ranges, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (_ranges[mid].lo <= p)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/* Arena that owns block p; NULL if p is from the system heap */
+static MemArena *_arena_owner(const void *p) {
+	const byte *b = (const byte *) p;
+	size_t i;
+
+	if (_n_ranges == 0)
+		return NULL;
+
+	i = _ranges_upto(b);
+
+	return (i > 0 && b < _ranges[i - 1].hi) ? _ranges[i - 1].arena : NULL;
+}
+
+static void _ranges_add(MemArena *a, const MemArenaChunk *c) {
+	size_t i;
+
+	if (_n_ranges == _n_ranges_alloc) {
+		_n_ranges_alloc = (_n_ranges_alloc == 0) ? 16 : 2 * _n_ranges_alloc;
+		_ranges = (MemArenaRange *) realloc(_ranges,
+				_n_ranges_alloc * sizeof(MemArenaRange));
+		if (_ranges == NULL)
+			LogError(logfp, LOGFATAL, "Out of memory in _ranges_add()");
+	}
+
+	i = _ranges_upto(c->data);
+	memmove(_ranges + i + 1, _ranges + i, (_n_ranges - i) * sizeof(MemArenaRange));
+	_ranges[i].lo = c->data;
+	_ranges[i].hi = c->data + c->size;
+	_ranges[i].arena = a;
+	_n_ranges++;
+}
+
+static void _ranges_remove(const MemArena *a) {
+	size_t i, n = 0;
+
+	for (i = 0; i < _n_ranges; i++) {
+		if (_ranges[i].arena != a)
+			_ranges[n++] = _ranges[i];
+	}
+	_n_ranges = n;
+
+	if (_n_ranges == 0) {
+		free(_ranges);
+		_ranges = NULL;
+		_n_ranges_alloc = 0;
+	}
+}
+
+static void *_arena_alloc(MemArena *a, size_t size, const char *funcname) {
+	/*-------------------------------------------
+	 Carve a block from the current chunk. If it is
+	 full, continue with the next chunk (kept from
+	 before a reset) or insert a new chunk that is
+	 large enough for the request.
+	 -------------------------------------------*/
+	MemArenaChunk *c = a->cur;
+	size_t need = MEM_ARENA_ALIGN + _arena_align(size), n;
+	byte *p;
+
+	if (c == NULL || c->pos + need > c->size) {
+		if (c != NULL && c->next != NULL && c->next->size >= need) {
+			c = c->next;
+
+		} else {
+			n = (need > a->chunk_size) ? need : a->chunk_size;
+			c = (MemArenaChunk *) malloc(
+					_arena_align(sizeof(MemArenaChunk)) + n);
+			if (c == NULL)
+				LogError(logfp, LOGFATAL, "Out of memory in %s()", funcname);
+
+			c->data = (byte *) c + _arena_align(sizeof(MemArenaChunk));
+			c->size = n;
+
+			if (a->cur == NULL) {
+				c->next = a->first;
+				a->first = c;
+			} else {
+				c->next = a->cur->next;
+				a->cur->next = c;
+			}
+
+			_ranges_add(a, c);
+		}
+
+		c->pos = 0;
+		a->cur = c;
+	}
+
+	p = c->data + c->pos;
+	*(size_t *) p = size;
+	c->pos += need;
+
+	return p + MEM_ARENA_ALIGN;
+}
+
+/* Is block p the most recent block of the current chunk of arena a? */
+static Bool _arena_is_last(const MemArena *a, const byte *p) {
+	const MemArenaChunk *c = a->cur;
+
+	return (Bool) (c != NULL && p > c->data && p < c->data + c->pos &&
+			p + _arena_align(*(const size_t *) (p - MEM_ARENA_ALIGN)) ==
+					c->data + c->pos);
+}
+
+static void *_arena_realloc(MemArena *a, byte *p, size_t sizeNew) {
+	/*-------------------------------------------
+	 Grow or shrink the most recent block in place,
+	 otherwise move the block to a new one.
+	 -------------------------------------------*/
+	MemArenaChunk *c = a->cur;
+	size_t sizeOld = *(size_t *) (p - MEM_ARENA_ALIGN);
+	byte *pNew;
+
+	if (_arena_is_last(a, p)
+			&& (size_t) (p - c->data) + _arena_align(sizeNew) <= c->size) {
+		c->pos = (size_t) (p - c->data) + _arena_align(sizeNew);
+		*(size_t *) (p - MEM_ARENA_ALIGN) = sizeNew;
+		return p;
+	}
+
+	pNew = (byte *) _arena_alloc(a, sizeNew, "Mem_ReAlloc");
+	memcpy(pNew, p, (sizeOld < sizeNew) ? sizeOld : sizeNew);
+
+	return pNew;
+}
+
 /*****************************************************/
 char *Str_Dup(const char *s) {
 	/*-------------------------------------------
@@ -101,6 +275,9 @@ void *Mem_Malloc(size_t size, const char *funcname) {
 	}
 #endif
 
+	if (_arena != NULL)
+		return _arena_alloc(_arena, size, funcname);
+
 	p = malloc(size);
 
 #ifdef DEBUG_MEM_LOG
@@ -180,6 +357,7 @@ void *Mem_ReAlloc(void *block, size_t sizeNew) {
 	 -------------------------------------------*/
 	byte *p = (byte *) block, /* a copy so as not to damage original ? */
 	*pNew;
+	MemArena *a;
 #ifdef DEBUG_MEM
 	size_t sizeOld;
 #endif
@@ -191,6 +369,9 @@ void *Mem_ReAlloc(void *block, size_t sizeNew) {
 		sw_error(-1, "assert failed in ReAlloc");
 #endif
 
+	if ((a = _arena_owner(p)) != NULL)
+		return _arena_realloc(a, p, sizeNew);
+
 #ifdef DEBUG_MEM
 	{
 		sizeOld = sizeofBlock(p);
@@ -241,8 +422,19 @@ void Mem_Free(void *block) {
 
 	 cwb - 5/19/2001
 	 7/23/01  - added Macguire's code.
+	 10/18/2026 - blocks of an arena are released by
+	 Mem_ArenaReset() (the most recent block right away)
 	 -------------------------------------------*/
 
+	MemArena *a = _arena_owner(block);
+
+	if (a != NULL) {
+		if (_arena_is_last(a, (byte *) block))
+			a->cur->pos = (size_t) ((byte *) block - a->cur->data)
+					- MEM_ARENA_ALIGN;
+		return;
+	}
+
 #ifdef DEBUG_MEM_X
 	{
 		if (mem_SizeOf(block) > SizeOfMalloc)
@@ -308,6 +500,92 @@ void Mem_Copy(void *dest, const void *src, size_t n) {
 
 }
 
+/*****************************************************/
+void Mem_ArenaInit(MemArena *arena, size_t chunk_size) {
+	/*-------------------------------------------
+	 Set up an empty arena; chunks are allocated as
+	 needed with chunk_size bytes (0 = default) or
+	 the size of a larger request.
+
+	 10/18/2026
+	 -------------------------------------------*/
+
+	arena->first = NULL;
+	arena->cur = NULL;
+	arena->chunk_size = (chunk_size > 0) ? chunk_size : MEM_ARENA_CHUNK;
+}
+
+/*****************************************************/
+MemArena *Mem_ArenaUse(MemArena *arena) {
+	/*-------------------------------------------
+	 Serve all following Mem_Malloc(), Mem_Calloc(),
+	 and Mem_ReAlloc() requests of the calling thread
+	 from arena; NULL returns to the system heap.
+	 Returns the arena that was in use before, e.g.,
+	 to bypass the arena for memory that outlives it:
+
+	 prev = Mem_ArenaUse(NULL);
+	 ...
+	 Mem_ArenaUse(prev);
+
+	 Blocks of an arena may be freed (or reallocated)
+	 while another arena or the system heap is in use,
+	 but only by the thread that uses the arena. With
+	 DEBUG_MEM, arenas are not used so that all blocks
+	 are tracked.
+
+	 10/18/2026
+	 -------------------------------------------*/
+
+	MemArena *prev = _arena;
+
+#ifndef DEBUG_MEM
+	_arena = arena;
+#else
+	(void) arena;
+#endif
+
+	return prev;
+}
+
+/*****************************************************/
+void Mem_ArenaReset(MemArena *arena) {
+	/*-------------------------------------------
+	 Release all blocks of arena at once (in constant
+	 time); its chunks are kept for reuse.
+
+	 10/18/2026
+	 -------------------------------------------*/
+
+	arena->cur = arena->first;
+	if (arena->cur != NULL)
+		arena->cur->pos = 0;
+}
+
+/*****************************************************/
+void Mem_ArenaRelease(MemArena *arena) {
+	/*-------------------------------------------
+	 Return the chunks of arena to the system heap.
+
+	 10/18/2026
+	 -------------------------------------------*/
+
+	MemArenaChunk *c, *next;
+
+	if (_arena == arena)
+		_arena = NULL;
+
+	_ranges_remove(arena);
+
+	for (c = arena->first; c != NULL; c = next) {
+		next = c->next;
+		free(c);
+	}
+
+	arena->first = NULL;
+	arena->cur = NULL;
+}
+
 /* ===============  end of block from gen_funcs.c ----------------- */
 /* ================ see also the end of this file ------------------ */
 
@@ -13,7 +13,136 @@
 
 
 #ifndef RSOILWAT
-  uint64_t stream = 1u; //stream id. this is given out to a pcg_rng then incremented.
+  SW_TLS uint64_t stream = 1u; //stream id. this is given out to a pcg_rng then incremented.
+
+  #ifdef SW_ZIGGURAT
+  /* Tables of the ziggurat of the standard normal distribution with 128
+     layers (Marsaglia & Tsang 2000, J Stat Softw 5(8)), i.e., for the
+     rightmost layer at r = 3.442619855899 and layer area
+     v = 9.91256303526217e-3:
+       - zig_kn: layer widths relative to the next layer, scaled by 2^31
+       - zig_wn: x-coordinates of the layers, scaled by 2^-31
+       - zig_fn: densities at the x-coordinates of the layers
+  */
+  #define ZIG_R 3.442619855899
+
+  static const uint32_t zig_kn[128] = {
+  	1991057938u, 0u, 1611602771u, 1826899878u, 1918584482u, 1969227037u,
+  	2001281515u, 2023368125u, 2039498179u, 2051788381u, 2061460127u, 2069267110u,
+  	2075699398u, 2081089314u, 2085670119u, 2089610331u, 2093034710u, 2096037586u,
+  	2098691595u, 2101053571u, 2103168620u, 2105072996u, 2106796166u, 2108362327u,
+  	2109791536u, 2111100552u, 2112303493u, 2113412330u, 2114437283u, 2115387130u,
+  	2116269447u, 2117090813u, 2117856962u, 2118572919u, 2119243101u, 2119871411u,
+  	2120461303u, 2121015852u, 2121537798u, 2122029592u, 2122493434u, 2122931299u,
+  	2123344971u, 2123736059u, 2124106020u, 2124456175u, 2124787725u, 2125101763u,
+  	2125399283u, 2125681194u, 2125948325u, 2126201433u, 2126441213u, 2126668298u,
+  	2126883268u, 2127086657u, 2127278949u, 2127460589u, 2127631985u, 2127793506u,
+  	2127945490u, 2128088244u, 2128222044u, 2128347141u, 2128463758u, 2128572095u,
+  	2128672327u, 2128764606u, 2128849065u, 2128925811u, 2128994934u, 2129056501u,
+  	2129110560u, 2129157136u, 2129196237u, 2129227847u, 2129251929u, 2129268426u,
+  	2129277255u, 2129278312u, 2129271467u, 2129256561u, 2129233410u, 2129201800u,
+  	2129161480u, 2129112170u, 2129053545u, 2128985244u, 2128906855u, 2128817916u,
+  	2128717911u, 2128606255u, 2128482298u, 2128345305u, 2128194452u, 2128028813u,
+  	2127847342u, 2127648860u, 2127432031u, 2127195339u, 2126937058u, 2126655214u,
+  	2126347546u, 2126011445u, 2125643893u, 2125241376u, 2124799783u, 2124314271u,
+  	2123779094u, 2123187386u, 2122530867u, 2121799464u, 2120980787u, 2120059418u,
+  	2119015917u, 2117825402u, 2116455471u, 2114863093u, 2112989789u, 2110753906u,
+  	2108037662u, 2104664315u, 2100355223u, 2094642347u, 2086670106u, 2074676188u,
+  	2054300022u, 2010539237u
+  };
+
+  static const double zig_wn[128] = {
+  	1.729040521542798e-09, 1.2680928447002762e-10, 1.6897517773184551e-10,
+  	1.9862688442479051e-10, 2.2232431792499955e-10, 2.4244936125448931e-10,
+  	2.6016131900632064e-10, 2.7611988711703956e-10, 2.9073962817715979e-10,
+  	3.0429970414376596e-10, 3.1699795213954273e-10, 3.2898020527113064e-10,
+  	3.4035738121834064e-10, 3.5121602213664708e-10, 3.616250995056517e-10,
+  	3.7164057634959785e-10, 3.8130856431105979e-10, 3.9066756809948822e-10,
+  	3.9975011869976912e-10, 4.0858398615984403e-10, 4.1719309640160654e-10,
+  	4.2559823534592626e-10, 4.3381759739255105e-10, 4.4186721812528858e-10,
+  	4.4976131962665818e-10, 4.5751258894588287e-10, 4.6513240481400098e-10,
+  	4.7263102384811756e-10, 4.800177347232567e-10, 4.8730098677987483e-10,
+  	4.9448849805389729e-10, 5.0158734661196158e-10, 5.0860404824245599e-10,
+  	5.15544622919539e-10, 5.2241465197063155e-10, 5.2921932750063053e-10,
+  	5.3596349533128897e-10, 5.4265169248206189e-10, 5.4928818003460213e-10,
+  	5.5587697207607733e-10, 5.6242186129835884e-10, 5.6892644173465501e-10,
+  	5.7539412903756027e-10, 5.8182817863908979e-10, 5.8823170208121699e-10,
+  	5.9460768176249956e-10, 6.0095898431083022e-10, 6.0728837276278847e-10,
+  	6.1359851770541355e-10, 6.1989200751559216e-10, 6.2617135781494294e-10,
+  	6.3243902024354019e-10, 6.3869739064357364e-10, 6.4494881673373833e-10,
+  	6.5119560534646982e-10, 6.5744002929285993e-10, 6.6368433391398755e-10,
+  	6.6993074337233023e-10, 6.7618146673274439e-10, 6.824387038791137e-10,
+  	6.8870465131007329e-10, 6.949815078551667e-10, 7.0127148035131547e-10,
+  	7.0757678931855602e-10, 7.138996746735849e-10, 7.2024240151974857e-10,
+  	7.2660726605270474e-10, 7.329966016220864e-10, 7.3941278499112283e-10,
+  	7.4585824283835391e-10, 7.5233545854834884e-10, 7.5884697934176525e-10,
+  	7.6539542379922632e-10, 7.7198348983844004e-10, 7.786139632098381e-10,
+  	7.8528972658289975e-10, 7.9201376930340978e-10, 7.9878919791135359e-10,
+  	8.0561924752021698e-10, 8.1250729417139681e-10, 8.1945686829257451e-10,
+  	8.2647166940666245e-10, 8.335555822587845e-10, 8.407126945532991e-10,
+  	8.4794731652183716e-10, 8.5526400257760939e-10, 8.6266757535193633e-10,
+  	8.7016315245744244e-10, 8.7775617638032838e-10, 8.8545244797372776e-10,
+  	8.9325816410803695e-10, 9.0117996013566053e-10, 9.092249579511381e-10,
+  	9.1740082057860052e-10, 9.257158144040126e-10, 9.3417888039884721e-10,
+  	9.4279971596663144e-10, 9.5158886939988827e-10, 9.6055784938312528e-10,
+  	9.697192525453944e-10, 9.7908691279089008e-10, 9.8867607706877244e-10,
+  	9.9850361345354251e-10, 1.0085882589914473e-09, 1.0189509168621382e-09,
+  	1.0296150152006668e-09, 1.0406069436999874e-09, 1.0519565892728039e-09,
+  	1.0636979991930871e-09, 1.0758702101645819e-09, 1.0885182960607283e-09,
+  	1.1016947078135044e-09, 1.1154610095597163e-09, 1.1298901613493216e-09,
+  	1.1450695700067237e-09, 1.1611052426022348e-09, 1.1781275609456131e-09,
+  	1.1962995053850756e-09, 1.2158286983295564e-09, 1.2369856290804966e-09,
+  	1.2601323300608525e-09, 1.2857696844205153e-09, 1.3146201849677183e-09,
+  	1.3477839562210855e-09, 1.3870635315067043e-09, 1.435740319181638e-09,
+  	1.5008659030222993e-09, 1.6030947938091123e-09
+  };
+
+  static const double zig_fn[128] = {
+  	1, 0.96359969312708615, 0.93628268168505957,
+  	0.9130436479717402, 0.8922816507840261, 0.87324304891006954,
+  	0.85550060786945059, 0.83878360529598961, 0.82290721138140899,
+  	0.80773829468296054, 0.79317701177130506, 0.7791460859296877,
+  	0.7655841738977045, 0.75244155917461142, 0.73967724367264731,
+  	0.72725691834418482, 0.7151515074104986, 0.70333609901615812,
+  	0.69178914343667508, 0.68049184099733406, 0.66942766734889037,
+  	0.65858200005008805, 0.64794182111022247, 0.6374954773350423,
+  	0.62723248524992725, 0.61714337081888093, 0.60721953662512029,
+  	0.59745315094451668, 0.58783705443470657, 0.57836468111976314,
+  	0.56902999106795094, 0.55982741270408687, 0.55075179311460454,
+  	0.5417983550254255, 0.53296265938383613, 0.52424057267298407,
+  	0.51562823824400184, 0.50712205107556896, 0.4987186354709795,
+  	0.49041482528384411, 0.48220764632948521, 0.47409430069301695,
+  	0.46607215268945612, 0.45813871626787206, 0.45029164368203922,
+  	0.44252871527546844, 0.43484783024999091, 0.42724699830499607,
+  	0.41972433204957438, 0.412278040102661, 0.40490642080722294,
+  	0.39760785649387331, 0.39038080823731458, 0.3832238110559012,
+  	0.37613546951056259, 0.36911445366447221, 0.36215949536931757,
+  	0.35526938484791709, 0.34844296754632659, 0.34167914123155041,
+  	0.33497685331358917, 0.3283350983728503, 0.32175291587598492,
+  	0.31522938806501088, 0.30876363800618112, 0.30235482778648354,
+  	0.29600215684693298, 0.28970486044295984, 0.28346220822323298,
+  	0.27727350291918812, 0.27113807913838461, 0.26505530225558921,
+  	0.25902456739620483, 0.25304529850732577, 0.24711694751232141,
+  	0.24123899354543982, 0.23541094226347908, 0.22963232523211613,
+  	0.22390269938500842, 0.2182216465543054, 0.2125887730717303,
+  	0.20700370943992652, 0.20146611007431367, 0.19597565311627774,
+  	0.19053204031913715, 0.18513499700899219, 0.17978427212329545,
+  	0.1744796383307895, 0.169220892237365, 0.16400785468342038,
+  	0.1588403711394793, 0.15371831220818166, 0.14864157424234226,
+  	0.14361008009062776, 0.1386237799845946, 0.13368265258343937,
+  	0.12878670619594321, 0.12393598020286782, 0.11913054670765083,
+  	0.11437051244886601, 0.10965602101484027, 0.10498725540942132,
+  	0.10036444102865587, 0.095787849121731439, 0.091257800826830257,
+  	0.086774671894780178, 0.082338898242235656, 0.077950982513973394,
+  	0.073611501884113403, 0.069321117393577908, 0.065080585213068073,
+  	0.060890770348040406, 0.056752663481049848, 0.052667401903051012,
+  	0.048636295859867805, 0.044660862200491425, 0.040742868074444175,
+  	0.036884388786656203, 0.033087886146225751, 0.02935631744000685,
+  	0.025693291935934271, 0.022103304615927098, 0.018592102737011288,
+  	0.015167298010546568, 0.011839478657884862, 0.0086244844128598851,
+  	0.0055489952207713449, 0.0026696290838809228
+  };
+  #endif
 
 #else
   // R-API requires that we use it's own random number implementation
@@ -40,20 +169,22 @@
   \sideeffect Increment the stream so that no two generators have the same
     sequence.
 */
-void RandSeed(signed long seed, pcg32_random_t* pcg_rng) {
+void RandSeed(signed long seed, sw_random_t* pcg_rng) {
 //we don't need to set a random seed if RSOILWAT is used
 #ifndef RSOILWAT
 
   if (seed == 0) {
     //seed with a random value. Uses the system time to generate
     //a pseudo-random seed.
-    pcg32_srandom_r(pcg_rng, time(NULL), stream);
+    pcg32_srandom_r(&pcg_rng->pcg, time(NULL), stream);
   }
   else {
     //Seed with a specific value.
-    pcg32_srandom_r(pcg_rng, (int) seed, stream);
+    pcg32_srandom_r(&pcg_rng->pcg, (int) seed, stream);
   }
 
+  pcg_rng->norm_set = 0;
+
   //Increment the stream so no two generators have the same sequence.
   stream++;
 
@@ -65,6 +196,38 @@ void RandSeed(signed long seed, pcg32_random_t* pcg_rng) {
 }
 
 
+/*****************************************************/
+/**
+  \brief Sets the random number seed and stream of a generator.
+
+  Generators with the same seed but different streams produce independent
+  sequences (PCG stream selector); unlike RandSeed(), the sequence depends
+  only on `seed` and `stream_id` and not on how many generators were seeded
+  before, e.g., by other threads. This makes ensembles reproducible
+  regardless of the number of threads that simulate their members.
+
+  \param seed The initial state of the system.
+  \param stream_id The stream of the generator, e.g., the member of an
+    ensemble.
+  \param[in,out] pcg_rng The random number generator to set.
+
+  \sideeffect Discards the cached normal variate of RandNorm().
+*/
+void RandSeedStream(uint64_t seed, uint64_t stream_id,
+  sw_random_t* pcg_rng) {
+#ifndef RSOILWAT
+
+  pcg32_srandom_r(&pcg_rng->pcg, seed, stream_id);
+  pcg_rng->norm_set = 0;
+
+#else
+  // silence compile warnings [-Wunused-parameter]
+  if (pcg_rng == NULL && seed > 0 && stream_id > 0) {}
+
+#endif
+}
+
+
 
 /*****************************************************/
 /**
@@ -74,13 +237,13 @@ void RandSeed(signed long seed, pcg32_random_t* pcg_rng) {
 
   @return A pseudo-random number between 0 and 1.
 */
-double RandUni(pcg32_random_t* pcg_rng) {
+double RandUni(sw_random_t* pcg_rng) {
 
   double res;
 
   #ifndef RSOILWAT
     // get a random double and bit shift is 32 bits (less that 1)
-    res = ldexp(pcg32_random_r(pcg_rng), -32);
+    res = ldexp(pcg32_random_r(&pcg_rng->pcg), -32);
 
   #else
     if (pcg_rng == NULL) {} // silence compile warnings [-Wunused-parameter]
@@ -105,7 +268,7 @@ double RandUni(pcg32_random_t* pcg_rng) {
 
 	\return Random number between the two bounds defined.
 */
-int RandUniIntRange(const long first, const long last, pcg32_random_t* pcg_rng) {
+int RandUniIntRange(const long first, const long last, sw_random_t* pcg_rng) {
 /* History:
 	Return a randomly selected integer between
 	first and last, inclusive.
@@ -139,7 +302,7 @@ int RandUniIntRange(const long first, const long last, pcg32_random_t* pcg_rng)
   #ifndef RSOILWAT
     long r = l - f;
     //pcg32_boundedrand_r returns a random number between 0 and r.
-    res = pcg32_boundedrand_r(pcg_rng, r) + f;
+    res = pcg32_boundedrand_r(&pcg_rng->pcg, r) + f;
 
   #else
     if (pcg_rng == NULL) {} // silence compile warnings [-Wunused-parameter]
@@ -164,7 +327,7 @@ int RandUniIntRange(const long first, const long last, pcg32_random_t* pcg_rng)
 
 	\return Random number between first and last, inclusive.
 */
-float RandUniFloatRange(const float min, const float max, pcg32_random_t* pcg_rng) {
+float RandUniFloatRange(const float min, const float max, sw_random_t* pcg_rng) {
 /* History:
 
 	cwb - 12/5/00
@@ -217,7 +380,7 @@ float RandUniFloatRange(const float min, const float max, pcg32_random_t* pcg_rn
 	\param[out] list Upon return this array will be filled with random values.
   \param[in,out] *pcg_rng The random number generator to use.
 */
-void RandUniList(long count, long first, long last, RandListType list[], pcg32_random_t* pcg_rng) {
+void RandUniList(long count, long first, long last, RandListType list[], sw_random_t* pcg_rng) {
 
 	long i, j, c, range, *klist;
 
@@ -273,6 +436,59 @@ void RandUniList(long count, long first, long last, RandListType list[], pcg32_r
 	Mem_Free(klist);
 }
 
+#if !defined(RSOILWAT) && defined(SW_ZIGGURAT)
+/*****************************************************/
+/**
+	 \brief A pseudo-random number from the standard normal distribution
+	 using the ziggurat method.
+
+	 Adapted from RNOR of Marsaglia, G. & Tsang, W. W. 2000. The ziggurat
+	 method for generating random variables. J Stat Softw 5(8). The layer
+	 and the position within the layer are taken from different bits of one
+	 draw (Doornik 2005). About 99% of the draws require one 32-bit number
+	 and one multiplication.
+
+	\param[in,out] *pcg_rng The random number generator to use.
+*/
+static double RandNormZiggurat(sw_random_t* pcg_rng) {
+	uint32_t u;
+	int32_t hz;
+	int64_t ahz;
+	unsigned int iz;
+	double x, y;
+
+	for (;;) {
+		// lowest 7 bits select the layer, highest 25 bits the position
+		u = pcg32_random_r(&pcg_rng->pcg);
+		iz = u & 127u;
+		hz = (int32_t) (u & 0xFFFFFF80u);
+		ahz = (hz < 0) ? -(int64_t) hz : hz;
+		x = hz * zig_wn[iz];
+
+		if (ahz < zig_kn[iz]) {
+			// inside the rectangle of the layer
+			return x;
+		}
+
+		if (iz == 0) {
+			// base layer: draw from the tail beyond ZIG_R
+			do {
+				x = -log(1. - RandUni(pcg_rng)) / ZIG_R;
+				y = -log(1. - RandUni(pcg_rng));
+			} while (y + y < x * x);
+
+			return (hz > 0) ? ZIG_R + x : -ZIG_R - x;
+		}
+
+		// wedge of the layer
+		if (zig_fn[iz] + RandUni(pcg_rng) * (zig_fn[iz - 1] - zig_fn[iz]) <
+			exp(-.5 * x * x)) {
+			return x;
+		}
+	}
+}
+#endif
+
 /*****************************************************/
 /**
 	 \brief A pseudo-random number from a normal distribution.
@@ -281,42 +497,49 @@ void RandUniList(long count, long first, long last, RandListType list[], pcg32_r
 	 adapted from FUNCTION GASDEV in
 	 Press, et al., 1986, Numerical Recipes,
 	 p203, Press Syndicate, NY.
-	 To reset the random number sequence,
-	 set _randseed to any negative number
-	 prior to calling any function, that
-	 depends on RandUni().
+	 The second variate of a pair is kept by the
+	 generator `pcg_rng` for its next call; re-seeding
+	 the generator discards it.
+
+	 If compiled with `SW_ZIGGURAT`, then variates
+	 are drawn with the faster ziggurat method
+	 instead (see RandNormZiggurat()); sequences
+	 differ from those of the default method.
 
 	\param mean The mean of the distribution
 	\param stddev Standard deviation of the distribution
   \param[in,out] *pcg_rng The random number generator to use.
 */
-double RandNorm(double mean, double stddev, pcg32_random_t* pcg_rng) {
+double RandNorm(double mean, double stddev, sw_random_t* pcg_rng) {
 /* History:
 	 cwb - 6/20/00
 	 cwb - 09-Dec-2002 -- FINALLY noticed that
 	 gasdev and gset have to be static!
 	 might as well set the others.
+	 10/18/2026 -- gset and set are carried by
+	 the generator instead of being static
 */
 	double res;
 
-	#ifndef RSOILWAT
-		static short set = 0;
+	#if !defined(RSOILWAT) && defined(SW_ZIGGURAT)
+		res = mean + RandNormZiggurat(pcg_rng) * stddev;
 
-		static double v1, v2, r, fac, gset, gasdev;
+	#elif !defined(RSOILWAT)
+		double v1, v2, r, fac, gasdev;
 
-		if (!set) {
+		if (!pcg_rng->norm_set) {
 			do {
 				v1 = 2.0 * RandUni(pcg_rng) - 1.0;
 				v2 = 2.0 * RandUni(pcg_rng) - 1.0;
 				r = v1 * v1 + v2 * v2;
 			} while (r >= 1.0);
 			fac = sqrt(-2.0 *log(r)/r);
-			gset = v1 * fac;
+			pcg_rng->norm_gset = v1 * fac;
 			gasdev = v2 * fac;
-			set = 1;
+			pcg_rng->norm_set = 1;
 		} else {
-			gasdev = gset;
-			set = 0;
+			gasdev = pcg_rng->norm_gset;
+			pcg_rng->norm_set = 0;
 		}
 
 		res = mean + gasdev * stddev;
@@ -356,7 +579,7 @@ double RandNorm(double mean, double stddev, pcg32_random_t* pcg_rng) {
   \param[in,out] *pcg_rng The random number generator to use.
   \return A random variate of a beta distribution.
 */
-float RandBeta ( float aa, float bb, pcg32_random_t* pcg_rng) {
+float RandBeta ( float aa, float bb, sw_random_t* pcg_rng) {
   float a;
   float alpha;
   float b;
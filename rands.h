@@ -7,6 +7,8 @@
  */
 /* Chris Bennett @ LTER-CSU 6/15/2000            */
 /*    - 5/19/2001 - split from gen_funcs.c       */
+/*    - 10/18/2026 - variates keep their state   */
+/*      in the generator (sw_random_t)           */
 
 #ifndef RANDS_H
 
@@ -24,17 +26,31 @@ extern "C" {
 
 typedef long RandListType;
 
+/** A random number generator and the state of its variates
+
+  All state of the random variates is carried by the generator object so
+  that the sequence of a generator depends neither on other generators
+  nor on the thread it is used by.
+*/
+typedef struct {
+  pcg32_random_t pcg; /**< PCG generator, see https://www.pcg-random.org */
+  double norm_gset; /**< Second normal variate of the last Box-Muller pair */
+  short norm_set; /**< Whether `norm_gset` is available to `RandNorm()` */
+} sw_random_t;
+
 /***************************************************
  * Function definitions
  ***************************************************/
 
-void RandSeed(signed long seed, pcg32_random_t* pcg_rng);
-double RandUni(pcg32_random_t* pcg_rng);
-int RandUniIntRange(const long first, const long last, pcg32_random_t* pcg_rng);
-float RandUniFloatRange(const float min, const float max, pcg32_random_t* pcg_rng);
-double RandNorm(double mean, double stddev, pcg32_random_t* pcg_rng);
-void RandUniList(long, long, long, RandListType[], pcg32_random_t* pcg_rng);
-float RandBeta(float aa, float bb, pcg32_random_t* pcg_rng);
+void RandSeed(signed long seed, sw_random_t* pcg_rng);
+void RandSeedStream(uint64_t seed, uint64_t stream_id,
+  sw_random_t* pcg_rng);
+double RandUni(sw_random_t* pcg_rng);
+int RandUniIntRange(const long first, const long last, sw_random_t* pcg_rng);
+float RandUniFloatRange(const float min, const float max, sw_random_t* pcg_rng);
+double RandNorm(double mean, double stddev, sw_random_t* pcg_rng);
+void RandUniList(long, long, long, RandListType[], sw_random_t* pcg_rng);
+float RandBeta(float aa, float bb, sw_random_t* pcg_rng);
 
 
 #ifdef __cplusplus
@@ -49,12 +49,12 @@ const char * masterfile_test = "files.in"; // relative to 'dir_test'
 
 // Global variables which are defined in SW_Main_lib.c:
 // We need to redefine them here because they are not included in the library
-char inbuf[MAX_FILENAMESIZE];
-char errstr[MAX_ERROR];
-FILE *logfp;
-int logged;
-Bool QuietMode, EchoInits;
-char _firstfile[MAX_FILENAMESIZE];
+SW_TLS char inbuf[MAX_FILENAMESIZE];
+SW_TLS char errstr[MAX_ERROR];
+SW_TLS FILE *logfp;
+SW_TLS int logged;
+SW_TLS Bool QuietMode, EchoInits;
+SW_TLS char _firstfile[MAX_FILENAMESIZE];
 
 
 
@@ -83,7 +83,7 @@ int main(int argc, char **argv) {
   res = RUN_ALL_TESTS();
 
   //--- Take down SOILWAT2 variables
-  SW_CTL_clear_model(swTRUE); // de-allocate all memory
+  SW_CTL_clear_model(NULL, swTRUE); // de-allocate all memory
 
   //--- Return output of 'RUN_ALL_TESTS()', see https://github.com/google/googletest/blob/master/googletest/docs/FAQ.md#my-compiler-complains-about-ignoring-return-value-when-i-call-run_all_tests-why
   return res;
@@ -36,19 +36,19 @@
 
 #include "sw_testhelpers.h"
 
-extern char _firstfile[];
-extern SW_SITE SW_Site;
+extern SW_TLS char _firstfile[];
+extern SW_TLS SW_SITE SW_Site;
 
-extern SW_MODEL SW_Model;
+extern SW_TLS SW_MODEL SW_Model;
 
 /** Initialize SOILWAT2 variables and read values from example input file
  */
 void Reset_SOILWAT2_after_UnitTest(void) {
-  SW_CTL_clear_model(swFALSE);
+  SW_CTL_clear_model(NULL, swFALSE);
 
-  SW_CTL_setup_model(_firstfile);
-  SW_CTL_read_inputs_from_disk();
-  SW_CTL_init_run();
+  SW_CTL_setup_model(NULL, _firstfile);
+  SW_CTL_read_inputs_from_disk(NULL);
+  SW_CTL_init_run(NULL);
 
 
   // Next two function calls will require SW_Output.c
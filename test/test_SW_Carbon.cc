@@ -38,9 +38,9 @@
 #include "sw_testhelpers.h"
 
 
-extern SW_CARBON SW_Carbon;
-extern SW_MODEL SW_Model;
-extern SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_CARBON SW_Carbon;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGPROD SW_VegProd;
 
 
 
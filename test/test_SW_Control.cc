@@ -0,0 +1,230 @@
+#include "gtest/gtest.h"
+#include <assert.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <memory.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../generic.h"
+#include "../myMemory.h"
+#include "../filefuncs.h"
+#include "../rands.h"
+#include "../Times.h"
+#include "../SW_Defines.h"
+#include "../SW_Times.h"
+#include "../SW_Files.h"
+#include "../SW_Carbon.h"
+#include "../SW_Site.h"
+#include "../SW_VegProd.h"
+#include "../SW_VegEstab.h"
+#include "../SW_Model.h"
+#include "../SW_SoilWater.h"
+#include "../SW_Weather.h"
+#include "../SW_Markov.h"
+#include "../SW_Sky.h"
+#include "../SW_Control.h"
+#include "../SW_Snapshot.h"
+
+#include "sw_testhelpers.h"
+
+
+extern SW_TLS char _firstfile[];
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_SITE SW_Site;
+
+
+namespace {
+  // Two simulation runs that are interleaved year by year on one thread
+  // produce the same results as a run that is simulated on its own
+  TEST(SWRunTest, InterleavedRuns) {
+    static SW_RUN run_ref, run1, run2; // zero-initialized
+    SW_RUN *runs[2] = {&run1, &run2};
+    RealD swc_ref[MAX_LAYERS], sTemp_ref[MAX_LAYERS], snowpack_ref;
+    TimeInt year, startyr, endyr;
+    LyrIndex i, n_layers;
+    int k;
+
+    // Reference: simulate a run on its own
+    SW_CTL_setup_model(&run_ref, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_ref);
+    SW_Site.use_soil_temp = swTRUE;
+    SW_CTL_init_run(&run_ref);
+    SW_CTL_main(&run_ref);
+
+    n_layers = SW_Site.n_layers;
+    startyr = SW_Model.startyr;
+    endyr = SW_Model.endyr;
+    snowpack_ref = SW_Soilwat.snowpack[Today];
+    for (i = 0; i < n_layers; i++) {
+      swc_ref[i] = SW_Soilwat.swcBulk[Today][i];
+      sTemp_ref[i] = SW_Soilwat.sTemp[i];
+    }
+
+    // Set up two runs from the same inputs
+    for (k = 0; k < 2; k++) {
+      SW_CTL_setup_model(runs[k], _firstfile);
+      SW_CTL_read_inputs_from_disk(runs[k]);
+      SW_Site.use_soil_temp = swTRUE;
+      SW_CTL_init_run(runs[k]);
+      EXPECT_EQ(runs[k], SW_CTL_active_run());
+    }
+
+    // Alternate between the two runs after each year
+    for (year = startyr; year <= endyr; year++) {
+      for (k = 0; k < 2; k++) {
+        SW_CTL_activate_run(runs[k]);
+        SW_Model.year = year;
+        SW_CTL_run_current_year(NULL);
+      }
+    }
+
+    for (k = 0; k < 2; k++) {
+      SW_CTL_activate_run(runs[k]);
+
+      EXPECT_EQ(n_layers, SW_Site.n_layers);
+      EXPECT_DOUBLE_EQ(snowpack_ref, SW_Soilwat.snowpack[Today]);
+      for (i = 0; i < n_layers; i++) {
+        EXPECT_DOUBLE_EQ(swc_ref[i], SW_Soilwat.swcBulk[Today][i]) <<
+          "run " << k << ", soil layer " << i;
+        EXPECT_DOUBLE_EQ(sTemp_ref[i], SW_Soilwat.sTemp[i]) <<
+          "run " << k << ", soil layer " << i;
+      }
+
+      SW_CTL_clear_model(runs[k], swFALSE);
+    }
+    SW_CTL_clear_model(&run_ref, swFALSE);
+
+    // Return to the thread's own state which was not touched by any run
+    SW_CTL_release_run();
+    EXPECT_TRUE(SW_CTL_active_run() == NULL);
+    EXPECT_EQ(n_layers, SW_Site.n_layers);
+  }
+
+
+  // A run that continues from a checkpoint produces the same results as
+  // a run that is simulated without interruption
+  TEST(SWRunTest, RestartFromCheckpoint) {
+    static SW_RUN run_ref, run_first, run_rest; // zero-initialized
+    const char *fname = "Output/test_checkpoint.bin";
+    RealD swc_ref[MAX_LAYERS], sTemp_ref[MAX_LAYERS], snowpack_ref;
+    TimeInt year, startyr, endyr, midyr;
+    LyrIndex i, n_layers;
+
+    // Reference: simulate all years without interruption
+    SW_CTL_setup_model(&run_ref, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_ref);
+    SW_Site.use_soil_temp = swTRUE;
+    SW_CTL_init_run(&run_ref);
+    SW_CTL_main(&run_ref);
+
+    n_layers = SW_Site.n_layers;
+    startyr = SW_Model.startyr;
+    endyr = SW_Model.endyr;
+    midyr = startyr + (endyr - startyr) / 2;
+    snowpack_ref = SW_Soilwat.snowpack[Today];
+    for (i = 0; i < n_layers; i++) {
+      swc_ref[i] = SW_Soilwat.swcBulk[Today][i];
+      sTemp_ref[i] = SW_Soilwat.sTemp[i];
+    }
+
+    // Simulate the first years and save the state
+    SW_CTL_setup_model(&run_first, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_first);
+    SW_Site.use_soil_temp = swTRUE;
+    SW_CTL_init_run(&run_first);
+    for (year = startyr; year <= midyr; year++) {
+      SW_Model.year = year;
+      SW_CTL_run_current_year(NULL);
+    }
+    SW_CTL_save_state(&run_first, fname);
+
+    // Continue a new run from the saved state
+    SW_CTL_setup_model(&run_rest, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_rest);
+    SW_Site.use_soil_temp = swTRUE;
+    SW_CTL_init_run(&run_rest);
+    SW_CTL_load_state(&run_rest, fname);
+    EXPECT_EQ(midyr + 1, SW_Model.startyr);
+    SW_CTL_main(&run_rest);
+
+    EXPECT_DOUBLE_EQ(snowpack_ref, SW_Soilwat.snowpack[Today]);
+    for (i = 0; i < n_layers; i++) {
+      EXPECT_DOUBLE_EQ(swc_ref[i], SW_Soilwat.swcBulk[Today][i]) <<
+        "soil layer " << i;
+      EXPECT_DOUBLE_EQ(sTemp_ref[i], SW_Soilwat.sTemp[i]) <<
+        "soil layer " << i;
+    }
+
+    SW_CTL_clear_model(&run_rest, swFALSE);
+    SW_CTL_clear_model(&run_first, swFALSE);
+    SW_CTL_clear_model(&run_ref, swFALSE);
+    SW_CTL_release_run();
+    remove(fname);
+  }
+
+
+  // Several runs continue from the same checkpoint in memory
+  TEST(SWRunTest, ForkFromCheckpointInMemory) {
+    static SW_RUN run_ref, run_spinup, run_fork[2]; // zero-initialized
+    SW_SNAP_BUFFER state;
+    RealD swc_ref[MAX_LAYERS];
+    TimeInt year, midyr;
+    LyrIndex i, n_layers;
+    int k;
+
+    SW_CTL_setup_model(&run_ref, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_ref);
+    SW_CTL_init_run(&run_ref);
+    SW_CTL_main(&run_ref);
+
+    n_layers = SW_Site.n_layers;
+    midyr = SW_Model.startyr + (SW_Model.endyr - SW_Model.startyr) / 2;
+    for (i = 0; i < n_layers; i++) {
+      swc_ref[i] = SW_Soilwat.swcBulk[Today][i];
+    }
+
+    // Shared spin-up
+    SW_CTL_setup_model(&run_spinup, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_spinup);
+    SW_CTL_init_run(&run_spinup);
+    for (year = SW_Model.startyr; year <= midyr; year++) {
+      SW_Model.year = year;
+      SW_CTL_run_current_year(NULL);
+    }
+    SW_SNAP_store_state(&state);
+
+    // Forks
+    for (k = 0; k < 2; k++) {
+      SW_CTL_setup_model(&run_fork[k], _firstfile);
+      SW_CTL_read_inputs_from_disk(&run_fork[k]);
+      SW_CTL_init_run(&run_fork[k]);
+      SW_SNAP_restore_state(&state);
+      SW_CTL_main(&run_fork[k]);
+
+      for (i = 0; i < n_layers; i++) {
+        EXPECT_DOUBLE_EQ(swc_ref[i], SW_Soilwat.swcBulk[Today][i]) <<
+          "fork " << k << ", soil layer " << i;
+      }
+    }
+
+    Mem_Free(state.data);
+    for (k = 0; k < 2; k++) {
+      SW_CTL_clear_model(&run_fork[k], swFALSE);
+    }
+    SW_CTL_clear_model(&run_spinup, swFALSE);
+    SW_CTL_clear_model(&run_ref, swFALSE);
+    SW_CTL_release_run();
+  }
+
+} // namespace
@@ -40,13 +40,13 @@
 
 #include "sw_testhelpers.h"
 
-extern SW_SITE SW_Site;
-extern SW_MODEL SW_Model;
-extern SW_VEGPROD SW_VegProd;
-extern ST_RGR_VALUES stValues;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS ST_RGR_VALUES stValues;
 //extern SW_SOILWAT_OUTPUTS SW_Soilwat_outputs;
 
-pcg32_random_t flow_rng;
+sw_random_t flow_rng;
 SW_VEGPROD *v = &SW_VegProd;
 SW_SITE *s = &SW_Site;
 ST_RGR_VALUES *st = &stValues;
@@ -213,7 +213,7 @@ namespace
     double *impermeability2 = new double[nlyrs];
     double *drain2 = new double[nlyrs];
 
-    pcg32_random_t infiltrate_rng;
+    sw_random_t infiltrate_rng;
     RandSeed(0,&infiltrate_rng);
 
     for (i = 0; i < MAX_LAYERS; i++)
@@ -372,10 +372,10 @@ namespace
     {
       // copy soil layer values into arrays so that they can be passed as
       // arguments to `transp_weighted_avg`
-      tr_coeff2[i] = s->lyr[i]->transp_coeff[SW_SHRUB];
+      tr_coeff2[i] = s->transp_coeff[SW_SHRUB][i];
 
       // example: swc as mean of wilting point and field capacity
-      swc2[i] = (s->lyr[i]->swcBulk_fieldcap + s->lyr[i]->swcBulk_wiltpt) / 2.;
+      swc2[i] = (s->swcBulk_fieldcap[i] + s->swcBulk_wiltpt[i]) / 2.;
     }
 
 
@@ -460,11 +460,11 @@ namespace
       {
         // copy soil layer values into arrays so that they can be passed as
         // arguments to `pot_soil_evap`
-        width[i] = s->lyr[i]->width;
-        lyrEvapCo[i] = s->lyr[i]->evap_coeff;
+        width[i] = s->width[i];
+        lyrEvapCo[i] = s->evap_coeff[i];
 
         // example: swc as mean of wilting point and field capacity
-        swc[i] = (s->lyr[i]->swcBulk_fieldcap + s->lyr[i]->swcBulk_wiltpt) / 2.;
+        swc[i] = (s->swcBulk_fieldcap[i] + s->swcBulk_wiltpt[i]) / 2.;
       }
 
       // Begin TEST if (totagb >= Es_param_limit)
@@ -559,10 +559,10 @@ namespace
       {
         // copy soil layer values into arrays so that they can be passed as
         // arguments to `pot_soil_evap`
-        width[i] = s->lyr[i]->width;
-        ecoeff[i] = s->lyr[i]->evap_coeff;
+        width[i] = s->width[i];
+        ecoeff[i] = s->evap_coeff[i];
         // example: swc as mean of wilting point and field capacity
-        swc[i] = (s->lyr[i]->swcBulk_fieldcap + s->lyr[i]->swcBulk_wiltpt) / 2.;
+        swc[i] = (s->swcBulk_fieldcap[i] + s->swcBulk_wiltpt[i]) / 2.;
       }
 
       //Begin TEST for bserate when nelyrs = 1
@@ -760,7 +760,7 @@ namespace
       ForEachSoilLayer(i)
       {
         // Setup: initial swc to some example value, here SWC at 20% VWC
-        swc_init[i] = 0.2 * s->lyr[i]->width;
+        swc_init[i] = 0.2 * s->width[i];
         // Setup: water extraction coefficient, some example value, here 0.5
         coeff[i] = 0.5;
       }
@@ -925,7 +925,7 @@ namespace
       // Initialize soil arrays to be independent of soil texture...
       ForEachSoilLayer(i)
       {
-        width[i] = s->lyr[i]->width;
+        width[i] = s->width[i];
         swcfc[i] = 0.25 * width[i];
         swcmin[i] = 0.05 * width[i];
         swcsat[i] = 0.35 * width[i];
@@ -1116,7 +1116,7 @@ namespace
     unsigned int nlyrs, i, k;
     double maxCondroot = -0.2328, swp50 = 1.2e12, shapeCond = 1, scale = 0.3;
     double swc[MAX_LAYERS], swcwp[MAX_LAYERS], lyrRootCo[MAX_LAYERS],
-      hydred[MAX_LAYERS] = {0.};
+      swp[MAX_LAYERS], swpwp[MAX_LAYERS], hydred[MAX_LAYERS] = {0.};
     double swcExpected = 0., hydredExpected = 0.;
 
     // INPUTS for expected outcomes
@@ -1153,14 +1153,16 @@ namespace
       ForEachSoilLayer(i)
       {
         // example data based on soil:
-        swc[i] = (s->lyr[i]->swcBulk_fieldcap + s->lyr[i]->swcBulk_wiltpt) / 2.;
-        swcwp[i] = s->lyr[i]->swcBulk_wiltpt;
-        lyrRootCo[i] =  s->lyr[i]->transp_coeff[SW_SHRUB]; // shrubs as example
+        swc[i] = (s->swcBulk_fieldcap[i] + s->swcBulk_wiltpt[i]) / 2.;
+        swcwp[i] = s->swcBulk_wiltpt[i];
+        lyrRootCo[i] =  s->transp_coeff[SW_SHRUB][i]; // shrubs as example
         st->lyrFrozen[i] = swFALSE;
+        swp[i] = SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], swc[i], i);
+        swpwp[i] = SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], swcwp[i], i);
       }
 
       // Call function to be tested
-      hydraulic_redistribution(swc, swcwp, lyrRootCo, hydred, nlyrs,
+      hydraulic_redistribution(swc, swp, swcwp, swpwp, lyrRootCo, hydred, nlyrs,
         maxCondroot, swp50, shapeCond, scale);
 
       // Expection: no hydred in top layer
@@ -1187,6 +1189,10 @@ namespace
         EXPECT_NEAR(hydred[i], hydredExpected, tol6) <<
           "hydraulic_redistribution: hydred != hydredExpected0 for layer " <<
           1 + i << " out of "<< nlyrs << " soil layers";
+
+        // Expection: water potential is updated to the new water content
+        EXPECT_DOUBLE_EQ(swp[i],
+          SW_SWCbulk2SWPmatric(s->fractionVolBulk_gravel[i], swc[i], i));
       }
 
       // Reset to previous global states.
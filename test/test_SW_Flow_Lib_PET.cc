@@ -42,7 +42,7 @@
 
 #include "sw_testhelpers.h"
 
-extern char output_prefix[FILENAME_MAX];
+extern SW_TLS char output_prefix[FILENAME_MAX];
 
 
 namespace
@@ -585,6 +585,117 @@ namespace
   #endif // end of SW2_SolarPosition_Test__hourangles_by_lats
 
 
+  // Test that solar geometry tables are reused across runs and
+  // can be saved to and loaded from disk
+  TEST(SW2_SolarPosition_Test, solargeom_cache)
+  {
+    const char *fname = "test_solargeom.sw2g";
+    double
+      lats[2] = {0.7, -0.3},
+      slopes[2] = {0.3, 0.},
+      aspects[2] = {0.5, NAN}, // missing aspect may be NaN
+      sun_angles[2][366][7], int_cos_theta[2][366][2], int_sin_beta[2][366][2],
+      sa[7], ict[2], isb[2];
+    unsigned int k, doy, i;
+
+    SW_PET_solargeom_clear();
+    EXPECT_EQ(0u, SW_PET_solargeom_size());
+
+    for (k = 0; k < 2; k++) {
+      for (doy = 1; doy <= 366; doy++) {
+        sun_hourangles(
+          doy, lats[k], slopes[k], aspects[k],
+          sun_angles[k][doy - 1], int_cos_theta[k][doy - 1],
+          int_sin_beta[k][doy - 1]
+        );
+      }
+    }
+
+    // One table per location which survives the end of a run
+    EXPECT_EQ(2u, SW_PET_solargeom_size());
+    Reset_SOILWAT2_after_UnitTest();
+    EXPECT_EQ(2u, SW_PET_solargeom_size());
+
+    // Save, clear, and load tables
+    SW_PET_solargeom_write(fname);
+    SW_PET_solargeom_clear();
+    EXPECT_EQ(0u, SW_PET_solargeom_size());
+
+    EXPECT_TRUE(SW_PET_solargeom_read(fname));
+    EXPECT_EQ(2u, SW_PET_solargeom_size());
+
+    // Loading again does not add duplicate tables
+    EXPECT_TRUE(SW_PET_solargeom_read(fname));
+    EXPECT_EQ(2u, SW_PET_solargeom_size());
+
+    EXPECT_FALSE(SW_PET_solargeom_read("nonexisting.sw2g"));
+
+    // Loaded tables are identical to calculated tables
+    for (k = 0; k < 2; k++) {
+      for (doy = 1; doy <= 366; doy++) {
+        sun_hourangles(doy, lats[k], slopes[k], aspects[k], sa, ict, isb);
+
+        for (i = 0; i < 7; i++) {
+          EXPECT_EQ(sun_angles[k][doy - 1][i], sa[i]);
+        }
+        for (i = 0; i < 2; i++) {
+          EXPECT_EQ(int_cos_theta[k][doy - 1][i], ict[i]);
+          EXPECT_EQ(int_sin_beta[k][doy - 1][i], isb[i]);
+        }
+      }
+    }
+
+    EXPECT_EQ(2u, SW_PET_solargeom_size());
+
+    remove(fname);
+    SW_PET_solargeom_clear();
+  }
+
+
+  // Test that the least recently used solar geometry tables are released
+  // once more than `SW_SOLARGEOM_MAXTABLES` are kept
+  TEST(SW2_SolarPosition_Test, solargeom_cache_bounded)
+  {
+    double
+      sa0[7], ict0[2], isb0[2], sa[7], ict[2], isb[2],
+      slope = 0.2, aspect = 0.1;
+    unsigned int k, i;
+
+    SW_PET_solargeom_clear();
+
+    sun_hourangles(100, 0.5, slope, aspect, sa0, ict0, isb0);
+
+    for (k = 1; k <= SW_SOLARGEOM_MAXTABLES + 10; k++) {
+      sun_hourangles(100, 0.5 + 1e-4 * k, slope, aspect, sa, ict, isb);
+
+      // First table remains among the recently used tables
+      if (k % 100 == 0) {
+        sun_hourangles(100, 0.5, slope, aspect, sa, ict, isb);
+      }
+
+      ASSERT_LE(SW_PET_solargeom_size(), (unsigned int) SW_SOLARGEOM_MAXTABLES);
+    }
+    EXPECT_EQ((unsigned int) SW_SOLARGEOM_MAXTABLES, SW_PET_solargeom_size());
+
+    // Released tables are calculated again
+    for (k = 1; k <= 10; k++) {
+      sun_hourangles(100, 0.5 + 1e-4 * k, slope, aspect, sa, ict, isb);
+    }
+    sun_hourangles(100, 0.5, slope, aspect, sa, ict, isb);
+
+    for (i = 0; i < 7; i++) {
+      EXPECT_EQ(sa0[i], sa[i]);
+    }
+    for (i = 0; i < 2; i++) {
+      EXPECT_EQ(ict0[i], ict[i]);
+      EXPECT_EQ(isb0[i], isb[i]);
+    }
+    EXPECT_EQ((unsigned int) SW_SOLARGEOM_MAXTABLES, SW_PET_solargeom_size());
+
+    SW_PET_solargeom_clear();
+  }
+
+
   // Test extraterrestrial solar radiation
   //   Comparison against examples by Duffie & Beckman 2013 are expected to
   //   deviate in value, but show similar patterns, because equations for
@@ -857,8 +968,9 @@ namespace
     double
       // Inputs
       lats[] = {-90., -45., 0., 45., 90.},
-      // Expected PET
-      expected_pet_lats[] = {0.1550, 0.4360, 0.3597, 0.1216, 0.0421};
+      // Expected PET (lat = -90: previously 0.1550 due to memoized values
+      // of the previous latitude)
+      expected_pet_lats[] = {0.4166, 0.4360, 0.3597, 0.1216, 0.0421};
 
     for (i = 0; i < 5; i++)
     {
@@ -42,10 +42,10 @@
 
 #include "sw_testhelpers.h"
 
-extern SW_MODEL SW_Model;
-extern SW_VEGPROD SW_VegProd;
-extern ST_RGR_VALUES stValues;
-pcg32_random_t flowTemp_rng;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS ST_RGR_VALUES stValues;
+sw_random_t flowTemp_rng;
 
 namespace {
 
@@ -96,7 +96,7 @@ namespace {
     double deltaX = 15.0, theMaxDepth = 990.0, sTconst = 4.15;
     unsigned int nlyrs, nRgr = 65;
     Bool ptr_stError = swFALSE;
-    pcg32_random_t STInit_rng;
+    sw_random_t STInit_rng;
     RandSeed(0,&STInit_rng);
 
     // *****  Test when nlyrs = 1  ***** //
@@ -177,7 +177,7 @@ namespace {
     double *bDensity2 = new double[nlyrs];
     double *fc2 = new double[nlyrs];
     double *wp2 = new double[nlyrs];
-    pcg32_random_t STInitDeath_rng;
+    sw_random_t STInitDeath_rng;
     RandSeed(0,&STInitDeath_rng);
 
     for (i = 0; i < nlyrs; i++) {
@@ -207,7 +207,7 @@ namespace {
     unsigned int nlyrs, nRgr = 65;
     Bool ptr_stError = swFALSE;
 
-    pcg32_random_t SLIF_rng;
+    sw_random_t SLIF_rng;
     RandSeed(0,&SLIF_rng);
 
     // *****  Test when nlyrs = 1  ***** //
@@ -364,7 +364,7 @@ namespace {
     unsigned int nRgr =65;
     Bool ptr_stError = swFALSE;
 
-    pcg32_random_t STTF_rng;
+    sw_random_t STTF_rng;
     RandSeed(0,&STTF_rng);
 
     // declare input in for loop for non-error causing conditions;
@@ -427,6 +427,133 @@ namespace {
     Reset_SOILWAT2_after_UnitTest();
   }
 
+  // Test implicit soil temperature today function
+  // 'soil_temperature_today_implicit'
+  TEST(SWFlowTempTest, SoilTemperatureTodayImplicitFunction) {
+    double deltaX = 15.0, T1 = 20.0, sTconst = 4.16, csParam1 = 0.00070,
+    csParam2 = 0.000030, shParam = 0.18;
+    unsigned int i, nRgr = 65;
+    Bool ptr_stError = swFALSE;
+
+    double sTempR[MAX_ST_RGR], oldsTempR[MAX_ST_RGR], wpR[MAX_ST_RGR],
+      fcR[MAX_ST_RGR], vwcR[MAX_ST_RGR], bDensityR[MAX_ST_RGR];
+
+    // A linear temperature profile between constant boundary conditions
+    // is the steady state
+    for (i = 0; i <= nRgr + 1; i++) {
+      oldsTempR[i] = T1 + (sTconst - T1) * i / (nRgr + 1.);
+      fcR[i] = 2.1;
+      wpR[i] = 1.5;
+      vwcR[i] = 1.6;
+      bDensityR[i] = 1.5;
+    }
+
+    soil_temperature_today_implicit(deltaX, T1, sTconst, nRgr, sTempR,
+      oldsTempR, vwcR, wpR, fcR, bDensityR, csParam1, csParam2, shParam,
+      &ptr_stError);
+
+    EXPECT_EQ(ptr_stError, swFALSE);
+    EXPECT_EQ(sTempR[0], T1);
+    EXPECT_EQ(sTempR[nRgr + 1], sTconst);
+    for (i = 0; i <= nRgr + 1; i++) {
+      EXPECT_NEAR(sTempR[i], oldsTempR[i], tol9);
+    }
+
+    // Unrealistic temperature values are flagged as error
+    for (i = 0; i <= nRgr + 1; i++) {
+      oldsTempR[i] = 150.;
+    }
+
+    soil_temperature_today_implicit(deltaX, T1, sTconst, nRgr, sTempR,
+      oldsTempR, vwcR, wpR, fcR, bDensityR, csParam1, csParam2, shParam,
+      &ptr_stError);
+
+    EXPECT_EQ(ptr_stError, swTRUE);
+  }
+
+
+  // Regression test: implicit scheme 'soil_temperature_today_implicit'
+  // agrees with the explicit scheme 'soil_temperature_today' (run with a
+  // short time step of 337.5 seconds as reference) over two years with
+  // a seasonal surface temperature
+  TEST(SWFlowTempTest, SoilTemperatureTodayImplicitVsExplicit) {
+    double delta_time, sT1, sTconst = 4.16, csParam1 = 0.00070,
+      csParam2 = 0.00030, shParam = 0.18;
+    double deltaX[] = {15., 10.}, maxDepth = 990.;
+    unsigned int i, k, doy, nRgr;
+    Bool stError_expl = swFALSE, stError_impl = swFALSE;
+
+    double sTempR_expl[MAX_ST_RGR], sTempR_impl[MAX_ST_RGR],
+      oldsTempR_expl[MAX_ST_RGR], oldsTempR_impl[MAX_ST_RGR],
+      wpR[MAX_ST_RGR], fcR[MAX_ST_RGR], vwcR[MAX_ST_RGR],
+      bDensityR[MAX_ST_RGR];
+
+    for (k = 0; k < length(deltaX); k++) {
+      nRgr = (unsigned int) (maxDepth / deltaX[k]) - 1;
+
+      for (i = 0; i <= nRgr + 1; i++) {
+        oldsTempR_expl[i] = oldsTempR_impl[i] = sTconst;
+        fcR[i] = 0.3;
+        wpR[i] = 0.1;
+        vwcR[i] = 0.1 + 0.15 * i / (nRgr + 1.);
+        bDensityR[i] = 1.5;
+      }
+
+      for (doy = 0; doy < 2 * 365; doy++) {
+        sT1 = sTconst + 15. * sin(2. * swPI * doy / 365.);
+
+        delta_time = SEC_PER_DAY / 256.;
+        soil_temperature_today(&delta_time, deltaX[k], sT1, sTconst, nRgr,
+          sTempR_expl, oldsTempR_expl, vwcR, wpR, fcR, bDensityR,
+          csParam1, csParam2, shParam, &stError_expl);
+
+        soil_temperature_today_implicit(deltaX[k], sT1, sTconst, nRgr,
+          sTempR_impl, oldsTempR_impl, vwcR, wpR, fcR, bDensityR,
+          csParam1, csParam2, shParam, &stError_impl);
+
+        ASSERT_EQ(stError_expl, swFALSE);
+        ASSERT_EQ(stError_impl, swFALSE);
+
+        for (i = 0; i <= nRgr + 1; i++) {
+          ASSERT_NEAR(sTempR_impl[i], sTempR_expl[i], tol1) <<
+            "deltaX = " << deltaX[k] << ", day " << doy << ", layer " << i;
+
+          oldsTempR_expl[i] = sTempR_expl[i];
+          oldsTempR_impl[i] = sTempR_impl[i];
+        }
+      }
+    }
+
+
+    // Implicit scheme is stable where the explicit scheme fails
+    // (more than 16 sub-daily time steps would be required)
+    deltaX[0] = 2.;
+    nRgr = (unsigned int) (180. / deltaX[0]) - 1;
+    delta_time = SEC_PER_DAY;
+    sT1 = 25.;
+
+    for (i = 0; i <= nRgr + 1; i++) {
+      oldsTempR_expl[i] = oldsTempR_impl[i] = sTconst;
+      vwcR[i] = 0.2;
+    }
+
+    soil_temperature_today(&delta_time, deltaX[0], sT1, sTconst, nRgr,
+      sTempR_expl, oldsTempR_expl, vwcR, wpR, fcR, bDensityR,
+      csParam1, csParam2, shParam, &stError_expl);
+    EXPECT_EQ(stError_expl, swTRUE);
+
+    soil_temperature_today_implicit(deltaX[0], sT1, sTconst, nRgr,
+      sTempR_impl, oldsTempR_impl, vwcR, wpR, fcR, bDensityR,
+      csParam1, csParam2, shParam, &stError_impl);
+    EXPECT_EQ(stError_impl, swFALSE);
+
+    for (i = 0; i <= nRgr + 1; i++) {
+      EXPECT_GE(sTempR_impl[i], sTconst - tol9);
+      EXPECT_LE(sTempR_impl[i], sT1 + tol9);
+    }
+  }
+
+
   // Test main soil temperature function 'soil_temperature'
   // AND lyrTemp_to_lyrSoil_temperature as this function
   // is only called in the soil_temperature function
@@ -434,7 +561,7 @@ namespace {
 
     unsigned int k, i;
 
-    pcg32_random_t MSTF_Lyer1_rng;
+    sw_random_t MSTF_Lyer1_rng;
     RandSeed(0,&MSTF_Lyer1_rng);
 
     // *****  Test when nlyrs = 1  ***** //
@@ -461,7 +588,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc, swc_sat, bDensity, width,
       oldsTemp, sTemp, surfaceTemp, nlyrs, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
 
     // Expect that surface temp equals surface_temperature_under_snow() because snow > 0
@@ -475,7 +602,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc, swc_sat, bDensity, width,
       oldsTemp, sTemp, surfaceTemp, nlyrs, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     EXPECT_EQ(surfaceTemp[Today], airTemp + (t1Param1 * pet * (1. - (aet / pet)) * (1. - (biomass / bmLimiter))));
     EXPECT_NE(surfaceTemp[Today], airTemp + ((t1Param2 * (biomass - bmLimiter)) / t1Param3));
@@ -487,7 +614,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc, swc_sat, bDensity, width,
       oldsTemp, sTemp, surfaceTemp, nlyrs, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     EXPECT_EQ(surfaceTemp[Today], airTemp + ((t1Param2 * (biomass - bmLimiter)) / t1Param3));
     EXPECT_NE(surfaceTemp[Today], airTemp + (t1Param1 * pet * (1. - (aet / pet)) * (1. - (biomass / bmLimiter))));
@@ -538,7 +665,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc, swc_sat, bDensity, width,
       oldsTemp2, sTemp2, surfaceTemp, nlyrs, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     // Check that error has occurred as indicated by ptr_stError
     EXPECT_EQ(ptr_stError, swTRUE);
@@ -553,7 +680,7 @@ namespace {
   // is only called in the soil_temperature function
   TEST(SWFlowTempTest, MainSoilTemperatureFunction_LyrMAX) {
     // *****  Test when nlyrs = MAX_LAYERS  ***** //
-    pcg32_random_t soilTemp_rng;
+    sw_random_t soilTemp_rng;
     RandSeed(0, &soilTemp_rng);
 
 
@@ -610,7 +737,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc2, swc_sat2, bDensity2, width2,
       oldsTemp3, sTemp3, surfaceTemp, nlyrs2, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     EXPECT_EQ(surfaceTemp[Today], surface_temperature_under_snow(airTemp, snow));
     EXPECT_NE(surfaceTemp[Today], airTemp + ((t1Param2 * (biomass - bmLimiter)) / t1Param3));
@@ -623,7 +750,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc2, swc_sat2, bDensity2, width2,
       oldsTemp3, sTemp3, surfaceTemp, nlyrs2, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     EXPECT_EQ(surfaceTemp[Today], airTemp + (t1Param1 * pet * (1. - (aet / pet)) * (1. - (biomass / bmLimiter))));
     EXPECT_NE(surfaceTemp[Today], airTemp + ((t1Param2 * (biomass - bmLimiter)) / t1Param3));
@@ -635,7 +762,7 @@ namespace {
     soil_temperature(airTemp, pet, aet, biomass, swc2, swc_sat2, bDensity2, width2,
       oldsTemp3, sTemp3, surfaceTemp, nlyrs2, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError);
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError);
 
     EXPECT_EQ(surfaceTemp[Today], airTemp + ((t1Param2 * (biomass - bmLimiter)) / t1Param3));
     EXPECT_NE(surfaceTemp[Today], airTemp + (t1Param1 * pet * (1. - (aet / pet)) * (1. - (biomass / bmLimiter))));
@@ -685,7 +812,7 @@ namespace {
     EXPECT_DEATH_IF_SUPPORTED(soil_temperature(airTemp, pet, aet, biomass, swc, swc_sat, bDensity, width,
       oldsTemp, sTemp, surfaceTemp, nlyrs, bmLimiter, t1Param1, t1Param2,
       t1Param3, csParam1, csParam2, shParam, snowdepth, sTconst, deltaX, theMaxDepth,
-      nRgr, snow, &ptr_stError), "@ generic.c LogError");
+      nRgr, snow, SW_ST_EXPLICIT, &ptr_stError), "@ generic.c LogError");
 
     //Reset to global state
     Reset_SOILWAT2_after_UnitTest();
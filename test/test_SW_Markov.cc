@@ -36,8 +36,9 @@
 #include "sw_testhelpers.h"
 
 
-extern SW_MODEL SW_Model;
-extern SW_MARKOV SW_Markov;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_MARKOV SW_Markov;
+extern SW_TLS sw_random_t markov_rng;
 
 extern void (*test_mvnorm)(RealD *, RealD *, RealD, RealD, RealD, RealD, RealD);
 extern void (*test_temp_correct_wetdry)(RealD *, RealD *, RealD, RealD, RealD, RealD, RealD);
@@ -149,4 +150,58 @@ namespace {
     EXPECT_LE(tmin, tmax);
   }
 
+
+  // Generating a year at once is identical to generating each day
+  TEST(WGTest, GenerateYear) {
+    TimeInt doy, week, lastdoy = 365;
+    RealD tmax, tmin, rain,
+      scale_precip[MAX_MONTHS],
+      tmax_year[MAX_DAYS], tmin_year[MAX_DAYS], ppt_year[MAX_DAYS];
+
+    SW_MKV_construct();
+
+    for (doy = 0; doy < MAX_DAYS; doy++) {
+      m->wetprob[doy] = 0.6;
+      m->dryprob[doy] = 0.2;
+      m->avg_ppt[doy] = 0.4;
+      m->std_ppt[doy] = 0.3;
+    }
+
+    for (week = 0; week < MAX_WEEKS; week++) {
+      m->u_cov[week][0] = 20. - 0.2 * week;
+      m->u_cov[week][1] = 5. - 0.1 * week;
+      m->v_cov[week][0][0] = 9.;
+      m->v_cov[week][1][1] = 4.;
+      m->v_cov[week][1][0] = m->v_cov[week][0][1] = 3.;
+      m->cfxw[week] = -1.;
+      m->cfxd[week] = 1.;
+      m->cfnw[week] = 0.5;
+      m->cfnd[week] = -0.5;
+    }
+
+    for (doy = 0; doy < MAX_MONTHS; doy++) {
+      scale_precip[doy] = 0.5 + 0.1 * doy;
+    }
+
+    RandSeedStream(11, 3, &markov_rng);
+    SW_MKV_generate_year(1, lastdoy, 0., scale_precip,
+      tmax_year, tmin_year, ppt_year);
+
+    RandSeedStream(11, 3, &markov_rng);
+    rain = 0.;
+
+    for (doy = 0; doy < lastdoy; doy++) {
+      SW_MKV_today(doy, &tmax, &tmin, &rain);
+
+      EXPECT_DOUBLE_EQ(tmax, tmax_year[doy]);
+      EXPECT_DOUBLE_EQ(tmin, tmin_year[doy]);
+      EXPECT_DOUBLE_EQ(rain, ppt_year[doy]);
+
+      rain *= scale_precip[doy2month(doy + 1)];
+    }
+
+    // Reset to previous global state
+    SW_MKV_deconstruct();
+  }
+
 } // namespace
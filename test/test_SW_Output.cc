@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../generic.h"
+#include "../SW_Defines.h"
+#include "../SW_Control.h"
+#include "../SW_Output.h"
+#include "../SW_Output_outmemory.h"
+
+#include "sw_testhelpers.h"
+
+
+// The output code is part of the unit tests only if compiled with
+// `make test CPPFLAGS=-DSW_OUTMEMORY`; otherwise, `SW_Output_mock.c` is used
+#ifdef SW_OUTMEMORY
+
+namespace {
+  // Rows received by the streaming output sink, by output key and period
+  typedef std::vector<RealD> SinkRows[SW_OUTNKEYS][SW_OUTNPERIODS];
+
+  void _collect_rows(OutKey k, OutPeriod pd, const RealD *values,
+    IntUS ncol, void *data) {
+    SinkRows *rows = (SinkRows *) data;
+
+    (*rows)[k][pd].insert((*rows)[k][pd].end(), values, values + ncol);
+  }
+
+
+  // Test that the streaming output sink receives the same rows as the
+  // in-memory output arrays hold after a run of the example
+  TEST(OutputMemoryTest, SinkMatchesArrays) {
+    static SinkRows arrays, rows;
+    size_t nrow[SW_OUTNKEYS][SW_OUTNPERIODS], n, r;
+    IntUS ncol[SW_OUTNKEYS][SW_OUTNPERIODS], nc, i;
+    OutPeriod pds[2] = {eSW_Day, eSW_Year};
+    const RealD *p;
+    int k, j, nkeys;
+
+    // Reference: keep all rows in the output arrays
+    SW_OUT_set_ncol();
+    SW_OUT_create_files();
+    SW_CTL_main(NULL);
+
+    for (k = eSW_NoKey + 1; k < eSW_LastKey; k++) {
+      for (j = 0; j < 2; j++) {
+        p = SW_OUT_get_array((OutKey) k, pds[j], &n, &nc);
+        nrow[k][pds[j]] = n;
+        ncol[k][pds[j]] = nc;
+        if (p != NULL) {
+          arrays[k][pds[j]].assign(p, p + n * nc);
+        }
+      }
+    }
+
+    SW_OUT_close_files();
+    Reset_SOILWAT2_after_UnitTest();
+
+    // Stream the rows of the same run to the sink
+    SW_OUT_set_ncol();
+    SW_OUT_set_sink(_collect_rows, &rows);
+    SW_OUT_create_files();
+    SW_CTL_main(NULL);
+    SW_OUT_close_files();
+    SW_OUT_set_sink(NULL, NULL);
+
+    // Arrays are organized by column, the sink receives one row at a time
+    for (j = 0; j < 2; j++) {
+      nkeys = 0;
+
+      for (k = eSW_NoKey + 1; k < eSW_LastKey; k++) {
+        n = nrow[k][pds[j]];
+        nc = ncol[k][pds[j]];
+
+        if (nc == 0) {
+          EXPECT_EQ(0u, rows[k][pds[j]].size()) << "key " << k;
+          continue;
+        }
+
+        nkeys++;
+        ASSERT_EQ(n * nc, rows[k][pds[j]].size()) <<
+          "key " << k << ", period " << pds[j];
+
+        for (r = 0; r < n; r++) {
+          for (i = 0; i < nc; i++) {
+            EXPECT_EQ(arrays[k][pds[j]][n * i + r], rows[k][pds[j]][nc * r + i])
+              << "key " << k << ", period " << pds[j] << ", row " << r <<
+              ", column " << i;
+          }
+        }
+      }
+
+      EXPECT_GT(nkeys, 0) << "period " << pds[j];
+    }
+
+    // Reset to previous global state
+    Reset_SOILWAT2_after_UnitTest();
+  }
+
+} // namespace
+
+#endif
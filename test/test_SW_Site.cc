@@ -38,11 +38,11 @@
 #include "sw_testhelpers.h"
 
 
-extern SW_CARBON SW_Carbon;
-extern SW_MODEL SW_Model;
-extern SW_VEGPROD SW_VegProd;
-extern SW_SITE SW_Site;
-extern LyrIndex _TranspRgnBounds[];
+extern SW_TLS SW_CARBON SW_Carbon;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS LyrIndex _TranspRgnBounds[];
 
 
 namespace {
@@ -56,31 +56,31 @@ namespace {
     water_eqn(fractionGravel, sand, clay, n);
 
     // Test swcBulk_saturated
-    EXPECT_GT(SW_Site.lyr[n]->swcBulk_saturated, 0.); // The swcBulk_saturated should be greater than 0
-    EXPECT_LT(SW_Site.lyr[n]->swcBulk_saturated, SW_Site.lyr[n]->width); // The swcBulk_saturated can't be greater than the width of the layer
+    EXPECT_GT(SW_Site.swcBulk_saturated[n], 0.); // The swcBulk_saturated should be greater than 0
+    EXPECT_LT(SW_Site.swcBulk_saturated[n], SW_Site.width[n]); // The swcBulk_saturated can't be greater than the width of the layer
 
     // Test thetasMatric
-    EXPECT_GT(SW_Site.lyr[n]->thetasMatric, 36.3); /* Value should always be greater
+    EXPECT_GT(SW_Site.thetasMatric[n], 36.3); /* Value should always be greater
     than 36.3 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_LT(SW_Site.lyr[n]->thetasMatric, 46.8); /* Value should always be less
+    EXPECT_LT(SW_Site.thetasMatric[n], 46.8); /* Value should always be less
     than 46.8 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_DOUBLE_EQ(SW_Site.lyr[n]->thetasMatric,  44.593); /* If sand is .33 and
+    EXPECT_DOUBLE_EQ(SW_Site.thetasMatric[n],  44.593); /* If sand is .33 and
     clay is .33, thetasMatric should be 44.593 */
 
     // Test psisMatric
-    EXPECT_GT(SW_Site.lyr[n]->psisMatric, 3.890451); /* Value should always be greater
+    EXPECT_GT(SW_Site.psisMatric[n], 3.890451); /* Value should always be greater
     than 3.890451 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_LT(SW_Site.lyr[n]->psisMatric,  34.67369); /* Value should always be less
+    EXPECT_LT(SW_Site.psisMatric[n],  34.67369); /* Value should always be less
     than 34.67369 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_DOUBLE_EQ(SW_Site.lyr[n]->psisMatric, 27.586715750763947); /* If sand is
+    EXPECT_DOUBLE_EQ(SW_Site.psisMatric[n], 27.586715750763947); /* If sand is
     .33 and clay is .33, psisMatric should be 27.5867 */
 
     // Test bMatric
-    EXPECT_GT(SW_Site.lyr[n]->bMatric, 2.8); /* Value should always be greater than
+    EXPECT_GT(SW_Site.bMatric[n], 2.8); /* Value should always be greater than
     2.8 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_LT(SW_Site.lyr[n]->bMatric, 18.8); /* Value should always be less
+    EXPECT_LT(SW_Site.bMatric[n], 18.8); /* Value should always be less
     than 18.8 based upon complete consideration of potential range of sand and clay values */
-    EXPECT_DOUBLE_EQ(SW_Site.lyr[n]->bMatric, 8.182); /* If sand is .33 and clay is .33,
+    EXPECT_DOUBLE_EQ(SW_Site.bMatric[n], 8.182); /* If sand is .33 and clay is .33,
     thetasMatric should be 8.182 */
 
     // Reset to previous global states
@@ -131,7 +131,7 @@ namespace {
       // Quickly calculate soil depth for current region as output information
       soildepth = 0.;
       for (id = 0; id <= _TranspRgnBounds[i]; ++id) {
-        soildepth += SW_Site.lyr[id]->width;
+        soildepth += SW_Site.width[id];
       }
 
       EXPECT_EQ(prev_TranspRgnBounds[i], _TranspRgnBounds[i]) <<
@@ -153,7 +153,7 @@ namespace {
 
     // Check that setting one region for one soil layer works
     nRegions = 1;
-    RealD regionLowerBounds3[] = {SW_Site.lyr[0]->width};
+    RealD regionLowerBounds3[] = {SW_Site.width[0]};
     derive_soilRegions(nRegions, regionLowerBounds3);
 
     for (i = 0; i < nRegions; ++i) {
@@ -168,7 +168,7 @@ namespace {
     // Example: one region each for the topmost soil layers
     soildepth = 0.;
     for (i = 0; i < nRegions; ++i) {
-      soildepth += SW_Site.lyr[i]->width;
+      soildepth += SW_Site.width[i];
       regionLowerBounds4[i] = soildepth;
     }
     derive_soilRegions(nRegions, regionLowerBounds4);
@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "../generic.h"
+#include "../myMemory.h"
+#include "../SW_Defines.h"
+#include "../SW_Files.h"
+#include "../SW_Model.h"
+#include "../SW_Site.h"
+#include "../SW_Sky.h"
+#include "../SW_Carbon.h"
+#include "../SW_VegProd.h"
+#include "../SW_VegEstab.h"
+#include "../SW_Weather.h"
+#include "../SW_Control.h"
+#include "../SW_Snapshot.h"
+
+#include "sw_testhelpers.h"
+
+
+extern SW_TLS char _firstfile[];
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_SKY SW_Sky;
+extern SW_TLS SW_CARBON SW_Carbon;
+extern SW_TLS SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_VEGESTAB SW_VegEstab;
+extern SW_TLS SW_WEATHER SW_Weather;
+extern char InputSnapshot[];
+
+
+namespace {
+  const char *snapfile = "Output/test_snapshot.bin";
+
+  // Load the snapshot into a freshly set up run as
+  // `SW_CTL_read_inputs_from_disk()` does
+  Bool load_snapshot(SW_RUN *run, Bool keep) {
+    Bool ok;
+
+    SW_CTL_setup_model(run, _firstfile);
+    SW_F_read(NULL);
+    ok = SW_SNAP_read(snapfile);
+
+    if (!keep) {
+      SW_CTL_clear_model(run, swFALSE);
+    }
+
+    return ok;
+  }
+
+
+  // A loaded snapshot reproduces the parsed inputs
+  TEST(SWSnapshotTest, LoadEqualsParse) {
+    static SW_RUN run_parsed, run_loaded; // zero-initialized
+    SW_MODEL model;
+    SW_SITE site;
+    SW_SKY sky;
+    SW_CARBON carbon;
+    VegType veg[NVEGTYPES];
+    IntU n_spp;
+    RealD scale_precip[MAX_MONTHS];
+
+    remove(snapfile);
+    strcpy(InputSnapshot, snapfile);
+
+    // Parse inputs and write snapshot
+    SW_CTL_setup_model(&run_parsed, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run_parsed);
+
+    memcpy(&model, &SW_Model, sizeof(SW_MODEL));
+    memcpy(&site, &SW_Site, sizeof(SW_SITE));
+    memcpy(&sky, &SW_Sky, sizeof(SW_SKY));
+    memcpy(&carbon, &SW_Carbon, sizeof(SW_CARBON));
+    memcpy(veg, SW_VegProd.veg, sizeof(veg));
+    memcpy(scale_precip, SW_Weather.scale_precip, sizeof(scale_precip));
+    n_spp = SW_VegEstab.count;
+
+    // Load inputs from snapshot
+    ASSERT_TRUE(load_snapshot(&run_loaded, swTRUE));
+
+    EXPECT_EQ(0, memcmp(&model, &SW_Model, sizeof(SW_MODEL)));
+    EXPECT_EQ(0, memcmp(&site, &SW_Site, sizeof(SW_SITE)));
+    EXPECT_EQ(0, memcmp(&sky, &SW_Sky, sizeof(SW_SKY)));
+    EXPECT_EQ(0, memcmp(&carbon, &SW_Carbon, sizeof(SW_CARBON)));
+    EXPECT_EQ(0, memcmp(veg, SW_VegProd.veg, sizeof(veg)));
+    EXPECT_EQ(0,
+      memcmp(scale_precip, SW_Weather.scale_precip, sizeof(scale_precip)));
+    EXPECT_EQ(n_spp, SW_VegEstab.count);
+
+    // Loaded run simulates
+    SW_CTL_init_run(&run_loaded);
+    SW_CTL_main(&run_loaded);
+
+    SW_CTL_clear_model(&run_loaded, swFALSE);
+    SW_CTL_clear_model(&run_parsed, swFALSE);
+    SW_CTL_release_run();
+
+    InputSnapshot[0] = '\0';
+    remove(snapfile);
+  }
+
+
+  // Snapshots that are missing, corrupted, or older than an input file
+  // are not loaded
+  TEST(SWSnapshotTest, RejectStale) {
+    static SW_RUN run; // zero-initialized
+    const char *infile = "Input/siteparam.in";
+    struct stat st;
+    struct timespec times[2];
+    FILE *f;
+    char c;
+
+    remove(snapfile);
+    EXPECT_FALSE(load_snapshot(&run, swFALSE));
+
+    // Write snapshot
+    SW_CTL_setup_model(&run, _firstfile);
+    SW_CTL_read_inputs_from_disk(&run);
+    SW_SNAP_write(snapfile);
+    SW_CTL_clear_model(&run, swFALSE);
+    EXPECT_TRUE(load_snapshot(&run, swFALSE));
+
+    // Changed modification time of an input file
+    ASSERT_EQ(0, stat(infile, &st));
+    times[0] = st.st_atim;
+    times[1] = st.st_mtim;
+    times[1].tv_sec += 10;
+    ASSERT_EQ(0, utimensat(AT_FDCWD, infile, times, 0));
+    EXPECT_FALSE(load_snapshot(&run, swFALSE));
+
+    // ... within the same second
+    times[1] = st.st_mtim;
+    times[1].tv_nsec = (st.st_mtim.tv_nsec + 1) % 1000000000L;
+    ASSERT_EQ(0, utimensat(AT_FDCWD, infile, times, 0));
+    EXPECT_FALSE(load_snapshot(&run, swFALSE));
+
+    times[1] = st.st_mtim;
+    ASSERT_EQ(0, utimensat(AT_FDCWD, infile, times, 0));
+    EXPECT_TRUE(load_snapshot(&run, swFALSE));
+
+    // Corrupted contents
+    f = fopen(snapfile, "r+b");
+    ASSERT_TRUE(f != NULL);
+    fseek(f, -1, SEEK_END);
+    c = (char) fgetc(f);
+    fseek(f, -1, SEEK_END);
+    fputc(c ^ 0x1, f);
+    fclose(f);
+    EXPECT_FALSE(load_snapshot(&run, swFALSE));
+
+    SW_CTL_release_run();
+    remove(snapfile);
+
+    // Reset to previous global states
+    Reset_SOILWAT2_after_UnitTest();
+  }
+
+} // namespace
@@ -17,9 +17,9 @@
 #include "../SW_Flow_lib.h"
 #include "sw_testhelpers.h"
 
-extern SW_MODEL SW_Model;
-extern SW_SITE SW_Site;
-extern SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_VEGPROD SW_VegProd;
 
 namespace{
   // Test the 'SW_SoilWater' function 'SW_VWCBulkRes'
@@ -116,7 +116,7 @@ namespace{
 
   // Test the 'SW_SoilWater' function 'SW_SWCbulk2SWPmatric'
   TEST(SWSoilWaterTest, SWSWCbulk2SWPmatric){
-    // Note: function `SW_SWCbulk2SWPmatric` accesses `SW_Site.lyr[n]`
+    // Note: function `SW_SWCbulk2SWPmatric` accesses the soil layer `n` of `SW_Site`
 
     RealD tol = 1e-2; // pedotransfer functions are not very exact
     RealD fractionGravel = 0.2;
@@ -134,32 +134,32 @@ namespace{
     EXPECT_EQ(res, 0.0);
 
     // if swc > field capacity, then we expect res < 0.33 bar
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel,
-      SW_Site.lyr[n]->swcBulk_fieldcap + 0.1, n);
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n],
+      SW_Site.swcBulk_fieldcap[n] + 0.1, n);
     EXPECT_LT(res, 0.33 + tol);
 
     // if swc = field capacity, then we expect res == 0.33 bar
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel,
-      SW_Site.lyr[n]->swcBulk_fieldcap, n);
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n],
+      SW_Site.swcBulk_fieldcap[n], n);
     EXPECT_NEAR(res, 0.33, tol);
 
     // if field capacity > swc > wilting point, then
     // we expect 15 bar > res > 0.33 bar
-    swcBulk = (SW_Site.lyr[n]->swcBulk_fieldcap +
-      SW_Site.lyr[n]->swcBulk_wiltpt) / 2;
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel,
+    swcBulk = (SW_Site.swcBulk_fieldcap[n] +
+      SW_Site.swcBulk_wiltpt[n]) / 2;
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n],
       swcBulk, n);
     EXPECT_GT(res, 0.33 - tol);
     EXPECT_LT(res, 15 + tol);
 
     // if swc = wilting point, then we expect res == 15 bar
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel,
-      SW_Site.lyr[n]->swcBulk_wiltpt, n);
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n],
+      SW_Site.swcBulk_wiltpt[n], n);
     EXPECT_NEAR(res, 15., tol);
 
     // if swc < wilting point, then we expect res > 15 bar
-    swcBulk = (SW_Site.lyr[n]->swcBulk_wiltpt) / 2;
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel,
+    swcBulk = (SW_Site.swcBulk_wiltpt[n]) / 2;
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n],
       swcBulk, n);
     EXPECT_GT(res, 15. - tol);
 
@@ -173,26 +173,26 @@ namespace{
     // `SWSWCbulk2SWPmatricDeathTest`: we cannot test it here because the
     // Address Sanitizer would complain with `UndefinedBehaviorSanitizer`
     // see [issue #231](https://github.com/DrylandEcology/SOILWAT2/issues/231)
-    // res = SW_SWCbulk2SWPmatric(1., SW_Site.lyr[n]->swcBulk_fieldcap, n);
+    // res = SW_SWCbulk2SWPmatric(1., SW_Site.swcBulk_fieldcap[n], n);
     // EXPECT_DOUBLE_EQ(res, 0.); // SWP "ought to be" infinity [bar]
 
     // if theta(sat, matric; Cosby et al. 1984) == 0: would be division by zero
     // this situation does normally not occur because it is
     // checked during input by function `water_eqn`
-    help = SW_Site.lyr[n]->thetasMatric;
-    SW_Site.lyr[n]->thetasMatric = 0.;
-    res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel, 0., n);
+    help = SW_Site.thetasMatric[n];
+    SW_Site.thetasMatric[n] = 0.;
+    res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], 0., n);
     EXPECT_DOUBLE_EQ(res, 0.); // SWP "ought to be" infinity [bar]
-    SW_Site.lyr[n]->thetasMatric = help;
+    SW_Site.thetasMatric[n] = help;
 
-    // if lyr->width == 0: would be division by zero
+    // if width[n] == 0: would be division by zero
     // this situation does normally not occur because it is
     // checked during input by function `_read_layers`
-    help = SW_Site.lyr[n]->bMatric;
-    SW_Site.lyr[n]->width = 0.;
-     res = SW_SWCbulk2SWPmatric(SW_Site.lyr[n]->fractionVolBulk_gravel, 0., n);
+    help = SW_Site.bMatric[n];
+    SW_Site.width[n] = 0.;
+     res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], 0., n);
     EXPECT_DOUBLE_EQ(res, 0.); // swc < width
-    SW_Site.lyr[n]->width = help;
+    SW_Site.width[n] = help;
 
 
     // No need to reset to previous global states because we didn't change any
@@ -208,25 +208,100 @@ namespace{
 
     // if swc < 0: water content can physically not be negative
     EXPECT_DEATH_IF_SUPPORTED(SW_SWCbulk2SWPmatric(
-      SW_Site.lyr[n]->fractionVolBulk_gravel, -1., n),
+      SW_Site.fractionVolBulk_gravel[n], -1., n),
       "@ generic.c LogError");
 
-    // if theta1 == 0 (i.e., gravel == 1) && lyr->bMatric == 0:
+    // if theta1 == 0 (i.e., gravel == 1) && bMatric[n] == 0:
     // would be division by NaN
     // note: this case is in normally prevented due to checks of inputs by
     // function `water_eqn` for `bMatric` and function `_read_layers` for
     // `gravelFraction`
-    help = SW_Site.lyr[n]->bMatric;
-    SW_Site.lyr[n]->bMatric = 0.;
+    help = SW_Site.bMatric[n];
+    SW_Site.bMatric[n] = 0.;
     EXPECT_DEATH_IF_SUPPORTED(SW_SWCbulk2SWPmatric(
-      1., SW_Site.lyr[n]->swcBulk_fieldcap, n),
+      1., SW_Site.swcBulk_fieldcap[n], n),
       "@ generic.c LogError");
-    SW_Site.lyr[n]->bMatric = help;
+    SW_Site.bMatric[n] = help;
 
     // Reset to previous global states
     Reset_SOILWAT2_after_UnitTest();
   }
 
+  // Test that tabulated SWP is within the requested tolerance of the
+  // exact SWP, see `SW_SWC_init_swptable`
+  TEST(SWSoilWaterTest, SWSWCbulk2SWPmatricTable){
+    RealD tols[] = {1e-3, 1e-5}, swcBulk, dswc, exact[5001], res;
+    LyrIndex n;
+    int k, i, nsteps = 5000;
+
+    for (k = 0; k < 2; k++) {
+      ForEachSoilLayer(n) {
+        dswc = (SW_Site.swcBulk_saturated[n] - SW_Site.swcBulk_min[n]) / nsteps;
+
+        // exact values without lookup table
+        SW_SWC_deconstruct_swptable(n);
+        for (i = 0; i <= nsteps; i++) {
+          swcBulk = SW_Site.swcBulk_min[n] + i * dswc;
+          exact[i] = (swcBulk > 0.) ?
+            SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], swcBulk, n) : 0.;
+        }
+
+        SW_SWC_init_swptable(n, tols[k]);
+        ASSERT_FALSE(isnull(SW_Site.swpTable[n].swp));
+
+        for (i = 0; i <= nsteps; i++) {
+          swcBulk = SW_Site.swcBulk_min[n] + i * dswc;
+          if (swcBulk <= 0.) {
+            continue;
+          }
+
+          res = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], swcBulk, n);
+
+          EXPECT_LE(fabs(res - exact[i]), tols[k] * exact[i]) <<
+            "layer " << n << ", swc = " << swcBulk;
+        }
+
+        // tolerance 0 switches the lookup table off
+        SW_SWC_init_swptable(n, 0.);
+        EXPECT_TRUE(isnull(SW_Site.swpTable[n].swp));
+      }
+    }
+
+    // Reset to previous global states
+    Reset_SOILWAT2_after_UnitTest();
+  }
+
+
+  // Test that cached SWP equals SWP and follows changes of soil water
+  // content and of the retention curve, see `SW_SWC_swp`
+  TEST(SWSoilWaterTest, SWSWCswpCache){
+    LyrIndex n = 0;
+    RealD swc = (SW_Site.swcBulk_fieldcap[n] + SW_Site.swcBulk_wiltpt[n]) / 2.,
+      swp, swp2;
+
+    swp = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], swc, n);
+    EXPECT_DOUBLE_EQ(SW_SWC_swp(swc, n), swp);
+    EXPECT_DOUBLE_EQ(SW_SWC_swp(swc, n), swp);
+
+    // Change of soil water content
+    swp2 = SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], 2. * swc, n);
+    EXPECT_DOUBLE_EQ(SW_SWC_swp(2. * swc, n), swp2);
+    EXPECT_DOUBLE_EQ(SW_SWC_swp(0., n), 0.);
+
+    // Change of retention curve (without lookup table)
+    SW_SWC_deconstruct_swptable(n);
+    SW_SWC_swp(swc, n);
+    SW_Site.psisMatric[n] *= 2.;
+    SW_SWC_clear_swp(n);
+    EXPECT_DOUBLE_EQ(SW_SWC_swp(swc, n),
+      SW_SWCbulk2SWPmatric(SW_Site.fractionVolBulk_gravel[n], swc, n));
+    EXPECT_GT(fabs(SW_SWC_swp(swc, n) - swp), 0.);
+
+    // Reset to previous global states
+    Reset_SOILWAT2_after_UnitTest();
+  }
+
+
   // Test the 'SW_SoilWater' function 'SW_SWPmatric2VWCBulk'
   TEST(SWSoilWaterTest, SWSWPmatric2VWCBulk){
     // set up mock variables
@@ -235,9 +310,9 @@ namespace{
     RealD tExpect, t, actualExpectDiff;
     int i;
     LyrIndex n = 0;
-    SW_Site.lyr[n]->thetasMatric = thetaMatric;
-    SW_Site.lyr[n]->psisMatric = psisMatric;
-    SW_Site.lyr[n]->bMatric = binverseMatric;
+    SW_Site.thetasMatric[n] = thetaMatric;
+    SW_Site.psisMatric[n] = psisMatric;
+    SW_Site.bMatric[n] = binverseMatric;
 
     // set gravel fractions on the interval [.0, .8], step .05
     for (i = 0; i <= 16; i++){
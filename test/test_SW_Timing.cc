@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../generic.h"
+#include "../SW_Timing.h"
+
+#include "sw_testhelpers.h"
+
+
+namespace {
+  // Test that timers accumulate, merge, and reset
+  TEST(TimingTest, AccumulateMergeReset) {
+    int p, i;
+    double s;
+
+    SW_TIM_reset();
+
+    for (p = 0; p < SW_TIM_NPHASES; p++) {
+      EXPECT_EQ(0u, SW_TIM_calls((SW_TIM_PHASE) p));
+      EXPECT_EQ(0., SW_TIM_seconds((SW_TIM_PHASE) p));
+      EXPECT_GT(strlen(SW_TIM_name((SW_TIM_PHASE) p)), 0u);
+    }
+
+    for (i = 0; i < 3; i++) {
+      SW_TIM_start(eSW_TimSoilTemp);
+      SW_TIM_stop(eSW_TimSoilTemp);
+    }
+
+    EXPECT_EQ(3u, SW_TIM_calls(eSW_TimSoilTemp));
+    EXPECT_EQ(0u, SW_TIM_calls(eSW_TimNewDay));
+    s = SW_TIM_seconds(eSW_TimSoilTemp);
+    EXPECT_GE(s, 0.);
+
+    // Merged totals are still reported
+    SW_TIM_merge();
+    EXPECT_EQ(3u, SW_TIM_calls(eSW_TimSoilTemp));
+    EXPECT_EQ(s, SW_TIM_seconds(eSW_TimSoilTemp));
+
+    SW_TIM_start(eSW_TimSoilTemp);
+    SW_TIM_stop(eSW_TimSoilTemp);
+    EXPECT_EQ(4u, SW_TIM_calls(eSW_TimSoilTemp));
+    EXPECT_GE(SW_TIM_seconds(eSW_TimSoilTemp), s);
+
+    SW_TIM_reset();
+    EXPECT_EQ(0u, SW_TIM_calls(eSW_TimSoilTemp));
+    EXPECT_EQ(0., SW_TIM_seconds(eSW_TimSoilTemp));
+  }
+
+} // namespace
@@ -36,8 +36,8 @@
 #include "sw_testhelpers.h"
 
 
-extern SW_MODEL SW_Model;
-extern SW_VEGPROD SW_VegProd;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_VEGPROD SW_VegProd;
 
 
 static void assert_decreasing_SWPcrit(void);
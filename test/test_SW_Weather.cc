@@ -0,0 +1,186 @@
+#include "gtest/gtest.h"
+#include <assert.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <memory.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../generic.h"
+#include "../myMemory.h"
+#include "../filefuncs.h"
+#include "../Times.h"
+#include "../SW_Defines.h"
+#include "../SW_Times.h"
+#include "../SW_Model.h"
+#include "../SW_Weather.h"
+#include "../SW_Weather_store.h"
+
+#include "sw_testhelpers.h"
+
+
+extern SW_TLS SW_WEATHER SW_Weather;
+extern SW_TLS SW_MODEL SW_Model;
+extern Bool PreloadWeather;
+
+
+namespace {
+  const char *fname_store = "test_weather_store.sw2w";
+
+  // Test parsing of the weather path of 'files.in'
+  TEST(WeatherStoreTest, Name) {
+    char fname[MAX_FILENAMESIZE], site[SW_WTH_STORE_NAMELEN];
+
+    EXPECT_FALSE(SW_WTH_store_name("Input/data_weather/weath", fname, site));
+    EXPECT_FALSE(SW_WTH_store_name("Input/weath.sw2wx", fname, site));
+
+    EXPECT_TRUE(SW_WTH_store_name("Input/weath.sw2w", fname, site));
+    EXPECT_STREQ("Input/weath.sw2w", fname);
+    EXPECT_STREQ("", site);
+
+    EXPECT_TRUE(SW_WTH_store_name("Input/weath.sw2w:site2", fname, site));
+    EXPECT_STREQ("Input/weath.sw2w", fname);
+    EXPECT_STREQ("site2", site);
+  }
+
+
+  // Test that a weather store holds the values of the text weather files
+  TEST(WeatherStoreTest, WriteOpenRead) {
+    char
+      name1[] = "site1", name2[] = "site2",
+      prefix[] = "Input/data_weather/weath",
+      *names[] = {name1, name2},
+      *prefixes[] = {prefix, prefix};
+    SW_WEATHER_STORE *store;
+    SW_WEATHER_HIST wh;
+    const SW_WEATHER_HIST *p;
+    TimeInt year, d;
+
+    // Store covers one year before and after the available weather files
+    SW_WTH_store_write(fname_store, 2, names, prefixes, 1979, 2011);
+    store = SW_WTH_store_open(fname_store);
+
+    EXPECT_EQ(2u, store->header->n_sites);
+    EXPECT_EQ(1979, store->header->first_year);
+    EXPECT_EQ(33, store->header->n_years);
+
+    EXPECT_EQ(0, SW_WTH_store_site(store, ""));
+    EXPECT_EQ(1, SW_WTH_store_site(store, "site2"));
+    EXPECT_EQ(1, SW_WTH_store_site(store, "1"));
+    EXPECT_EQ(-1, SW_WTH_store_site(store, "2"));
+    EXPECT_EQ(-1, SW_WTH_store_site(store, "site3"));
+
+    // Missing years and unknown sites
+    EXPECT_TRUE(isnull(SW_WTH_store_year(store, 0, 1979)));
+    EXPECT_TRUE(isnull(SW_WTH_store_year(store, 1, 2011)));
+    EXPECT_TRUE(isnull(SW_WTH_store_year(store, 0, 1900)));
+    EXPECT_TRUE(isnull(SW_WTH_store_year(store, 2, 1980)));
+
+    // Available years are identical to the text files
+    for (year = 1980; year <= 2010; year++) {
+      ASSERT_TRUE(SW_WTH_read_hist_file(prefix, year, &wh));
+
+      p = SW_WTH_store_year(store, 1, year);
+      ASSERT_FALSE(isnull(p));
+
+      for (d = 0; d < MAX_DAYS; d++) {
+        EXPECT_EQ(wh.temp_max[d], p->temp_max[d]);
+        EXPECT_EQ(wh.temp_min[d], p->temp_min[d]);
+        EXPECT_EQ(wh.ppt[d], p->ppt[d]);
+      }
+    }
+
+    SW_WTH_store_close(&store);
+    EXPECT_TRUE(isnull(store));
+
+    remove(fname_store);
+  }
+
+
+  // Test that preloaded weather is identical to the text files and shared
+  TEST(WeatherStoreTest, Preload) {
+    char prefix[] = "Input/data_weather/weath";
+    SW_WEATHER_STORE *block1, *block2;
+    SW_WEATHER_HIST wh;
+    const SW_WEATHER_HIST *p;
+    TimeInt year, d;
+
+    block1 = SW_WTH_store_preload(prefix, 1979, 2010);
+    block2 = SW_WTH_store_preload(prefix, 1979, 2010);
+
+    EXPECT_EQ(block1, block2);
+    EXPECT_EQ(2, block1->n_refs);
+    EXPECT_TRUE(isnull(SW_WTH_store_year(block1, 0, 1979)));
+
+    for (year = 1980; year <= 2010; year++) {
+      ASSERT_TRUE(SW_WTH_read_hist_file(prefix, year, &wh));
+
+      p = SW_WTH_store_year(block1, 0, year);
+      ASSERT_FALSE(isnull(p));
+
+      for (d = 0; d < MAX_DAYS; d++) {
+        EXPECT_EQ(wh.temp_max[d], p->temp_max[d]);
+        EXPECT_EQ(wh.temp_min[d], p->temp_min[d]);
+        EXPECT_EQ(wh.ppt[d], p->ppt[d]);
+      }
+    }
+
+    SW_WTH_store_close(&block2);
+    EXPECT_EQ(1, block1->n_refs);
+    SW_WTH_store_close(&block1);
+    SW_WTH_store_free_unused();
+  }
+
+
+  // Test that a run uses preloaded weather if `PreloadWeather` is set
+  TEST(WeatherStoreTest, PreloadRun) {
+    SW_WEATHER_HIST wh;
+    TimeInt d;
+
+    PreloadWeather = swTRUE;
+    Reset_SOILWAT2_after_UnitTest();
+
+    ASSERT_FALSE(isnull(SW_Weather.store));
+    EXPECT_TRUE(SW_Weather.store->is_preloaded);
+
+    SW_Model.year = SW_Model.startyr;
+    SW_WTH_new_year();
+    ASSERT_FALSE(isnull(SW_Weather.p_hist));
+
+    SW_WTH_read_hist_file(SW_Weather.name_prefix, SW_Model.year, &wh);
+    for (d = 0; d < MAX_DAYS; d++) {
+      EXPECT_EQ(wh.temp_max[d], SW_Weather.p_hist->temp_max[d]);
+      EXPECT_EQ(wh.ppt[d], SW_Weather.p_hist->ppt[d]);
+    }
+
+    // Reset to previous global state
+    PreloadWeather = swFALSE;
+    Reset_SOILWAT2_after_UnitTest();
+    EXPECT_TRUE(isnull(SW_Weather.store));
+    SW_WTH_store_free_unused();
+  }
+
+
+  // Test that files which are not weather stores are rejected
+  TEST(WeatherStoreDeathTest, Open) {
+    EXPECT_DEATH_IF_SUPPORTED(
+      SW_WTH_store_open("Input/data_weather/weath.1980"),
+      "@ generic.c LogError"
+    );
+
+    EXPECT_DEATH_IF_SUPPORTED(
+      SW_WTH_store_open("Input/data_weather/nonexisting.sw2w"),
+      "@ generic.c LogError"
+    );
+  }
+
+} // namespace
@@ -37,10 +37,10 @@
 #include "sw_testhelpers.h"
 
 
-extern SW_MODEL SW_Model;
-extern SW_SOILWAT SW_Soilwat;
-extern SW_SITE SW_Site;
-extern SW_WEATHER SW_Weather;
+extern SW_TLS SW_MODEL SW_Model;
+extern SW_TLS SW_SOILWAT SW_Soilwat;
+extern SW_TLS SW_SITE SW_Site;
+extern SW_TLS SW_WEATHER SW_Weather;
 
 
 namespace {
@@ -54,7 +54,7 @@ namespace {
     int i;
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
@@ -74,7 +74,7 @@ namespace {
     SW_Site.use_soil_temp = swTRUE;
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
@@ -91,12 +91,12 @@ namespace {
     int i;
 
     // Turn on impermeability of first soil layer, runon, and runoff
-    SW_Site.lyr[0]->impermeability = 0.95;
+    SW_Site.impermeability[0] = 0.95;
     SW_Site.percentRunoff = 0.5;
     SW_Site.percentRunon = 1.25;
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
@@ -122,7 +122,7 @@ namespace {
     SW_MKV_setup();
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
@@ -147,7 +147,7 @@ namespace {
     strcpy(SW_Weather.name_prefix, "Input/data_weather_missing/weath");
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
@@ -166,14 +166,14 @@ namespace {
     // Set high gravel volume in all soil layers
     ForEachSoilLayer(s)
     {
-      SW_Site.lyr[s]->fractionVolBulk_gravel = 0.99;
+      SW_Site.fractionVolBulk_gravel[s] = 0.99;
     }
 
     // Re-calculate soils
     SW_SIT_init_run();
 
     // Run the simulation
-    SW_CTL_main();
+    SW_CTL_main(NULL);
 
     // Collect and output from daily checks
     for (i = 0; i < N_WBCHECKS; i++) {
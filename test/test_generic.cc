@@ -16,6 +16,7 @@
 #include <unistd.h>
 
 #include "../generic.h"
+#include "../filefuncs.h"
 #include "../SW_Defines.h"
 
 
@@ -59,4 +60,66 @@ namespace {
     }
   }
 
+
+  // Test that `Str_FromDouble` formats values exactly as `sprintf`
+  TEST(StrFromDoubleTest, Sprintf) {
+    const unsigned int n_special = 16;
+    double
+      special[n_special] = {0., -0., 0.5, 2.5, 0.5e-6, 1.5e-6, 2.5e-6, -1e-9,
+        0.1234565, 123456.7890125, 999999.9999995, 1e9, -1e12, 1e300,
+        NAN, INFINITY},
+      v;
+    char s1[512], s2[512], *end;
+    int digits, i;
+
+    for (digits = 0; digits <= 10; digits++) {
+      for (k = 0; k < n_special; k++) {
+        end = Str_FromDouble(s1, special[k], digits);
+        sprintf(s2, "%.*f", digits, special[k]);
+        EXPECT_STREQ(s2, s1);
+        EXPECT_EQ(strlen(s1), (size_t) (end - s1));
+      }
+    }
+
+    // Random values across magnitudes
+    srand(4);
+    for (i = 0; i < 100000; i++) {
+      v = ((double) rand() / RAND_MAX - 0.5) * pow(10., rand() % 16 - 8);
+      digits = rand() % 10;
+
+      Str_FromDouble(s1, v, digits);
+      sprintf(s2, "%.*f", digits, v);
+      ASSERT_STREQ(s2, s1) << "value = " << v << ", digits = " << digits;
+    }
+  }
+
+
+  // A fatal error jumps to `FatalJump` (if set) instead of exiting
+  TEST(LogErrorTest, FatalJump) {
+    jmp_buf fatal;
+    volatile int n_jumps = 0;
+    FILE *f = tmpfile();
+
+    ASSERT_TRUE(f != NULL);
+
+    if (0 != setjmp(fatal)) {
+      n_jumps++;
+    } else {
+      FatalJump = &fatal;
+      LogError(f, LOGFATAL, "Bad value %d in layer %d.\n", 7, 3);
+    }
+    FatalJump = NULL;
+
+    EXPECT_EQ(1, n_jumps);
+    EXPECT_STREQ("Bad value 7 in layer 3.", FatalMsg);
+
+    // Warnings do not jump
+    FatalJump = &fatal;
+    LogError(f, LOGWARN, "Value %d is large.", 8);
+    FatalJump = NULL;
+    EXPECT_STREQ("Bad value 7 in layer 3.", FatalMsg);
+
+    fclose(f);
+  }
+
 } // namespace
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "../generic.h"
+#include "../myMemory.h"
+
+
+namespace {
+
+  // Allocations of an arena are aligned, zeroed by `Mem_Calloc()`, and
+  // reuse the same memory after a reset
+  TEST(MemArenaTest, AllocReset) {
+    MemArena arena, *prev;
+    char *p1, *p2, *p3;
+    double *x;
+    int i;
+
+    Mem_ArenaInit(&arena, 1024);
+    prev = Mem_ArenaUse(&arena);
+    EXPECT_TRUE(prev == NULL);
+
+    p1 = (char *) Mem_Malloc(3, "MemArenaTest");
+    x = (double *) Mem_Calloc(10, sizeof(double), "MemArenaTest");
+    EXPECT_EQ(0u, (uintptr_t) p1 % 16);
+    EXPECT_EQ(0u, (uintptr_t) x % 16);
+    for (i = 0; i < 10; i++) {
+      EXPECT_DOUBLE_EQ(0., x[i]);
+    }
+
+    // Request larger than a chunk gets its own chunk
+    p2 = (char *) Mem_Malloc(5000, "MemArenaTest");
+    memset(p2, 1, 5000);
+
+    // `Mem_Free()` does not release blocks to the system heap
+    Mem_Free(x);
+
+    Mem_ArenaReset(&arena);
+    p3 = (char *) Mem_Malloc(3, "MemArenaTest");
+    EXPECT_EQ(p1, p3);
+
+    EXPECT_TRUE(Mem_ArenaUse(prev) == &arena);
+    Mem_ArenaRelease(&arena);
+  }
+
+
+  // `Mem_ReAlloc()` keeps the contents of arena blocks
+  TEST(MemArenaTest, ReAlloc) {
+    MemArena arena, *prev;
+    char *p, *q, *r;
+
+    Mem_ArenaInit(&arena, 256);
+    prev = Mem_ArenaUse(&arena);
+
+    // Most recent block grows in place
+    p = Str_Dup("soilwat");
+    q = (char *) Mem_ReAlloc(p, 64);
+    EXPECT_EQ(p, q);
+    EXPECT_STREQ("soilwat", q);
+
+    // Other blocks move (here, to a new chunk)
+    r = (char *) Mem_Malloc(16, "MemArenaTest");
+    strcpy(r, "x");
+    q = (char *) Mem_ReAlloc(q, 512);
+    EXPECT_NE(p, q);
+    EXPECT_STREQ("soilwat", q);
+    EXPECT_STREQ("x", r);
+
+    // Blocks from the system heap are not affected by the arena
+    Mem_ArenaUse(NULL);
+    p = Str_Dup("heap");
+    Mem_ArenaUse(&arena);
+    p = (char *) Mem_ReAlloc(p, 128);
+    EXPECT_STREQ("heap", p);
+    Mem_ArenaUse(NULL);
+    Mem_Free(p);
+
+    Mem_ArenaUse(prev);
+    Mem_ArenaRelease(&arena);
+  }
+
+
+  // `Mem_Free()` finds the arena of a block even if another arena (or the
+  // system heap) is in use
+  TEST(MemArenaTest, FreeOtherArena) {
+    MemArena arena1, arena2, *prev;
+    char *p1, *p2, *q;
+
+    Mem_ArenaInit(&arena1, 256);
+    Mem_ArenaInit(&arena2, 256);
+
+    prev = Mem_ArenaUse(&arena1);
+    p1 = (char *) Mem_Malloc(16, "MemArenaTest");
+    Mem_ArenaUse(&arena2);
+    p2 = (char *) Mem_Malloc(16, "MemArenaTest");
+
+    // Most recent block of `arena1` is released right away
+    Mem_Free(p1);
+    Mem_ArenaUse(NULL);
+    Mem_Free(p2);
+
+    Mem_ArenaUse(&arena1);
+    q = (char *) Mem_Malloc(16, "MemArenaTest");
+    EXPECT_EQ(p1, q);
+
+    Mem_ArenaUse(&arena2);
+    q = (char *) Mem_Malloc(16, "MemArenaTest");
+    EXPECT_EQ(p2, q);
+
+    // Blocks of a released arena are no longer recognized
+    Mem_ArenaUse(prev);
+    Mem_ArenaRelease(&arena1);
+    Mem_ArenaRelease(&arena2);
+
+    q = Str_Dup("heap");
+    Mem_Free(q);
+  }
+
+} // namespace
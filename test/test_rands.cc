@@ -24,7 +24,7 @@
 namespace {
   // This tests the uniform random number generator
   TEST(RNG_unif, ZeroToOneOutput) {
-    pcg32_random_t rng0, rng1, rng2;
+    sw_random_t rng0, rng1, rng2;
     int i, n = 10;
     double min = 0., max = 1.;
     double x0, x1, x2;
@@ -56,7 +56,7 @@ namespace {
   }
 
   TEST(RNG_unif, FloatRangeOutput) {
-    pcg32_random_t rng0, rng1, rng2;
+    sw_random_t rng0, rng1, rng2;
     int i, n = 10;
     float min = 7.5, max = 77.7;
     float x0, x1, x2;
@@ -100,7 +100,7 @@ namespace {
 
 
   TEST(RNG_unif, IntRangeOutput) {
-    pcg32_random_t rng0, rng1, rng2;
+    sw_random_t rng0, rng1, rng2;
     int i, n = 10;
     int min = 7, max = 123;
     int x0, x1, x2;
@@ -153,7 +153,7 @@ namespace {
 
   // This tests the normal random number generator
   TEST(RNG_norm, MeanSD) {
-    pcg32_random_t rng0, rng1, rng2;
+    sw_random_t rng0, rng1, rng2;
     int i, n = 10, f = 9999;
     double mean = 0., sd = 1.,
       unlikely[2] = {mean - f * sd, mean + f * sd};
@@ -201,9 +201,98 @@ namespace {
 
 
 
+  // This tests generators that are seeded with a stream
+  TEST(RNG_stream, Reproducible) {
+    sw_random_t rng0, rng1, rng2;
+    int i, n = 10;
+    double x0[10], x1[10];
+
+    RandSeedStream(7, 3, &rng0);
+    for (i = 0; i < n; i++) {
+      x0[i] = RandNorm(0., 1., &rng0);
+    }
+
+    // Same seed and stream: same sequence, even after other generators
+    // were seeded and a normal variate is left over
+    RandSeed(7, &rng1);
+    RandNorm(0., 1., &rng1);
+    RandSeedStream(7, 3, &rng1);
+    for (i = 0; i < n; i++) {
+      x1[i] = RandNorm(0., 1., &rng1);
+      EXPECT_DOUBLE_EQ(x0[i], x1[i]);
+    }
+
+    // Same seed, but different stream: different sequence
+    RandSeedStream(7, 4, &rng2);
+    for (i = 0; i < n; i++) {
+      x1[i] = RandNorm(0., 1., &rng2);
+      EXPECT_GT(fabs(x0[i] - x1[i]), 0.);
+    }
+  }
+
+
+
+  // This tests that the normal variates of a generator do not depend on
+  // other generators that are used in between
+  TEST(RNG_norm, IndependentGenerators) {
+    sw_random_t rng0, rng1;
+    int i, n = 11;
+    double x0[11];
+
+    RandSeedStream(7, 3, &rng0);
+    for (i = 0; i < n; i++) {
+      x0[i] = RandNorm(0., 1., &rng0);
+    }
+
+    // Interleave draws with a second generator (with an odd number of draws
+    // so that one generator holds a cached variate while the other draws)
+    RandSeedStream(7, 3, &rng0);
+    RandSeedStream(7, 4, &rng1);
+    for (i = 0; i < n; i++) {
+      EXPECT_DOUBLE_EQ(x0[i], RandNorm(0., 1., &rng0));
+      RandNorm(0., 1., &rng1);
+      if (i % 3 == 0) {
+        RandNorm(0., 1., &rng1);
+      }
+    }
+  }
+
+
+  // This tests the moments of normal variates (of the Box-Muller or,
+  // if compiled with SW_ZIGGURAT, of the ziggurat method)
+  TEST(RNG_norm, Moments) {
+    sw_random_t rng;
+    int i, n = 100000, n_tail = 0;
+    double x, sum = 0., sum2 = 0., mean, sd;
+
+    RandSeedStream(11, 1, &rng);
+    for (i = 0; i < n; i++) {
+      x = RandNorm(2., 3., &rng);
+      sum += x;
+      sum2 += x * x;
+      if (fabs(x - 2.) > 3. * 3.) {
+        n_tail++;
+      }
+    }
+
+    mean = sum / n;
+    sd = sqrt(sum2 / n - mean * mean);
+
+    // standard errors of mean and sd are about 0.01 and 0.007
+    EXPECT_NEAR(mean, 2., 0.05);
+    EXPECT_NEAR(sd, 3., 0.05);
+
+    // expected 270 draws beyond 3 sd
+    EXPECT_GT(n_tail, 200);
+    EXPECT_LT(n_tail, 340);
+  }
+
+
+
+
   // This tests the beta random number generator
   TEST(RNG_beta, ZeroToOneOutput) {
-    pcg32_random_t ZeroToOne_rng;
+    sw_random_t ZeroToOne_rng;
     RandSeed(0, &ZeroToOne_rng);
     EXPECT_LT(RandBeta(0.5, 2, &ZeroToOne_rng), 1);
     EXPECT_LT(RandBeta(1, 3, &ZeroToOne_rng), 1);
@@ -212,7 +301,7 @@ namespace {
   }
 
   TEST(RNG_beta_death, Errors) {
-    pcg32_random_t error_rng;
+    sw_random_t error_rng;
     RandSeed(0, &error_rng);
     EXPECT_DEATH(RandBeta(-0.5, 2, &error_rng), "AA <= 0.0");
     EXPECT_DEATH(RandBeta(1, -3, &error_rng), "BB <= 0.0");